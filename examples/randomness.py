@@ -43,6 +43,10 @@ _SIGNIFICANCE_LEVEL_FAIL = flags.DEFINE_float(
     "tests with significance level below this value fail")
 _MIN_REPETITIONS = flags.DEFINE_integer("min_repetitions", 1,
                                         "minimal number of repetitions")
+_NUM_THREADS = flags.DEFINE_integer(
+    "num_threads", 1,
+    "number of tests run concurrently; the native kernels release the GIL, "
+    "so values > 1 use multiple cores")
 _TEST = flags.DEFINE_string("test", None,
                             "restricts tests to ones starting with this value")
 
@@ -62,7 +66,8 @@ def test_source(prng_name: str) -> None:
   result_level = _RESULT_LEVEL.value
   random_test_suite.TestSource(prng.RandomBits, size, significance_level_repeat,
                                significance_level_fail, prng_name, test,
-                               result_level, min_repetitions)
+                               result_level, min_repetitions,
+                               num_threads=_NUM_THREADS.value)
 
 
 def test_sources() -> None:
@@ -0,0 +1,185 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/batch_gcd.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paranoid_crypto/lib/cc_util/parallel.h"
+
+namespace paranoid_crypto::lib::cc_util {
+
+namespace {
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, /*order=*/-1, /*size=*/1, /*endian=*/0,
+             /*nails=*/0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+std::string SpillPath(const std::string& temp_dir, int level) {
+  return temp_dir + "/batch_gcd_level_" + std::to_string(level);
+}
+
+// Writes a tree level to a spill file in the raw format of mpz_out_raw.
+bool WriteLevel(const std::string& path,
+                const std::vector<mpz_class>& level) {
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool ok = true;
+  for (const mpz_class& value : level) {
+    if (mpz_out_raw(file, value.get_mpz_t()) == 0) {
+      ok = false;
+      break;
+    }
+  }
+  return std::fclose(file) == 0 && ok;
+}
+
+// Reads back a tree level and removes the spill file.
+bool ReadLevel(const std::string& path, std::vector<mpz_class>* level) {
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool ok = true;
+  for (mpz_class& value : *level) {
+    if (mpz_inp_raw(value.get_mpz_t(), file) == 0) {
+      ok = false;
+      break;
+    }
+  }
+  std::fclose(file);
+  std::remove(path.c_str());
+  return ok;
+}
+
+}  // namespace
+
+std::vector<std::string> BatchGcd(const std::vector<std::string>& values,
+                                  const std::string& other_prod,
+                                  int num_threads,
+                                  const std::string& temp_dir) {
+  const int n = values.size();
+  if (n == 0) {
+    return {};
+  }
+  std::vector<mpz_class> level(n);
+  for (int i = 0; i < n; i++) {
+    level[i] = FromBytes(values[i]);
+    if (level[i] == 0) {
+      // A zero value would make the reductions below divide by zero.
+      return {};
+    }
+  }
+  // t[i] is the sum of prod(level) / level[j] over the leaves j that were
+  // merged into level[i], so at the root t[0] % v == prod // v % v holds
+  // for every leaf v. This is the invariant of
+  // ntheory_util.ExtendedProductTree.
+  std::vector<mpz_class> t(n, mpz_class(1));
+  const bool spill = !temp_dir.empty();
+  // In-memory mode keeps the retired levels; spill mode writes them out
+  // and only remembers their sizes.
+  std::vector<std::vector<mpz_class>> tree;
+  std::vector<int> level_sizes;
+  while (level.size() > 1) {
+    int pairs = level.size() / 2;
+    std::vector<mpz_class> next_level((level.size() + 1) / 2);
+    std::vector<mpz_class> next_t(next_level.size());
+    ParallelFor(pairs, num_threads, [&](int i) {
+      next_t[i] = t[2 * i] * level[2 * i + 1] + t[2 * i + 1] * level[2 * i];
+      next_level[i] = level[2 * i] * level[2 * i + 1];
+    });
+    if (level.size() % 2 == 1) {
+      next_level.back() = level.back();
+      next_t.back() = t.back();
+    }
+    level_sizes.push_back(level.size());
+    if (spill) {
+      if (!WriteLevel(SpillPath(temp_dir, level_sizes.size() - 1), level)) {
+        return {};
+      }
+      level.clear();
+    } else {
+      tree.push_back(std::move(level));
+    }
+    level = std::move(next_level);
+    t = std::move(next_t);
+  }
+  mpz_class top = std::move(t[0]);
+  if (!other_prod.empty()) {
+    top *= FromBytes(other_prod);
+  }
+  // The remainder tree: the root product itself is never needed, the
+  // descent starts with top at the level below it. The two children of a
+  // node read the same parent remainder, which is safe since the reads do
+  // not modify it.
+  std::vector<mpz_class> rem(1, std::move(top));
+  std::vector<std::string> gcds(n);
+  for (int lev = level_sizes.size() - 1; lev >= 0; lev--) {
+    std::vector<mpz_class> vals;
+    if (spill) {
+      vals.resize(level_sizes[lev]);
+      if (!ReadLevel(SpillPath(temp_dir, lev), &vals)) {
+        return {};
+      }
+    } else {
+      vals = std::move(tree[lev]);
+    }
+    std::vector<mpz_class> next_rem(vals.size());
+    ParallelFor(vals.size(), num_threads, [&](int i) {
+      if (i + 1 == static_cast<int>(vals.size()) && i % 2 == 0) {
+        // An unpaired node passes through unchanged, as in the tree above.
+        next_rem[i] = rem[i / 2];
+      } else {
+        next_rem[i] = rem[i / 2] % vals[i];
+      }
+      if (lev == 0) {
+        mpz_class gcd;
+        mpz_gcd(gcd.get_mpz_t(), vals[i].get_mpz_t(),
+                next_rem[i].get_mpz_t());
+        gcds[i] = ToBytes(gcd);
+      }
+    });
+    rem = std::move(next_rem);
+  }
+  if (level_sizes.empty()) {
+    // A single value: its GCD with other_prod (or 1) alone.
+    mpz_class gcd;
+    mpz_gcd(gcd.get_mpz_t(), level[0].get_mpz_t(), rem[0].get_mpz_t());
+    gcds[0] = ToBytes(gcd);
+  }
+  return gcds;
+}
+
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,48 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_BATCH_GCD_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_BATCH_GCD_H_
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// Computes for each value the GCD of the value with the product of all the
+// other values, times other_prod. This is the batch GCD of
+// rsa_util.BatchGCD: it uses the extended product tree of
+// ntheory_util.ExtendedProductTree, which avoids the squared moduli of
+// http://facthacks.cr.yp.to/batchgcd.html, and a remainder tree for the
+// reductions. The multiplications of a product tree level and the
+// reductions of a remainder tree level are independent, so both trees are
+// processed level by level with num_threads worker threads (the number of
+// hardware threads if num_threads <= 0).
+//
+// Values are unsigned little endian byte strings, as produced by
+// int.to_bytes; the returned GCDs use the same encoding. An empty
+// other_prod means no additional product. If temp_dir is non-empty, the
+// levels of the product tree are spilled to files in that directory while
+// the tree is built and read back one level at a time during the remainder
+// pass, so that at most two tree levels are resident at once instead of
+// the whole tree; the directory must not be shared by concurrent calls.
+// Returns an empty vector if values is empty, a value is zero, or a spill
+// file cannot be written or read.
+std::vector<std::string> BatchGcd(const std::vector<std::string>& values,
+                                  const std::string& other_prod,
+                                  int num_threads,
+                                  const std::string& temp_dir);
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_BATCH_GCD_H_
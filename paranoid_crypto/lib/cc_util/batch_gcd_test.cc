@@ -0,0 +1,139 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/batch_gcd.h"
+
+#include <gmpxx.h>
+
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::cc_util {
+namespace {
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, -1, 1, 0, 0, value.get_mpz_t());
+  bytes.resize(count > 0 ? count : 1);
+  return bytes;
+}
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+  return value;
+}
+
+// A deterministic sequence of pseudo random odd numbers of the given bit
+// size. Some of them share a prime factor.
+std::vector<mpz_class> TestValues(int count, int bits, int shared_every) {
+  gmp_randclass rand(gmp_randinit_default);
+  rand.seed(12345);
+  mpz_class shared = rand.get_z_bits(bits / 2) | 1;
+  mpz_nextprime(shared.get_mpz_t(), shared.get_mpz_t());
+  std::vector<mpz_class> values(count);
+  for (int i = 0; i < count; i++) {
+    values[i] = rand.get_z_bits(bits) | 1;
+    if (shared_every > 0 && i % shared_every == 0) {
+      values[i] *= shared;
+    }
+  }
+  return values;
+}
+
+// The quadratic reference: one GCD per pair.
+std::vector<mpz_class> RefBatchGcd(const std::vector<mpz_class>& values,
+                                   const mpz_class& other_prod) {
+  std::vector<mpz_class> gcds(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    mpz_class prod = other_prod;
+    for (size_t j = 0; j < values.size(); j++) {
+      if (j != i) {
+        prod *= values[j];
+      }
+    }
+    mpz_gcd(gcds[i].get_mpz_t(), values[i].get_mpz_t(), prod.get_mpz_t());
+  }
+  return gcds;
+}
+
+void CompareWithRef(const std::vector<mpz_class>& values,
+                    const mpz_class& other_prod, int num_threads,
+                    const std::string& temp_dir) {
+  std::vector<std::string> value_bytes;
+  for (const mpz_class& v : values) {
+    value_bytes.push_back(ToBytes(v));
+  }
+  std::string other_bytes = other_prod == 1 ? "" : ToBytes(other_prod);
+  std::vector<std::string> gcds =
+      BatchGcd(value_bytes, other_bytes, num_threads, temp_dir);
+  std::vector<mpz_class> expected = RefBatchGcd(values, other_prod);
+  ASSERT_EQ(gcds.size(), values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(FromBytes(gcds[i]), expected[i]) << "i:" << i;
+  }
+}
+
+TEST(BatchGcdTest, SmallSets) {
+  for (int count : {1, 2, 3, 4, 5, 7, 8, 9, 16, 31, 100}) {
+    CompareWithRef(TestValues(count, 64, 3), 1, 1, "");
+  }
+}
+
+TEST(BatchGcdTest, LargeModuli) {
+  CompareWithRef(TestValues(40, 2048, 7), 1, 1, "");
+}
+
+TEST(BatchGcdTest, OtherProd) {
+  std::vector<mpz_class> values = TestValues(20, 256, 0);
+  mpz_class other = values[3] * values[11];
+  CompareWithRef(values, other, 1, "");
+}
+
+TEST(BatchGcdTest, Parallel) {
+  CompareWithRef(TestValues(100, 512, 5), 1, 4, "");
+  CompareWithRef(TestValues(100, 512, 5), 1, 0, "");
+}
+
+TEST(BatchGcdTest, Spilled) {
+  for (int count : {1, 2, 3, 17, 100}) {
+    CompareWithRef(TestValues(count, 512, 4), 1, 2, testing::TempDir());
+  }
+}
+
+TEST(BatchGcdTest, Ktv) {
+  // 15 and 21 share the factor 3; 22 is coprime with both.
+  std::vector<std::string> gcds =
+      BatchGcd({ToBytes(15), ToBytes(21), ToBytes(22)}, "", 1, "");
+  ASSERT_EQ(gcds.size(), 3);
+  EXPECT_EQ(FromBytes(gcds[0]), 3);
+  EXPECT_EQ(FromBytes(gcds[1]), 3);
+  EXPECT_EQ(FromBytes(gcds[2]), 1);
+}
+
+TEST(BatchGcdTest, InconsistentParameters) {
+  EXPECT_TRUE(BatchGcd({}, "", 1, "").empty());
+  // A zero value would divide by zero in the remainder tree.
+  EXPECT_TRUE(BatchGcd({ToBytes(15), std::string(1, '\0')}, "", 1, "").empty());
+  EXPECT_TRUE(BatchGcd({ToBytes(15), ""}, "", 1, "").empty());
+  // An unwritable spill directory.
+  EXPECT_TRUE(
+      BatchGcd({ToBytes(15), ToBytes(21)}, "", 1, "/nonexistent").empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::cc_util
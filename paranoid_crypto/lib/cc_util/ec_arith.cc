@@ -0,0 +1,577 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/ec_arith.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "paranoid_crypto/lib/cc_util/parallel.h"
+
+namespace paranoid_crypto::lib::cc_util {
+
+namespace {
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, /*order=*/-1, /*size=*/1, /*endian=*/0,
+             /*nails=*/0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+// The non-negative remainder of value modulo mod. operator% of gmpxx
+// truncates towards zero, so differences need the correction.
+mpz_class Mod(const mpz_class& value, const mpz_class& mod) {
+  mpz_class res;
+  mpz_mod(res.get_mpz_t(), value.get_mpz_t(), mod.get_mpz_t());
+  return res;
+}
+
+// The packed 64-bit fingerprint of an x-coordinate: the low limb of the
+// coordinate mixed with the finalizer of splitmix64, so that the slot
+// index and the fingerprint spread over curves whose coordinates have
+// structured low bits. 0 is reserved for empty slots.
+uint64_t Fingerprint(const mpz_class& x) {
+  uint64_t fp = mpz_get_ui(x.get_mpz_t());
+  fp ^= fp >> 30;
+  fp *= 0xbf58476d1ce4e5b9;
+  fp ^= fp >> 27;
+  fp *= 0x94d049bb133111eb;
+  fp ^= fp >> 31;
+  return fp == 0 ? 1 : fp;
+}
+
+}  // namespace
+
+EcGroup::EcGroup(const std::string& mod, const std::string& a,
+                 const std::string& b, const std::string& gx,
+                 const std::string& gy, const std::string& n)
+    : mod_(FromBytes(mod)),
+      a_(FromBytes(a)),
+      b_(FromBytes(b)),
+      n_(FromBytes(n)) {
+  g_ = Point{Mod(FromBytes(gx), mod_), Mod(FromBytes(gy), mod_), false};
+  // The window layout of ec_util.EcCurve.BatchMultiplyG with a window size
+  // of 8 bits: a scalar is processed in steps shifts, and the window bits
+  // of one step are the scalar bits steps positions apart.
+  const int bit_length = mpz_sizeinbase(n_.get_mpz_t(), 2);
+  constexpr int kWindowSize = 8;
+  steps_ = (bit_length + kWindowSize - 1) / kWindowSize;
+  window_bits_ = (bit_length + steps_ - 1) / steps_;
+  cache_.resize(size_t{1} << window_bits_);
+  cached_.resize(size_t{1} << window_bits_);
+  cache_[0] = Point{0, 0, true};
+  cached_[0] = true;
+}
+
+EcGroup::Point EcGroup::Double(const Point& p) const {
+  if (p.infinity || p.y == 0) {
+    return Point{0, 0, true};
+  }
+  mpz_class inv;
+  mpz_class den = 2 * p.y;
+  mpz_invert(inv.get_mpz_t(), den.get_mpz_t(), mod_.get_mpz_t());
+  mpz_class t = Mod((3 * p.x * p.x + a_) * inv, mod_);
+  mpz_class x2 = Mod(t * t - 2 * p.x, mod_);
+  mpz_class y2 = Mod(t * (p.x - x2) - p.y, mod_);
+  return Point{x2, y2, false};
+}
+
+EcGroup::Point EcGroup::Add(const Point& p, const Point& q) const {
+  if (p.infinity) {
+    return q;
+  }
+  if (q.infinity) {
+    return p;
+  }
+  if (p.x == q.x) {
+    if (p.y == q.y) {
+      return Double(p);
+    }
+    return Point{0, 0, true};
+  }
+  mpz_class inv;
+  mpz_class den = Mod(p.x - q.x, mod_);
+  mpz_invert(inv.get_mpz_t(), den.get_mpz_t(), mod_.get_mpz_t());
+  mpz_class t = Mod((p.y - q.y) * inv, mod_);
+  mpz_class x3 = Mod(t * t - p.x - q.x, mod_);
+  mpz_class y3 = Mod(t * (p.x - x3) - p.y, mod_);
+  return Point{x3, y3, false};
+}
+
+EcGroup::JacobianPoint EcGroup::DoubleJacobian(const JacobianPoint& p) const {
+  if (p.z == 0 || p.y == 0) {
+    return JacobianPoint{1, 1, 0};
+  }
+  mpz_class ysqr = p.y * p.y % mod_;
+  mpz_class s = 4 * p.x * ysqr % mod_;
+  mpz_class zsqr = p.z * p.z % mod_;
+  mpz_class m = Mod(3 * p.x * p.x + a_ * zsqr % mod_ * zsqr, mod_);
+  mpz_class x = Mod(m * m - 2 * s, mod_);
+  mpz_class y = Mod(m * (s - x) - 8 * ysqr * ysqr, mod_);
+  mpz_class z = 2 * p.y * p.z % mod_;
+  return JacobianPoint{x, y, z};
+}
+
+EcGroup::JacobianPoint EcGroup::AddJacobianAffine(const JacobianPoint& p,
+                                                  const Point& q) const {
+  if (q.infinity) {
+    return p;
+  }
+  if (p.z == 0) {
+    return JacobianPoint{q.x, q.y, 1};
+  }
+  mpz_class zsqr = p.z * p.z % mod_;
+  mpz_class u2 = q.x * zsqr % mod_;
+  mpz_class s2 = q.y * zsqr % mod_ * p.z % mod_;
+  if (u2 == p.x) {
+    if (s2 == p.y) {
+      return DoubleJacobian(p);
+    }
+    return JacobianPoint{1, 1, 0};
+  }
+  mpz_class h = Mod(u2 - p.x, mod_);
+  mpz_class r = Mod(s2 - p.y, mod_);
+  mpz_class hsqr = h * h % mod_;
+  mpz_class hcube = hsqr * h % mod_;
+  mpz_class v = p.x * hsqr % mod_;
+  mpz_class x = Mod(r * r - hcube - 2 * v, mod_);
+  mpz_class y = Mod(r * (v - x) - p.y * hcube, mod_);
+  mpz_class z = p.z * h % mod_;
+  return JacobianPoint{x, y, z};
+}
+
+EcGroup::Point EcGroup::JacobianToAffine(const JacobianPoint& p) const {
+  if (p.z == 0) {
+    return Point{0, 0, true};
+  }
+  mpz_class inv;
+  mpz_invert(inv.get_mpz_t(), p.z.get_mpz_t(), mod_.get_mpz_t());
+  mpz_class invsqr = inv * inv % mod_;
+  mpz_class x = p.x * invsqr % mod_;
+  mpz_class y = p.y * invsqr % mod_ * inv % mod_;
+  return Point{x, y, false};
+}
+
+EcGroup::Point EcGroup::Multiply(const Point& p, const mpz_class& k) const {
+  JacobianPoint res{1, 1, 0};
+  if (k == 0 || p.infinity) {
+    return Point{0, 0, true};
+  }
+  for (int i = mpz_sizeinbase(k.get_mpz_t(), 2) - 1; i >= 0; --i) {
+    res = DoubleJacobian(res);
+    if (mpz_tstbit(k.get_mpz_t(), i)) {
+      res = AddJacobianAffine(res, p);
+    }
+  }
+  return JacobianToAffine(res);
+}
+
+bool EcGroup::BatchInvert(std::vector<mpz_class>* values) const {
+  std::vector<mpz_class> prefix(values->size());
+  mpz_class product = 1;
+  for (size_t i = 0; i < values->size(); ++i) {
+    if ((*values)[i] != 0) {
+      prefix[i] = product;
+      product = product * (*values)[i] % mod_;
+    }
+  }
+  mpz_class inverse;
+  if (mpz_invert(inverse.get_mpz_t(), product.get_mpz_t(),
+                 mod_.get_mpz_t()) == 0) {
+    return false;
+  }
+  for (size_t i = values->size(); i-- > 0;) {
+    if ((*values)[i] != 0) {
+      mpz_class value = (*values)[i];
+      (*values)[i] = prefix[i] * inverse % mod_;
+      inverse = inverse * value % mod_;
+    }
+  }
+  // a simple self check, as in ec_util.EcCurve.BatchInverse
+  return inverse == 1;
+}
+
+bool EcGroup::BatchAddListImpl(const std::vector<Point>& p_list,
+                               const std::vector<Point>& q_list,
+                               std::vector<Point>* res) const {
+  const size_t size = p_list.size();
+  std::vector<mpz_class> tmp(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (!p_list[i].infinity && !q_list[i].infinity) {
+      tmp[i] = Mod(p_list[i].x - q_list[i].x, mod_);
+    }
+  }
+  if (!BatchInvert(&tmp)) {
+    return false;
+  }
+  res->resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    const Point& p = p_list[i];
+    const Point& q = q_list[i];
+    if (tmp[i] == 0) {
+      (*res)[i] = Add(p, q);
+    } else {
+      mpz_class t = Mod(tmp[i] * (p.y - q.y), mod_);
+      mpz_class x = Mod(t * t - p.x - q.x, mod_);
+      mpz_class y = Mod(t * (p.x - x) - p.y, mod_);
+      (*res)[i] = Point{x, y, false};
+    }
+  }
+  return true;
+}
+
+bool EcGroup::BatchDoubleImpl(const std::vector<Point>& p_list,
+                              std::vector<Point>* res) const {
+  const size_t size = p_list.size();
+  std::vector<mpz_class> tmp(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (!p_list[i].infinity) {
+      tmp[i] = Mod(2 * p_list[i].y, mod_);
+    }
+  }
+  if (!BatchInvert(&tmp)) {
+    return false;
+  }
+  res->resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    const Point& p = p_list[i];
+    if (tmp[i] == 0) {
+      (*res)[i] = Double(p);
+    } else {
+      mpz_class t = Mod((3 * p.x * p.x + a_) * tmp[i], mod_);
+      mpz_class x2 = Mod(t * t - 2 * p.x, mod_);
+      mpz_class y2 = Mod(t * (p.x - x2) - p.y, mod_);
+      (*res)[i] = Point{x2, y2, false};
+    }
+  }
+  return true;
+}
+
+bool EcGroup::DecodeFlat(const std::vector<std::string>& flat,
+                         std::vector<Point>* points) const {
+  if (flat.size() % 2 != 0) {
+    return false;
+  }
+  points->resize(flat.size() / 2);
+  for (size_t i = 0; i < points->size(); ++i) {
+    if (flat[2 * i].empty()) {
+      (*points)[i] = Point{0, 0, true};
+    } else {
+      (*points)[i] = Point{Mod(FromBytes(flat[2 * i]), mod_),
+                           Mod(FromBytes(flat[2 * i + 1]), mod_), false};
+    }
+  }
+  return true;
+}
+
+std::vector<std::string> EcGroup::EncodeFlat(
+    const std::vector<Point>& points) const {
+  std::vector<std::string> flat(2 * points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (!points[i].infinity) {
+      flat[2 * i] = ToBytes(points[i].x);
+      flat[2 * i + 1] = ToBytes(points[i].y);
+    }
+  }
+  return flat;
+}
+
+std::vector<std::string> EcGroup::BatchInverse(
+    const std::vector<std::string>& values) const {
+  std::vector<mpz_class> tmp(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    tmp[i] = Mod(FromBytes(values[i]), mod_);
+  }
+  if (!BatchInvert(&tmp)) {
+    return {};
+  }
+  std::vector<std::string> res(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (tmp[i] != 0) {
+      res[i] = ToBytes(tmp[i]);
+    }
+  }
+  return res;
+}
+
+std::vector<std::string> EcGroup::BatchAdd(
+    const std::string& px, const std::string& py,
+    const std::vector<std::string>& points) const {
+  std::vector<Point> q_list;
+  if (!DecodeFlat(points, &q_list)) {
+    return {};
+  }
+  if (px.empty()) {
+    return points;
+  }
+  const Point p{Mod(FromBytes(px), mod_), Mod(FromBytes(py), mod_), false};
+  const std::vector<Point> p_list(q_list.size(), p);
+  std::vector<Point> res;
+  if (!BatchAddListImpl(p_list, q_list, &res)) {
+    return {};
+  }
+  return EncodeFlat(res);
+}
+
+std::vector<std::string> EcGroup::BatchAddList(
+    const std::vector<std::string>& p_list,
+    const std::vector<std::string>& q_list) const {
+  std::vector<Point> ps;
+  std::vector<Point> qs;
+  if (!DecodeFlat(p_list, &ps) || !DecodeFlat(q_list, &qs) ||
+      ps.size() != qs.size()) {
+    return {};
+  }
+  std::vector<Point> res;
+  if (!BatchAddListImpl(ps, qs, &res)) {
+    return {};
+  }
+  return EncodeFlat(res);
+}
+
+std::vector<std::string> EcGroup::BatchDouble(
+    const std::vector<std::string>& p_list) const {
+  std::vector<Point> ps;
+  if (!DecodeFlat(p_list, &ps)) {
+    return {};
+  }
+  std::vector<Point> res;
+  if (!BatchDoubleImpl(ps, &res)) {
+    return {};
+  }
+  return EncodeFlat(res);
+}
+
+std::vector<std::string> EcGroup::BatchMultiplyG(
+    const std::vector<std::string>& scalars) {
+  const size_t size = scalars.size();
+  std::vector<mpz_class> reduced(size);
+  for (size_t i = 0; i < size; ++i) {
+    reduced[i] = Mod(FromBytes(scalars[i]), n_);
+  }
+  std::vector<Point> res;
+  std::vector<Point> points(size);
+  for (int i = steps_ - 1; i >= 0; --i) {
+    for (size_t j = 0; j < size; ++j) {
+      uint32_t window = 0;
+      for (int k = 0; k < window_bits_; ++k) {
+        if (mpz_tstbit(reduced[j].get_mpz_t(), i + k * steps_)) {
+          window |= uint32_t{1} << k;
+        }
+      }
+      if (!cached_[window]) {
+        mpz_class multiplier = 0;
+        for (int k = 0; k < window_bits_; ++k) {
+          if ((window >> k) & 1) {
+            mpz_setbit(multiplier.get_mpz_t(), k * steps_);
+          }
+        }
+        cache_[window] = Multiply(g_, multiplier);
+        cached_[window] = true;
+      }
+      points[j] = cache_[window];
+    }
+    if (i == steps_ - 1) {
+      res = points;
+    } else {
+      std::vector<Point> doubled;
+      if (!BatchDoubleImpl(res, &doubled) ||
+          !BatchAddListImpl(doubled, points, &res)) {
+        return {};
+      }
+    }
+  }
+  return EncodeFlat(res);
+}
+
+std::vector<EcGroup::Point> EcGroup::PointSequenceImpl(const Point& base,
+                                                       uint64_t count) const {
+  std::vector<JacobianPoint> seq(count);
+  if (count > 0) {
+    seq[0] = JacobianPoint{1, 1, 0};
+  }
+  for (uint64_t i = 1; i < count; i++) {
+    seq[i] = AddJacobianAffine(seq[i - 1], base);
+  }
+  // Converts the whole sequence with one batch inversion of the
+  // z-coordinates, as in ec_util.EcCurve.BatchJacobianToAffine.
+  std::vector<mpz_class> inverses(count);
+  for (uint64_t i = 0; i < count; i++) {
+    inverses[i] = seq[i].z;
+  }
+  BatchInvert(&inverses);
+  std::vector<Point> res(count);
+  for (uint64_t i = 0; i < count; i++) {
+    if (inverses[i] == 0) {
+      res[i] = Point{0, 0, true};
+    } else {
+      mpz_class invsqr = inverses[i] * inverses[i] % mod_;
+      res[i] = Point{seq[i].x * invsqr % mod_,
+                     seq[i].y * invsqr % mod_ * inverses[i] % mod_, false};
+    }
+  }
+  return res;
+}
+
+void EcGroup::DlogInsert(const mpz_class& x, uint64_t index) {
+  uint64_t fp = Fingerprint(x);
+  uint64_t slot = fp & dlog_slot_mask_;
+  while (dlog_fingerprints_[slot] != 0) {
+    slot = (slot + 1) & dlog_slot_mask_;
+  }
+  dlog_fingerprints_[slot] = fp;
+  dlog_indices_[slot] = index;
+}
+
+void EcGroup::DlogCandidates(const mpz_class& x,
+                             std::vector<uint64_t>* out) const {
+  uint64_t fp = Fingerprint(x);
+  uint64_t slot = fp & dlog_slot_mask_;
+  while (dlog_fingerprints_[slot] != 0) {
+    if (dlog_fingerprints_[slot] == fp) {
+      out->push_back(dlog_indices_[slot]);
+    }
+    slot = (slot + 1) & dlog_slot_mask_;
+  }
+}
+
+void EcGroup::BuildDlogTable(uint64_t table_size) {
+  if (table_size <= dlog_table_size_) {
+    return;
+  }
+  uint64_t slots = 2;
+  while (slots < 2 * table_size) {
+    slots *= 2;
+  }
+  dlog_fingerprints_.assign(slots, 0);
+  dlog_indices_.assign(slots, 0);
+  dlog_slot_mask_ = slots - 1;
+  dlog_table_size_ = table_size;
+  // The baby steps are generated as in ec_util.EcCurve.PointTable: the
+  // x-coordinate of (i * m + j) * g is the sum of the precomputed points
+  // (i * m) * g and j * g, with one batch addition per row. The point at
+  // infinity (the baby step 0) is not stored; the probing methods handle
+  // it separately.
+  uint64_t m = static_cast<uint64_t>(std::sqrt(static_cast<double>(table_size)));
+  m = std::max<uint64_t>(m, 1);
+  uint64_t r = (table_size + m - 1) / m;
+  std::vector<Point> sequence_low = PointSequenceImpl(g_, m);
+  std::vector<Point> sequence_high = PointSequenceImpl(Multiply(g_, m), r);
+  std::vector<Point> row;
+  for (uint64_t i = 0; i < r; i++) {
+    const std::vector<Point> p_list(m, sequence_high[i]);
+    BatchAddListImpl(p_list, sequence_low, &row);
+    for (uint64_t j = 0; j < m; j++) {
+      if (!row[j].infinity) {
+        DlogInsert(row[j].x, i * m + j);
+      }
+    }
+  }
+}
+
+std::vector<int64_t> EcGroup::BatchDl(const std::vector<std::string>& points,
+                                      uint64_t n, int num_threads) {
+  std::vector<Point> p_list;
+  if (!DecodeFlat(points, &p_list)) {
+    return {};
+  }
+  std::vector<int64_t> res(p_list.size(), kDlogNotFound);
+  if (p_list.empty() || dlog_table_size_ == 0) {
+    return res;
+  }
+  // The giant step size can be about twice the table size, since the
+  // x-coordinate of a baby step represents both the point and its
+  // inverse; the number of giant steps is 2 larger than n / t to offset
+  // rounding and logarithms that are a difference between a giant step
+  // and a baby step.
+  const uint64_t t = 2 * dlog_table_size_ - 1;
+  const uint64_t giant_steps = 2 + n / t;
+  const std::vector<Point> list_c =
+      PointSequenceImpl(Multiply(g_, n_ - t), giant_steps);
+  ParallelFor(p_list.size(), num_threads, [&](int idx) {
+    const Point& p = p_list[idx];
+    if (p.infinity) {
+      res[idx] = 0;
+      return;
+    }
+    std::vector<Point> sums;
+    if (!BatchAddListImpl(std::vector<Point>(giant_steps, p), list_c, &sums)) {
+      return;
+    }
+    std::vector<uint64_t> candidates;
+    for (uint64_t j = 0; j < giant_steps; j++) {
+      candidates.clear();
+      if (sums[j].infinity) {
+        candidates.push_back(0);
+      } else {
+        DlogCandidates(sums[j].x, &candidates);
+      }
+      const int64_t jt = static_cast<int64_t>(j * t);
+      for (uint64_t candidate : candidates) {
+        for (int64_t dl : {jt + static_cast<int64_t>(candidate),
+                           jt - static_cast<int64_t>(candidate)}) {
+          // Verifies the candidate; this also eliminates the false
+          // positives of the fingerprints.
+          const Point y = Multiply(g_, Mod(mpz_class(dl), n_));
+          if (!y.infinity && y.x == p.x) {
+            if (y.y == p.y) {
+              res[idx] = dl;
+            } else if (y.y == Mod(-p.y, mod_)) {
+              res[idx] = -dl;
+            }
+          }
+        }
+      }
+    }
+  });
+  return res;
+}
+
+std::vector<int64_t> EcGroup::DlogLookup(
+    const std::vector<std::string>& xs) const {
+  std::vector<int64_t> pairs;
+  if (dlog_table_size_ == 0) {
+    return pairs;
+  }
+  std::vector<uint64_t> candidates;
+  for (size_t pos = 0; pos < xs.size(); pos++) {
+    if (xs[pos].empty()) {
+      continue;
+    }
+    candidates.clear();
+    DlogCandidates(Mod(FromBytes(xs[pos]), mod_), &candidates);
+    for (uint64_t candidate : candidates) {
+      pairs.push_back(static_cast<int64_t>(pos));
+      pairs.push_back(static_cast<int64_t>(candidate));
+    }
+  }
+  return pairs;
+}
+
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,193 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_EC_ARITH_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_EC_ARITH_H_
+#include <gmpxx.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// The result of BatchDl for a point whose discrete logarithm was not
+// found within the bound.
+inline constexpr int64_t kDlogNotFound = std::numeric_limits<int64_t>::min();
+
+// Batch arithmetic on an elliptic curve y^2 = x^3 + a*x + b over a prime
+// field, backing the batch methods of ec_util.EcCurve. The points are kept
+// in affine representation and the modular inversion of a point addition is
+// shared over the whole batch with Montgomery's simultaneous inversion
+// trick, so affine coordinates beat Jacobian coordinates when the points
+// come in large batches (see the reference in ec_util.py).
+//
+// Integers cross the interface as unsigned little endian byte strings, as
+// produced by int.to_bytes; an empty string encodes None. A list of points
+// is passed as a flat list of coordinates [x0, y0, x1, y1, ...] where the
+// point at infinity has two empty coordinates. Coordinates and scalars are
+// reduced modulo the field order rsp. the group order on input.
+//
+// An EcGroup keeps a cache of generator multiples for BatchMultiplyG and
+// must not be shared between concurrent calls.
+class EcGroup {
+ public:
+  // Defines the curve y^2 = x^3 + a*x + b over a prime field.
+  // mod is the order of the field, (gx, gy) the generator and n the order
+  // of the generator; mod and n must be odd primes.
+  EcGroup(const std::string& mod, const std::string& a, const std::string& b,
+          const std::string& gx, const std::string& gy, const std::string& n);
+
+  // Computes the modular inverse of each value. Entries that are empty or
+  // divisible by the field order have an empty result, matching the None
+  // results of ec_util.EcCurve.BatchInverse. Returns an empty vector if
+  // the self check of the simultaneous inversion fails.
+  std::vector<std::string> BatchInverse(
+      const std::vector<std::string>& values) const;
+
+  // Adds the point (px, py) to each point in the flat list points.
+  std::vector<std::string> BatchAdd(
+      const std::string& px, const std::string& py,
+      const std::vector<std::string>& points) const;
+
+  // Adds the points of two flat lists pairwise. Returns an empty vector if
+  // the lists are inconsistent.
+  std::vector<std::string> BatchAddList(
+      const std::vector<std::string>& p_list,
+      const std::vector<std::string>& q_list) const;
+
+  // Doubles each point in a flat list.
+  std::vector<std::string> BatchDouble(
+      const std::vector<std::string>& p_list) const;
+
+  // Multiplies the generator by each scalar, with the windowed batch
+  // multiplication of ec_util.EcCurve.BatchMultiplyG: one batch doubling
+  // and one batch addition per window step. The precomputed window
+  // multiples of the generator are cached across calls.
+  std::vector<std::string> BatchMultiplyG(
+      const std::vector<std::string>& scalars);
+
+  // Builds the baby step table used by BatchDl and DlogLookup: the
+  // x-coordinates of the points i*g for 0 <= i < table_size, stored as
+  // packed 64-bit fingerprints in an open addressing hash table. The
+  // fingerprints replace the dict of Python integers built by
+  // ec_util.EcCurve.PointTable at 16 bytes per baby step; false positives
+  // of the truncation are eliminated by the verification of the probing
+  // methods. A call with a table size not larger than the current one
+  // keeps the existing table.
+  void BuildDlogTable(uint64_t table_size);
+  uint64_t dlog_table_size() const { return dlog_table_size_; }
+
+  // Finds the discrete logarithms of a batch of points with baby step
+  // giant step, as in ec_util.EcCurve.BatchDL: any logarithm x with
+  // self.Multiply(g, x) == p and 0 <= x < n is found, where n must be
+  // smaller than 2^62 so that the logarithms fit into the result type.
+  // The giant step walks of the points are independent and are spread
+  // over num_threads worker threads (the number of hardware threads if
+  // num_threads <= 0). Returns kDlogNotFound for points whose logarithm
+  // was not found and an empty vector if the flat point list is
+  // inconsistent.
+  std::vector<int64_t> BatchDl(const std::vector<std::string>& points,
+                               uint64_t n, int num_threads);
+
+  // Probes the baby step table for a list of x-coordinates; empty entries
+  // are skipped. Returns a flat list of (position, index) pairs with one
+  // pair for each table entry whose fingerprint matches the x-coordinate
+  // at the position. The caller has to verify the candidate indices, as
+  // the fingerprints can produce false positives.
+  std::vector<int64_t> DlogLookup(const std::vector<std::string>& xs) const;
+
+ private:
+  struct Point {
+    mpz_class x;
+    mpz_class y;
+    bool infinity;
+  };
+
+  // A point in Jacobian representation; z == 0 is the point at infinity.
+  struct JacobianPoint {
+    mpz_class x;
+    mpz_class y;
+    mpz_class z;
+  };
+
+  // Scalar operations, used for the rare degenerate cases of the batch
+  // operations (summands at infinity or with colliding x-coordinates) and
+  // for the precomputation of generator multiples.
+  Point Add(const Point& p, const Point& q) const;
+  Point Double(const Point& p) const;
+  JacobianPoint DoubleJacobian(const JacobianPoint& p) const;
+  JacobianPoint AddJacobianAffine(const JacobianPoint& p,
+                                  const Point& q) const;
+  Point JacobianToAffine(const JacobianPoint& p) const;
+  Point Multiply(const Point& p, const mpz_class& k) const;
+
+  // Inverts all non-zero values in place with one modular inversion; zero
+  // values mark skipped entries and stay zero. Returns false if the self
+  // check of the simultaneous inversion fails.
+  bool BatchInvert(std::vector<mpz_class>* values) const;
+
+  bool BatchAddListImpl(const std::vector<Point>& p_list,
+                        const std::vector<Point>& q_list,
+                        std::vector<Point>* res) const;
+  bool BatchDoubleImpl(const std::vector<Point>& p_list,
+                       std::vector<Point>* res) const;
+
+  // Conversions between points and flat lists of encoded coordinates.
+  // DecodeFlat returns false if the list has an odd length.
+  bool DecodeFlat(const std::vector<std::string>& flat,
+                  std::vector<Point>* points) const;
+  std::vector<std::string> EncodeFlat(const std::vector<Point>& points) const;
+
+  // The points base*i for 0 <= i < count, computed in Jacobian
+  // representation and converted to affine coordinates with one batch
+  // inversion, as in ec_util.EcCurve.PointSequence.
+  std::vector<Point> PointSequenceImpl(const Point& base,
+                                       uint64_t count) const;
+
+  // The open addressing hash table of BuildDlogTable. Inserts keep both
+  // entries on equal fingerprints and lookups walk all matching slots, so
+  // the truncation to fingerprints cannot hide a baby step.
+  void DlogInsert(const mpz_class& x, uint64_t index);
+  void DlogCandidates(const mpz_class& x, std::vector<uint64_t>* out) const;
+
+  mpz_class mod_;
+  mpz_class a_;
+  mpz_class b_;
+  mpz_class n_;
+  Point g_;
+
+  // The window layout of ec_util.EcCurve.BatchMultiplyG: the window bits of
+  // a scalar are spread steps_ positions apart. cache_[w] is the generator
+  // times the scalar whose spread out window is w; cached_[w] says whether
+  // the entry has been computed yet.
+  int steps_;
+  int window_bits_;
+  std::vector<Point> cache_;
+  std::vector<bool> cached_;
+
+  // The baby step table: slot i holds the fingerprint of an x-coordinate
+  // and the baby step index of the point; a fingerprint of 0 marks an
+  // empty slot. The number of slots is a power of two of at least twice
+  // the table size.
+  uint64_t dlog_table_size_ = 0;
+  uint64_t dlog_slot_mask_ = 0;
+  std::vector<uint64_t> dlog_fingerprints_;
+  std::vector<uint64_t> dlog_indices_;
+};
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_EC_ARITH_H_
@@ -0,0 +1,365 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/ec_arith.h"
+
+#include <gmpxx.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::cc_util {
+namespace {
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, -1, 1, 0, 0, value.get_mpz_t());
+  bytes.resize(count > 0 ? count : 1);
+  return bytes;
+}
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+  return value;
+}
+
+mpz_class Mod(const mpz_class& value, const mpz_class& mod) {
+  mpz_class res;
+  mpz_mod(res.get_mpz_t(), value.get_mpz_t(), mod.get_mpz_t());
+  return res;
+}
+
+mpz_class Inv(const mpz_class& value, const mpz_class& mod) {
+  mpz_class res;
+  EXPECT_NE(
+      0, mpz_invert(res.get_mpz_t(), value.get_mpz_t(), mod.get_mpz_t()));
+  return res;
+}
+
+// The reference below is an independent affine implementation of the group
+// law, with one modular inversion per addition; nullopt is the point at
+// infinity.
+using RefPoint = std::optional<std::pair<mpz_class, mpz_class>>;
+
+struct Curve {
+  mpz_class mod, a, b, gx, gy, n;
+};
+
+// The curve secp256r1.
+Curve TestCurve() {
+  Curve c;
+  c.mod = (mpz_class(1) << 256) - (mpz_class(1) << 224) +
+          (mpz_class(1) << 192) + (mpz_class(1) << 96) - 1;
+  c.a = c.mod - 3;
+  c.b = mpz_class(
+      "0x5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b");
+  c.gx = mpz_class(
+      "0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296");
+  c.gy = mpz_class(
+      "0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5");
+  c.n = mpz_class(
+      "0xffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551");
+  return c;
+}
+
+EcGroup TestGroup(const Curve& c) {
+  return EcGroup(ToBytes(c.mod), ToBytes(c.a), ToBytes(c.b), ToBytes(c.gx),
+                 ToBytes(c.gy), ToBytes(c.n));
+}
+
+RefPoint RefDouble(const Curve& c, const RefPoint& p) {
+  if (!p || p->second == 0) {
+    return std::nullopt;
+  }
+  mpz_class t =
+      Mod((3 * p->first * p->first + c.a) * Inv(2 * p->second, c.mod), c.mod);
+  mpz_class x = Mod(t * t - 2 * p->first, c.mod);
+  mpz_class y = Mod(t * (p->first - x) - p->second, c.mod);
+  return std::make_pair(x, y);
+}
+
+RefPoint RefAdd(const Curve& c, const RefPoint& p, const RefPoint& q) {
+  if (!p) {
+    return q;
+  }
+  if (!q) {
+    return p;
+  }
+  if (p->first == q->first) {
+    if (p->second == q->second) {
+      return RefDouble(c, p);
+    }
+    return std::nullopt;
+  }
+  mpz_class t = Mod(
+      (p->second - q->second) * Inv(Mod(p->first - q->first, c.mod), c.mod),
+      c.mod);
+  mpz_class x = Mod(t * t - p->first - q->first, c.mod);
+  mpz_class y = Mod(t * (p->first - x) - p->second, c.mod);
+  return std::make_pair(x, y);
+}
+
+RefPoint RefMultiplyG(const Curve& c, const mpz_class& scalar) {
+  mpz_class k = Mod(scalar, c.n);
+  RefPoint res = std::nullopt;
+  RefPoint base = std::make_pair(c.gx, c.gy);
+  for (size_t i = 0; i < mpz_sizeinbase(k.get_mpz_t(), 2); i++) {
+    if (mpz_tstbit(k.get_mpz_t(), i)) {
+      res = RefAdd(c, res, base);
+    }
+    base = RefDouble(c, base);
+  }
+  return res;
+}
+
+std::vector<std::string> EncodePoints(const std::vector<RefPoint>& points) {
+  std::vector<std::string> flat;
+  for (const RefPoint& p : points) {
+    flat.push_back(p ? ToBytes(p->first) : "");
+    flat.push_back(p ? ToBytes(p->second) : "");
+  }
+  return flat;
+}
+
+std::vector<RefPoint> DecodePoints(const std::vector<std::string>& flat) {
+  EXPECT_EQ(0, flat.size() % 2);
+  std::vector<RefPoint> points;
+  for (size_t i = 0; i < flat.size(); i += 2) {
+    if (flat[i].empty()) {
+      points.push_back(std::nullopt);
+    } else {
+      points.push_back(
+          std::make_pair(FromBytes(flat[i]), FromBytes(flat[i + 1])));
+    }
+  }
+  return points;
+}
+
+void ExpectPointsEq(const std::vector<RefPoint>& expected,
+                    const std::vector<RefPoint>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(expected[i].has_value(), actual[i].has_value()) << i;
+    if (expected[i].has_value()) {
+      EXPECT_EQ(expected[i]->first, actual[i]->first) << i;
+      EXPECT_EQ(expected[i]->second, actual[i]->second) << i;
+    }
+  }
+}
+
+// Pseudo random points on the curve, with the degenerate cases of the
+// batch operations planted at the front: points at infinity, a point
+// added to itself and a point added to its negative.
+std::pair<std::vector<RefPoint>, std::vector<RefPoint>> TestPoints(
+    const Curve& c, int count) {
+  gmp_randclass rand(gmp_randinit_default);
+  rand.seed(12345);
+  std::vector<RefPoint> p_list(count);
+  std::vector<RefPoint> q_list(count);
+  for (int i = 0; i < count; i++) {
+    p_list[i] = RefMultiplyG(c, rand.get_z_range(c.n));
+    q_list[i] = RefMultiplyG(c, rand.get_z_range(c.n));
+  }
+  p_list[0] = std::nullopt;
+  q_list[1] = std::nullopt;
+  p_list[2] = std::nullopt;
+  q_list[2] = std::nullopt;
+  q_list[3] = p_list[3];
+  q_list[4] = std::make_pair(p_list[4]->first, Mod(-p_list[4]->second, c.mod));
+  return {p_list, q_list};
+}
+
+TEST(EcArithTest, BatchInverse) {
+  const Curve c = TestCurve();
+  const EcGroup group = TestGroup(c);
+  gmp_randclass rand(gmp_randinit_default);
+  rand.seed(12345);
+  std::vector<mpz_class> values(20);
+  std::vector<std::string> encoded(20);
+  for (int i = 0; i < 20; i++) {
+    values[i] = rand.get_z_range(c.mod);
+    encoded[i] = ToBytes(values[i]);
+  }
+  values[0] = 0;
+  encoded[0] = ToBytes(values[0]);
+  encoded[1] = "";  // None
+  values[1] = 0;
+  values[2] = 2 * c.mod;  // inverts to None, like 0
+  encoded[2] = ToBytes(values[2]);
+  std::vector<std::string> inverses = group.BatchInverse(encoded);
+  ASSERT_EQ(20, inverses.size());
+  for (int i = 0; i < 20; i++) {
+    if (Mod(values[i], c.mod) == 0) {
+      EXPECT_TRUE(inverses[i].empty()) << i;
+    } else {
+      EXPECT_EQ(1, Mod(FromBytes(inverses[i]) * values[i], c.mod)) << i;
+    }
+  }
+}
+
+TEST(EcArithTest, BatchAddList) {
+  const Curve c = TestCurve();
+  const EcGroup group = TestGroup(c);
+  auto [p_list, q_list] = TestPoints(c, 20);
+  std::vector<RefPoint> res = DecodePoints(
+      group.BatchAddList(EncodePoints(p_list), EncodePoints(q_list)));
+  std::vector<RefPoint> expected(20);
+  for (int i = 0; i < 20; i++) {
+    expected[i] = RefAdd(c, p_list[i], q_list[i]);
+  }
+  ExpectPointsEq(expected, res);
+}
+
+TEST(EcArithTest, BatchAdd) {
+  const Curve c = TestCurve();
+  const EcGroup group = TestGroup(c);
+  auto [p_list, q_list] = TestPoints(c, 20);
+  const RefPoint p = RefMultiplyG(c, 987654321);
+  std::vector<RefPoint> res = DecodePoints(group.BatchAdd(
+      ToBytes(p->first), ToBytes(p->second), EncodePoints(q_list)));
+  std::vector<RefPoint> expected(20);
+  for (int i = 0; i < 20; i++) {
+    expected[i] = RefAdd(c, p, q_list[i]);
+  }
+  ExpectPointsEq(expected, res);
+}
+
+TEST(EcArithTest, BatchAddWithInfinity) {
+  const Curve c = TestCurve();
+  const EcGroup group = TestGroup(c);
+  auto [p_list, q_list] = TestPoints(c, 20);
+  std::vector<RefPoint> res =
+      DecodePoints(group.BatchAdd("", "", EncodePoints(q_list)));
+  ExpectPointsEq(q_list, res);
+}
+
+TEST(EcArithTest, BatchDouble) {
+  const Curve c = TestCurve();
+  const EcGroup group = TestGroup(c);
+  auto [p_list, q_list] = TestPoints(c, 20);
+  std::vector<RefPoint> res =
+      DecodePoints(group.BatchDouble(EncodePoints(p_list)));
+  std::vector<RefPoint> expected(20);
+  for (int i = 0; i < 20; i++) {
+    expected[i] = RefDouble(c, p_list[i]);
+  }
+  ExpectPointsEq(expected, res);
+}
+
+TEST(EcArithTest, BatchMultiplyG) {
+  const Curve c = TestCurve();
+  EcGroup group = TestGroup(c);
+  gmp_randclass rand(gmp_randinit_default);
+  rand.seed(12345);
+  std::vector<mpz_class> scalars = {0, 1, 2, c.n - 1, c.n, c.n + 12345};
+  for (int i = 0; i < 20; i++) {
+    scalars.push_back(rand.get_z_range(c.n));
+  }
+  std::vector<std::string> encoded;
+  for (const mpz_class& s : scalars) {
+    encoded.push_back(ToBytes(s));
+  }
+  // Runs the batch twice; the second call reuses the cached multiples of
+  // the generator.
+  for (int run = 0; run < 2; run++) {
+    std::vector<RefPoint> res = DecodePoints(group.BatchMultiplyG(encoded));
+    std::vector<RefPoint> expected(scalars.size());
+    for (size_t i = 0; i < scalars.size(); i++) {
+      expected[i] = RefMultiplyG(c, scalars[i]);
+    }
+    ExpectPointsEq(expected, res);
+  }
+}
+
+TEST(EcArithTest, BatchDl) {
+  const Curve c = TestCurve();
+  EcGroup group = TestGroup(c);
+  const int64_t bound = 1 << 20;
+  std::vector<int64_t> dls = {0, 1, 2, 999, 65535, bound - 1, 2 * bound, -17};
+  std::vector<RefPoint> points;
+  for (int64_t dl : dls) {
+    points.push_back(RefMultiplyG(c, dl));
+  }
+  group.BuildDlogTable(
+      static_cast<uint64_t>(std::sqrt(static_cast<double>(bound) *
+                                      static_cast<double>(dls.size()))));
+  std::vector<int64_t> res =
+      group.BatchDl(EncodePoints(points), bound, /*num_threads=*/0);
+  ASSERT_EQ(dls.size(), res.size());
+  for (size_t i = 0; i < dls.size(); i++) {
+    if (res[i] == kDlogNotFound) {
+      EXPECT_LE(bound, std::abs(dls[i])) << i;
+    } else {
+      EXPECT_EQ(dls[i], res[i]) << i;
+    }
+  }
+}
+
+TEST(EcArithTest, BatchDlKeepsLargerTable) {
+  const Curve c = TestCurve();
+  EcGroup group = TestGroup(c);
+  group.BuildDlogTable(1000);
+  EXPECT_EQ(1000, group.dlog_table_size());
+  group.BuildDlogTable(10);
+  EXPECT_EQ(1000, group.dlog_table_size());
+  group.BuildDlogTable(2000);
+  EXPECT_EQ(2000, group.dlog_table_size());
+}
+
+TEST(EcArithTest, DlogLookup) {
+  const Curve c = TestCurve();
+  EcGroup group = TestGroup(c);
+  group.BuildDlogTable(10000);
+  std::vector<uint64_t> indices = {5, 17, 1234};
+  std::vector<std::string> xs;
+  for (uint64_t i : indices) {
+    xs.push_back(ToBytes(RefMultiplyG(c, i)->first));
+  }
+  xs.push_back("");  // skipped, e.g. a duplicated key
+  std::vector<int64_t> pairs = group.DlogLookup(xs);
+  ASSERT_EQ(0, pairs.size() % 2);
+  for (size_t k = 0; k < indices.size(); k++) {
+    bool found = false;
+    for (size_t j = 0; j < pairs.size(); j += 2) {
+      EXPECT_NE(3, pairs[j]) << "empty entries must be skipped";
+      if (pairs[j] == static_cast<int64_t>(k) &&
+          pairs[j + 1] == static_cast<int64_t>(indices[k])) {
+        found = true;
+      }
+    }
+    EXPECT_TRUE(found) << indices[k];
+  }
+}
+
+TEST(EcArithTest, InconsistentParameters) {
+  const Curve c = TestCurve();
+  const EcGroup group = TestGroup(c);
+  // flat point lists of odd length rsp. of different sizes
+  EXPECT_TRUE(group.BatchAddList({""}, {""}).empty());
+  EXPECT_TRUE(group.BatchAddList({"", ""}, {"", "", "", ""}).empty());
+  EXPECT_TRUE(group.BatchDouble({""}).empty());
+  EXPECT_TRUE(group.BatchAdd("", "", {""}).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::cc_util
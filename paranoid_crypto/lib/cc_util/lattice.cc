@@ -0,0 +1,352 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/lattice.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "paranoid_crypto/lib/cc_util/parallel.h"
+
+namespace paranoid_crypto::lib::cc_util {
+
+namespace {
+
+// Converts a signed little endian byte string, as produced by
+// int.to_bytes(..., "little", signed=True), into an integer.
+mpz_class FromBytesSigned(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  if (!bytes.empty() && (bytes.back() & 0x80)) {
+    value -= mpz_class(1) << (8 * bytes.size());
+  }
+  return value;
+}
+
+// Converts an integer into a signed little endian byte string.
+std::string ToBytesSigned(const mpz_class& value) {
+  // One extra bit so that the most significant bit is free for the sign.
+  size_t length = mpz_sizeinbase(value.get_mpz_t(), 2) / 8 + 1;
+  mpz_class padded = value;
+  if (value < 0) {
+    padded += mpz_class(1) << (8 * length);
+  }
+  std::string bytes(length, '\0');
+  mpz_export(&bytes[0], nullptr, /*order=*/-1, /*size=*/1, /*endian=*/0,
+             /*nails=*/0, padded.get_mpz_t());
+  return bytes;
+}
+
+// The Gram-Schmidt arithmetic of the reduction below is parameterized so
+// that the same algorithm runs with extended double precision (the fast
+// path) and with exact rationals (the fallback). The basis vectors and
+// their Gram matrix are exact integers in both cases; only the
+// Gram-Schmidt coefficients mu and the squared norms differ.
+struct LongDoubleOps {
+  using Value = long double;
+
+  // long double has a 15 bit exponent, so unlike a plain double this
+  // conversion does not overflow for the multi-thousand bit norms of the
+  // unreduced hidden number problem lattices.
+  static Value FromMpz(const mpz_class& value) {
+    long exponent;
+    double mantissa = mpz_get_d_2exp(&exponent, value.get_mpz_t());
+    return std::ldexp(static_cast<long double>(mantissa), exponent);
+  }
+
+  // Rounds to the nearest integer. Unreduced Gram-Schmidt coefficients
+  // can be far larger than 2^64, hence the chunked conversion.
+  static mpz_class Round(Value value) {
+    bool negative = value < 0;
+    long double remaining = std::floor(std::fabs(value) + 0.5L);
+    mpz_class result = 0;
+    while (remaining >= 1.0L) {
+      int exponent;
+      long double mantissa = std::frexp(remaining, &exponent);
+      if (exponent <= 63) {
+        result += mpz_class(static_cast<unsigned long>(remaining));
+        break;
+      }
+      long double top = std::floor(std::ldexp(mantissa, 63));
+      result += mpz_class(static_cast<unsigned long>(top)) << (exponent - 63);
+      remaining -= std::ldexp(top, exponent - 63);
+    }
+    return negative ? mpz_class(-result) : result;
+  }
+
+  static Value Delta() { return 0.99L; }
+};
+
+struct RationalOps {
+  using Value = mpq_class;
+
+  static Value FromMpz(const mpz_class& value) { return mpq_class(value); }
+
+  static mpz_class Round(const Value& value) {
+    // round(n/d) = floor((2n + d) / 2d) for d > 0.
+    mpz_class result;
+    mpz_class numerator = 2 * value.get_num() + value.get_den();
+    mpz_class denominator = 2 * value.get_den();
+    mpz_fdiv_q(result.get_mpz_t(), numerator.get_mpz_t(),
+               denominator.get_mpz_t());
+    return result;
+  }
+
+  static Value Delta() { return mpq_class(99, 100); }
+};
+
+// LLL reduces the basis in place. All row operations are unimodular, so
+// the rows always span the input lattice, even if the step budget runs
+// out. max_steps <= 0 means no budget. Returns false if the budget was
+// exhausted or the floating point size reduction failed to converge, in
+// which case the caller reruns with exact arithmetic.
+template <typename Ops>
+bool LllImpl(std::vector<std::vector<mpz_class>>* basis, int64_t max_steps) {
+  using Value = typename Ops::Value;
+  std::vector<std::vector<mpz_class>>& b = *basis;
+  const size_t rows = b.size();
+  if (rows == 0) {
+    return true;
+  }
+  const size_t cols = b[0].size();
+
+  // Exact Gram matrix; kept symmetric so the updates below stay simple.
+  std::vector<std::vector<mpz_class>> gram(rows, std::vector<mpz_class>(rows));
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j <= i; j++) {
+      mpz_class dot = 0;
+      for (size_t t = 0; t < cols; t++) {
+        dot += b[i][t] * b[j][t];
+      }
+      gram[i][j] = dot;
+      gram[j][i] = dot;
+    }
+  }
+
+  std::vector<std::vector<Value>> mu(rows, std::vector<Value>(rows));
+  std::vector<Value> norm(rows);  // squared Gram-Schmidt norms
+
+  // Recomputes mu[k][j] for j < k and norm[k] from the exact Gram matrix.
+  // Rows below k must be up to date.
+  auto gs_row = [&](size_t k) {
+    std::vector<Value> r(k + 1);
+    for (size_t j = 0; j <= k; j++) {
+      Value value = Ops::FromMpz(gram[k][j]);
+      for (size_t i = 0; i < j; i++) {
+        value -= mu[j][i] * r[i];
+      }
+      r[j] = value;
+      if (j < k) {
+        mu[k][j] = norm[j] > 0 ? value / norm[j] : Value(0);
+      }
+    }
+    norm[k] = r[k];
+  };
+
+  // Subtracts q times row j from row k, keeping the Gram matrix and the
+  // mu row of k consistent.
+  auto reduce_against = [&](size_t k, size_t j, const mpz_class& q) {
+    for (size_t t = 0; t < cols; t++) {
+      b[k][t] -= q * b[j][t];
+    }
+    gram[k][k] += q * q * gram[j][j] - 2 * q * gram[k][j];
+    for (size_t i = 0; i < rows; i++) {
+      if (i == k) {
+        continue;
+      }
+      gram[k][i] -= q * gram[j][i];
+      gram[i][k] = gram[k][i];
+    }
+    Value qf = Ops::FromMpz(q);
+    for (size_t i = 0; i < j; i++) {
+      mu[k][i] -= qf * mu[j][i];
+    }
+    mu[k][j] -= qf;
+  };
+
+  // Size reduces row k. With exact arithmetic a single pass suffices; the
+  // floating point path repeats with freshly recomputed coefficients and
+  // gives up after a few passes if rounding keeps it from converging.
+  auto reduce_row = [&](size_t k) {
+    for (int pass = 0; pass < 8; pass++) {
+      gs_row(k);
+      bool changed = false;
+      for (size_t j = k; j-- > 0;) {
+        mpz_class q = Ops::Round(mu[k][j]);
+        if (q != 0) {
+          reduce_against(k, j, q);
+          changed = true;
+        }
+      }
+      if (!changed) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto is_zero_row = [&](size_t k) {
+    for (size_t t = 0; t < cols; t++) {
+      if (b[k][t] != 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Moves row k to position `start`, shifting the rows in between down.
+  auto rotate_to_front = [&](size_t start, size_t k) {
+    for (size_t i = k; i > start; i--) {
+      std::swap(b[i], b[i - 1]);
+      std::swap(gram[i], gram[i - 1]);
+      for (size_t j = 0; j < rows; j++) {
+        std::swap(gram[j][i], gram[j][i - 1]);
+      }
+    }
+  };
+
+  size_t start = 0;  // rows [0, start) are zero vectors
+  while (start < rows && is_zero_row(start)) {
+    norm[start] = Value(0);
+    start++;
+  }
+  if (start < rows) {
+    gs_row(start);
+  }
+  size_t k = start + 1;
+  int64_t steps = 0;
+  while (k < rows) {
+    if (max_steps > 0 && ++steps > max_steps) {
+      return false;
+    }
+    if (!reduce_row(k)) {
+      return false;
+    }
+    if (is_zero_row(k)) {
+      // Row k turned out to be a linear combination of the rows above it.
+      rotate_to_front(start, k);
+      std::fill(mu[start].begin(), mu[start].end(), Value(0));
+      norm[start] = Value(0);
+      start++;
+      for (size_t j = start; j <= k && j < rows; j++) {
+        gs_row(j);
+      }
+      k = std::max(k, start + 1);
+      continue;
+    }
+    // The Lovasz condition with delta = 0.99. A zero norm[k - 1] marks a
+    // dependent row that has not been fully eliminated yet; swapping it
+    // down shrinks it further, as in MLLL.
+    if (norm[k - 1] > 0 &&
+        norm[k] >= (Ops::Delta() - mu[k][k - 1] * mu[k][k - 1]) * norm[k - 1]) {
+      k++;
+    } else {
+      std::swap(b[k], b[k - 1]);
+      std::swap(gram[k], gram[k - 1]);
+      for (size_t j = 0; j < rows; j++) {
+        std::swap(gram[j][k], gram[j][k - 1]);
+      }
+      gs_row(k - 1);
+      k = std::max(k - 1, start + 1);
+    }
+  }
+  return true;
+}
+
+std::vector<std::vector<mpz_class>> DecodeMatrix(
+    const std::vector<std::vector<std::string>>& matrix, bool* consistent) {
+  *consistent = true;
+  std::vector<std::vector<mpz_class>> rows;
+  rows.reserve(matrix.size());
+  for (const std::vector<std::string>& row : matrix) {
+    if (row.size() != matrix[0].size()) {
+      *consistent = false;
+      return {};
+    }
+    std::vector<mpz_class> decoded;
+    decoded.reserve(row.size());
+    for (const std::string& entry : row) {
+      decoded.push_back(FromBytesSigned(entry));
+    }
+    rows.push_back(std::move(decoded));
+  }
+  return rows;
+}
+
+std::vector<std::vector<std::string>> EncodeMatrix(
+    const std::vector<std::vector<mpz_class>>& rows) {
+  std::vector<std::vector<std::string>> matrix;
+  matrix.reserve(rows.size());
+  for (const std::vector<mpz_class>& row : rows) {
+    std::vector<std::string> encoded;
+    encoded.reserve(row.size());
+    for (const mpz_class& entry : row) {
+      encoded.push_back(ToBytesSigned(entry));
+    }
+    matrix.push_back(std::move(encoded));
+  }
+  return matrix;
+}
+
+std::vector<std::vector<std::string>> LllReduceImpl(
+    const std::vector<std::vector<std::string>>& matrix) {
+  bool consistent;
+  std::vector<std::vector<mpz_class>> basis = DecodeMatrix(matrix, &consistent);
+  if (!consistent) {
+    return {};
+  }
+  if (basis.empty()) {
+    return EncodeMatrix(basis);
+  }
+  // The budget is far above the step counts of well behaved reductions;
+  // it only cuts off the floating point pass if rounding errors make it
+  // cycle, in which case the exact pass finishes the job.
+  size_t max_bits = 1;
+  for (const std::vector<mpz_class>& row : basis) {
+    for (const mpz_class& entry : row) {
+      max_bits = std::max(max_bits, mpz_sizeinbase(entry.get_mpz_t(), 2));
+    }
+  }
+  int64_t max_steps = 10000 + 200 * static_cast<int64_t>(basis.size()) *
+                                  basis.size() * max_bits;
+  max_steps = std::min<int64_t>(max_steps, 1000000000);
+  if (!LllImpl<LongDoubleOps>(&basis, max_steps)) {
+    LllImpl<RationalOps>(&basis, /*max_steps=*/0);
+  }
+  return EncodeMatrix(basis);
+}
+
+}  // namespace
+
+std::vector<std::vector<std::string>> LllReduce(
+    const std::vector<std::vector<std::string>>& matrix) {
+  return LllReduceImpl(matrix);
+}
+
+std::vector<std::vector<std::vector<std::string>>> LllReduceBatch(
+    const std::vector<std::vector<std::vector<std::string>>>& matrices,
+    int num_threads) {
+  std::vector<std::vector<std::vector<std::string>>> results(matrices.size());
+  ParallelFor(static_cast<int>(matrices.size()), num_threads,
+              [&](int task) { results[task] = LllReduceImpl(matrices[task]); });
+  return results;
+}
+
+}  // namespace paranoid_crypto::lib::cc_util
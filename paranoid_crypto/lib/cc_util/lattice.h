@@ -0,0 +1,50 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_LATTICE_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_LATTICE_H_
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// Computes an LLL reduced basis of the lattice spanned by the rows of the
+// matrix, with the reduction parameter delta = 0.99. This is the engine
+// behind lll.reduce.
+//
+// The basis vectors are kept exactly: the matrix entries and an exact
+// Gram matrix use GMP integers, so every intermediate state is a valid
+// basis of the input lattice. The Gram-Schmidt coefficients are computed
+// in extended double precision from the exact Gram matrix, which handles
+// the coefficient sizes of the lattices built by hidden_number_problem
+// and small_roots; if the floating point pass cannot make progress, the
+// reduction falls back to exact rational arithmetic. Rows that turn out
+// to be linearly dependent are reduced to zero vectors and collected at
+// the top of the basis, like in fplll.
+//
+// Matrix entries are signed little endian byte strings, as produced by
+// int.to_bytes(..., "little", signed=True). Returns an empty matrix if
+// the rows do not all have the same number of entries.
+std::vector<std::vector<std::string>> LllReduce(
+    const std::vector<std::vector<std::string>>& matrix);
+
+// Reduces a batch of independent lattices with num_threads worker
+// threads (the number of hardware threads if num_threads <= 0).
+std::vector<std::vector<std::vector<std::string>>> LllReduceBatch(
+    const std::vector<std::vector<std::vector<std::string>>>& matrices,
+    int num_threads);
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_LATTICE_H_
@@ -0,0 +1,198 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/lattice.h"
+
+#include <gmpxx.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::cc_util {
+namespace {
+
+typedef std::vector<std::vector<mpz_class>> Matrix;
+
+std::string ToBytesSigned(const mpz_class& value) {
+  size_t length = mpz_sizeinbase(value.get_mpz_t(), 2) / 8 + 1;
+  mpz_class padded = value;
+  if (value < 0) {
+    padded += mpz_class(1) << (8 * length);
+  }
+  std::string bytes(length, '\0');
+  mpz_export(&bytes[0], nullptr, -1, 1, 0, 0, padded.get_mpz_t());
+  return bytes;
+}
+
+mpz_class FromBytesSigned(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+  if (!bytes.empty() && (bytes.back() & 0x80)) {
+    value -= mpz_class(1) << (8 * bytes.size());
+  }
+  return value;
+}
+
+std::vector<std::vector<std::string>> Encode(const Matrix& matrix) {
+  std::vector<std::vector<std::string>> encoded;
+  for (const std::vector<mpz_class>& row : matrix) {
+    std::vector<std::string> encoded_row;
+    for (const mpz_class& value : row) {
+      encoded_row.push_back(ToBytesSigned(value));
+    }
+    encoded.push_back(encoded_row);
+  }
+  return encoded;
+}
+
+Matrix Decode(const std::vector<std::vector<std::string>>& matrix) {
+  Matrix decoded;
+  for (const std::vector<std::string>& row : matrix) {
+    std::vector<mpz_class> decoded_row;
+    for (const std::string& value : row) {
+      decoded_row.push_back(FromBytesSigned(value));
+    }
+    decoded.push_back(decoded_row);
+  }
+  return decoded;
+}
+
+Matrix Reduce(const Matrix& matrix) {
+  return Decode(LllReduce(Encode(matrix)));
+}
+
+mpq_class Dot(const std::vector<mpq_class>& a, const std::vector<mpq_class>& b) {
+  mpq_class res = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    res += a[i] * b[i];
+  }
+  return res;
+}
+
+// Checks with exact rational Gram-Schmidt that the basis is LLL reduced:
+// |mu| <= 0.52 and the Lovasz condition with delta = 0.98, leaving a bit
+// of slack for the floating point pass of the reduction.
+void ExpectReduced(const Matrix& basis) {
+  std::vector<std::vector<mpq_class>> star;
+  std::vector<std::vector<mpq_class>> mu(
+      basis.size(), std::vector<mpq_class>(basis.size(), 0));
+  for (size_t k = 0; k < basis.size(); k++) {
+    std::vector<mpq_class> b(basis[k].begin(), basis[k].end());
+    for (size_t j = 0; j < k; j++) {
+      mpq_class norm = Dot(star[j], star[j]);
+      ASSERT_NE(0, norm);
+      mu[k][j] = Dot(b, star[j]) / norm;
+      for (size_t t = 0; t < b.size(); t++) {
+        b[t] -= mu[k][j] * star[j][t];
+      }
+      EXPECT_LE(abs(mu[k][j]), mpq_class(13, 25));
+    }
+    if (k > 0) {
+      mpq_class lhs = Dot(b, b) + mu[k][k - 1] * mu[k][k - 1] *
+                                      Dot(star[k - 1], star[k - 1]);
+      EXPECT_GE(lhs, mpq_class(49, 50) * Dot(star[k - 1], star[k - 1]));
+    }
+    star.push_back(b);
+  }
+}
+
+TEST(LatticeTest, LllReduceClassicExample) {
+  Matrix matrix = {{1, 1, 1}, {-1, 0, 2}, {3, 5, 6}};
+  Matrix reduced = Reduce(matrix);
+  ASSERT_EQ(3, reduced.size());
+  ExpectReduced(reduced);
+  // (0, 1, 0) is a shortest vector of this lattice.
+  mpz_class norm = 0;
+  for (const mpz_class& value : reduced[0]) {
+    norm += value * value;
+  }
+  EXPECT_EQ(1, norm);
+}
+
+TEST(LatticeTest, LllReduceRecoversShortVector) {
+  // A lattice hiding the short vector (1, -2, 3, 1) behind large entries.
+  mpz_class big = mpz_class("123456789123456789123456789");
+  Matrix matrix = {{1, -2, 3, 1},
+                   {big, big + 17, 1 - big, 5},
+                   {2 * big, 3, big, big - 1},
+                   {7, big, big, big}};
+  // Mix the short vector into the other rows.
+  for (size_t i = 1; i < matrix.size(); i++) {
+    for (size_t t = 0; t < matrix[i].size(); t++) {
+      matrix[i][t] += (17 + mpz_class(i)) * matrix[0][t];
+    }
+  }
+  std::swap(matrix[0], matrix[2]);
+  Matrix reduced = Reduce(matrix);
+  ExpectReduced(reduced);
+  mpz_class norm = 0;
+  for (const mpz_class& value : reduced[0]) {
+    norm += value * value;
+  }
+  EXPECT_EQ(15, norm);
+}
+
+TEST(LatticeTest, LllReduceNegativeEntries) {
+  Matrix matrix = {{-5, 0}, {3, -4}};
+  Matrix reduced = Reduce(matrix);
+  ASSERT_EQ(2, reduced.size());
+  ExpectReduced(reduced);
+  // The determinant is preserved up to sign.
+  mpz_class det = reduced[0][0] * reduced[1][1] - reduced[0][1] * reduced[1][0];
+  EXPECT_EQ(20, abs(det));
+}
+
+TEST(LatticeTest, LllReduceDependentRows) {
+  // The third row is in the span of the first two and must collapse to a
+  // zero row at the top of the result.
+  Matrix matrix = {{4, 1, 0}, {1, 3, 1}, {6, 7, 2}};
+  Matrix reduced = Reduce(matrix);
+  ASSERT_EQ(3, reduced.size());
+  EXPECT_EQ(std::vector<mpz_class>({0, 0, 0}), reduced[0]);
+  ExpectReduced(Matrix(reduced.begin() + 1, reduced.end()));
+}
+
+TEST(LatticeTest, LllReduceTrivialInputs) {
+  EXPECT_TRUE(LllReduce({}).empty());
+  EXPECT_EQ(Matrix({{0, 0}, {0, 0}}), Reduce({{0, 0}, {0, 0}}));
+  EXPECT_EQ(Matrix({{0, 1}, {1, 0}}), Reduce({{0, 1}, {1, 0}}));
+  // Rows of different lengths are inconsistent.
+  EXPECT_TRUE(LllReduce({{ToBytesSigned(1)},
+                         {ToBytesSigned(1), ToBytesSigned(2)}})
+                  .empty());
+}
+
+TEST(LatticeTest, LllReduceBatchMatchesSingle) {
+  std::vector<Matrix> matrices = {{{1, 1, 1}, {-1, 0, 2}, {3, 5, 6}},
+                                  {{-5, 0}, {3, -4}},
+                                  {{4, 1, 0}, {1, 3, 1}, {6, 7, 2}}};
+  std::vector<std::vector<std::vector<std::string>>> batch;
+  for (const Matrix& matrix : matrices) {
+    batch.push_back(Encode(matrix));
+  }
+  for (int num_threads : {1, 2, 0}) {
+    std::vector<std::vector<std::vector<std::string>>> reduced =
+        LllReduceBatch(batch, num_threads);
+    ASSERT_EQ(matrices.size(), reduced.size());
+    for (size_t i = 0; i < matrices.size(); i++) {
+      EXPECT_EQ(LllReduce(batch[i]), reduced[i]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,173 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/low_hamming_weight.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paranoid_crypto/lib/cc_util/parallel.h"
+
+namespace paranoid_crypto::lib::cc_util {
+
+namespace {
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, /*order=*/-1, /*size=*/1, /*endian=*/0,
+             /*nails=*/0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+// python's int.bit_length: 0 for 0, unlike mpz_sizeinbase.
+int64_t BitLength(const mpz_class& value) {
+  if (value == 0) {
+    return 0;
+  }
+  return mpz_sizeinbase(value.get_mpz_t(), 2);
+}
+
+// A partial factorization: p and q are guesses for the most significant
+// bits of the factors (shifted right by bit), hw is the sum of their
+// Hamming weights and v is the heuristic rem_size + 5 * hw.
+struct Node {
+  int64_t v;
+  int64_t hw;
+  int64_t bit;
+  mpz_class p;
+  mpz_class q;
+};
+
+// Orders the heap like the python quintuples (v, hw, bit, p, q), so the
+// search pops the nodes in the same order as the heapq based original.
+struct NodeGreater {
+  bool operator()(const Node& a, const Node& b) const {
+    if (a.v != b.v) return a.v > b.v;
+    if (a.hw != b.hw) return a.hw > b.hw;
+    if (a.bit != b.bit) return a.bit > b.bit;
+    int res = cmp(a.p, b.p);
+    if (res != 0) return res > 0;
+    return cmp(a.q, b.q) > 0;
+  }
+};
+
+LowHammingWeightResult Search(const mpz_class& n, int64_t cutoff,
+                              int64_t maxsteps) {
+  LowHammingWeightResult result;
+  const int64_t bits = BitLength(n);
+  // See rsa_util.CheckLowHammingWeight for how the thresholds were
+  // selected.
+  const int64_t threshold_cutoff = bits;
+  const int64_t threshold_weak = bits - 12;
+  const int64_t psize = (bits + 1) / 2;
+  if (psize < 1) {
+    return result;
+  }
+
+  std::priority_queue<Node, std::vector<Node>, NodeGreater> heap;
+  auto push = [&heap](mpz_class p0, mpz_class q0, int64_t hw, int64_t bit,
+                      int64_t rem_size) {
+    // The algorithm looks for a factorization where p <= q.
+    if (p0 <= q0) {
+      heap.push(
+          Node{rem_size + 5 * hw, hw, bit, std::move(p0), std::move(q0)});
+    }
+  };
+
+  mpz_class remainder = n - (mpz_class(1) << (2 * (psize - 1)));
+  push(1, 1, 2, psize - 1, BitLength(remainder));
+  // smallest value for the heuristic
+  int64_t minv = BitLength(remainder) + 5 * 2;
+  int64_t steps = 0;
+  while (steps < maxsteps && !heap.empty()) {
+    steps++;
+    if (steps == cutoff && minv >= threshold_cutoff) {
+      break;
+    }
+    Node node = heap.top();
+    heap.pop();
+    if (node.v < minv) {
+      minv = node.v;
+    }
+    mpz_class& p = node.p;
+    mpz_class& q = node.q;
+    int64_t hw = node.hw;
+    int64_t bit = node.bit;
+    mpz_class n0, p0, q0, rem0;
+    while (bit >= 1) {
+      p <<= 1;
+      q <<= 1;
+      bit -= 1;
+      n0 = n >> (2 * bit);
+      bool pruned = false;
+      for (auto [dp, dq] : {std::pair<int, int>{0, 1}, {1, 0}, {1, 1}}) {
+        // The algorithm guesses at this point that the factors of n are
+        // in the range [p0 << bit, (p0 + 1) << bit]
+        // and the range [q0 << bit, (q0 + 1) << bit].
+        p0 = p + dp;
+        q0 = q + dq;
+        rem0 = n0 - p0 * q0;
+        if (rem0 < 0) {
+          pruned = true;
+          break;
+        }
+        if (bit) {
+          if (rem0 <= p0 + q0) {
+            push(p0, q0, hw + dp + dq, bit, BitLength(rem0) + 2 * bit);
+          }
+        } else if (rem0 == 0) {
+          result.weak = true;
+          result.factors = {ToBytes(p0), ToBytes(q0)};
+          return result;
+        }
+      }
+      // All three guesses were too small: the descent along (p << 1,
+      // q << 1) can no longer satisfy the invariant, so stop it.
+      if (!pruned && rem0 > 0) {
+        break;
+      }
+    }
+  }
+  result.weak = minv <= threshold_weak;
+  return result;
+}
+
+}  // namespace
+
+std::vector<LowHammingWeightResult> LowHammingWeightBatch(
+    const std::vector<std::string>& moduli, int64_t cutoff, int64_t maxsteps,
+    int num_threads) {
+  std::vector<LowHammingWeightResult> results(moduli.size());
+  ParallelFor(static_cast<int>(moduli.size()), num_threads, [&](int task) {
+    results[task] = Search(FromBytes(moduli[task]), cutoff, maxsteps);
+  });
+  return results;
+}
+
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,49 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_LOW_HAMMING_WEIGHT_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_LOW_HAMMING_WEIGHT_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// Result of the search for one modulus. weak can be true without factors
+// when the search found a partial factorization with unusually low
+// Hamming weight; see rsa_util.CheckLowHammingWeight for the discussion
+// of such cases.
+struct LowHammingWeightResult {
+  bool weak = false;
+  std::vector<std::string> factors;
+};
+
+// Runs the branch and bound search behind rsa_util.CheckLowHammingWeight
+// on a batch of moduli, spread over num_threads worker threads (the
+// number of hardware threads if num_threads <= 0). The search semantics
+// (the heuristic rem_size + 5 * hamming_weight, the heap order including
+// tie breaking, and the cutoff and weakness thresholds) match the
+// original python implementation; only the node churn is cheaper. cutoff
+// and maxsteps have the same meaning as in the python function and apply
+// per modulus.
+//
+// Integers are unsigned little endian byte strings as produced by
+// int.to_bytes.
+std::vector<LowHammingWeightResult> LowHammingWeightBatch(
+    const std::vector<std::string>& moduli, int64_t cutoff, int64_t maxsteps,
+    int num_threads);
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_LOW_HAMMING_WEIGHT_H_
@@ -0,0 +1,118 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/low_hamming_weight.h"
+
+#include <gmpxx.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::cc_util {
+namespace {
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, -1, 1, 0, 0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+// A deterministic odd value of the given size with the given Hamming
+// weight, with the extra bits spread by a small linear congruence.
+mpz_class LowHammingWeightValue(int bits, int weight, int seed) {
+  mpz_class value = (mpz_class(1) << (bits - 1)) + 1;
+  uint64_t state = seed;
+  while (mpz_popcount(value.get_mpz_t()) <
+         static_cast<unsigned long>(weight)) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    mpz_setbit(value.get_mpz_t(), 1 + (state >> 33) % (bits - 2));
+  }
+  return value;
+}
+
+TEST(LowHammingWeightTest, FactorsLowHammingWeightProduct) {
+  mpz_class p = LowHammingWeightValue(256, 10, 1);
+  mpz_class q = LowHammingWeightValue(256, 10, 2);
+  if (p > q) {
+    std::swap(p, q);
+  }
+  std::vector<LowHammingWeightResult> results =
+      LowHammingWeightBatch({ToBytes(p * q)}, 2500, 1000000, 1);
+  ASSERT_EQ(1, results.size());
+  EXPECT_TRUE(results[0].weak);
+  // The test values are not prime, so the search may return any
+  // factorization of the product.
+  ASSERT_EQ(2, results[0].factors.size());
+  EXPECT_EQ(p * q, FromBytes(results[0].factors[0]) *
+                       FromBytes(results[0].factors[1]));
+}
+
+TEST(LowHammingWeightTest, PassesRandomProduct) {
+  // A product of values with roughly half the bits set stops after the
+  // cutoff without being flagged.
+  mpz_class p = LowHammingWeightValue(512, 256, 3);
+  mpz_class q = LowHammingWeightValue(512, 256, 4);
+  std::vector<LowHammingWeightResult> results =
+      LowHammingWeightBatch({ToBytes(p * q)}, 2500, 1000000, 1);
+  EXPECT_FALSE(results[0].weak);
+  EXPECT_EQ(0, results[0].factors.size());
+}
+
+TEST(LowHammingWeightTest, MaxstepsLimitsSearch) {
+  // With a tiny step budget the factorization is not found, but the
+  // search already flags the partial factorizations as suspicious.
+  mpz_class p = LowHammingWeightValue(512, 40, 5);
+  mpz_class q = LowHammingWeightValue(512, 40, 6);
+  std::vector<LowHammingWeightResult> results =
+      LowHammingWeightBatch({ToBytes(p * q)}, 2500, 500, 1);
+  EXPECT_TRUE(results[0].weak);
+  EXPECT_EQ(0, results[0].factors.size());
+}
+
+TEST(LowHammingWeightTest, BatchWithThreads) {
+  mpz_class p = LowHammingWeightValue(256, 10, 1);
+  mpz_class q = LowHammingWeightValue(256, 10, 2);
+  if (p > q) {
+    std::swap(p, q);
+  }
+  mpz_class r = LowHammingWeightValue(128, 64, 9);
+  mpz_class s = LowHammingWeightValue(128, 64, 10);
+  std::vector<std::string> moduli = {ToBytes(p * q), ToBytes(r * s)};
+  for (int num_threads : {1, 2, 0}) {
+    std::vector<LowHammingWeightResult> results =
+        LowHammingWeightBatch(moduli, 2500, 1000000, num_threads);
+    ASSERT_EQ(2, results.size());
+    EXPECT_TRUE(results[0].weak);
+    ASSERT_EQ(2, results[0].factors.size());
+    EXPECT_EQ(p * q,
+              FromBytes(results[0].factors[0]) *
+                  FromBytes(results[0].factors[1]));
+    EXPECT_FALSE(results[1].weak);
+  }
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,38 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_PARALLEL_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_PARALLEL_H_
+#include <functional>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// The shared scheduler of the batch engines in this directory.
+//
+// Runs fn(0) .. fn(num_tasks - 1) on num_threads threads and returns when
+// all tasks are done. The calling thread participates as one of the
+// workers, so num_threads == 1 runs the tasks inline without spawning.
+// num_threads <= 0 uses the number of hardware threads. Tasks are claimed
+// dynamically from a shared atomic counter, which balances the load when
+// task costs are uneven (e.g. moduli of different sizes); the tasks must
+// be independent, since the workers only synchronize on the counter.
+//
+// The pybind bindings call into the engines with the GIL released, so the
+// workers run fully concurrently with the interpreter.
+void ParallelFor(int num_tasks, int num_threads,
+                 const std::function<void(int)>& fn);
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_PARALLEL_H_
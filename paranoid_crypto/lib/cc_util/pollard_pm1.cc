@@ -0,0 +1,79 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/pollard_pm1.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "paranoid_crypto/lib/cc_util/parallel.h"
+
+namespace paranoid_crypto::lib::cc_util {
+
+namespace {
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, /*order=*/-1, /*size=*/1, /*endian=*/0,
+             /*nails=*/0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+}  // namespace
+
+std::vector<std::string> Pollardpm1Batch(const std::vector<std::string>& moduli,
+                                         const std::string& m,
+                                         const std::string& gcd_bound,
+                                         int num_threads) {
+  const mpz_class exponent = FromBytes(m);
+  const mpz_class bound = FromBytes(gcd_bound);
+  std::vector<std::string> results(moduli.size());
+  ParallelFor(static_cast<int>(moduli.size()), num_threads, [&](int task) {
+    mpz_class n = FromBytes(moduli[task]);
+    mpz_class p = 0;
+    if (n > 1) {
+      mpz_class g;
+      mpz_class n1 = n - 1;
+      mpz_gcd(g.get_mpz_t(), n1.get_mpz_t(), exponent.get_mpz_t());
+      if (g >= bound) {
+        // mpz_powm uses sliding window exponentiation on Montgomery
+        // residues; the huge exponent m dominates the cost.
+        mpz_class a, b;
+        mpz_class two = 2;
+        mpz_powm(a.get_mpz_t(), two.get_mpz_t(), n1.get_mpz_t(),
+                 n.get_mpz_t());
+        mpz_powm(b.get_mpz_t(), a.get_mpz_t(), exponent.get_mpz_t(),
+                 n.get_mpz_t());
+        b -= 1;
+        mpz_gcd(p.get_mpz_t(), b.get_mpz_t(), n.get_mpz_t());
+      }
+    }
+    results[task] = ToBytes(p);
+  });
+  return results;
+}
+
+}  // namespace paranoid_crypto::lib::cc_util
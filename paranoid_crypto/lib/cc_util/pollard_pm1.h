@@ -0,0 +1,44 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_POLLARD_PM1_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_POLLARD_PM1_H_
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// Runs Pollard's p-1 factoring attempt on a batch of RSA moduli. This is
+// the engine behind rsa_util.Pollardpm1Batch.
+//
+// m is the precomputed prime power product K*(p-1) is expected to divide;
+// the same m is reused for the whole batch. For each modulus n with
+// gcd(n - 1, m) >= gcd_bound the engine computes a = 2^(n-1) mod n and
+// returns gcd(a^m - 1, n); the base 2^(n-1) extends the test to cases
+// where p = b*m + 1 with b smooth. Moduli skipped by the gcd filter get
+// the result 0. The interpretation of the gcd (a proper factor, n itself
+// when both p-1 and q-1 are smooth, or 1 on failure) is left to the
+// caller.
+//
+// The moduli are spread over num_threads worker threads (the number of
+// hardware threads if num_threads <= 0). All integers are unsigned
+// little endian byte strings as produced by int.to_bytes.
+std::vector<std::string> Pollardpm1Batch(const std::vector<std::string>& moduli,
+                                         const std::string& m,
+                                         const std::string& gcd_bound,
+                                         int num_threads);
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_POLLARD_PM1_H_
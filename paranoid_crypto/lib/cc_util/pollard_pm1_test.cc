@@ -0,0 +1,121 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/pollard_pm1.h"
+
+#include <gmpxx.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::cc_util {
+namespace {
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, -1, 1, 0, 0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+TEST(PollardPm1Test, FindsSmoothFactor) {
+  // p - 1 = 22 divides m, q - 1 = 46 does not.
+  mpz_class n = 23 * 47;
+  mpz_class m = 2 * 3 * 5 * 7 * 11;
+  std::vector<std::string> results =
+      Pollardpm1Batch({ToBytes(n)}, ToBytes(m), ToBytes(1), 1);
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(23, FromBytes(results[0]));
+}
+
+TEST(PollardPm1Test, BothFactorsSmooth) {
+  // Both p - 1 and q - 1 divide m, so the gcd degenerates to n.
+  mpz_class n = 23 * 47;
+  mpz_class m = 2 * 3 * 5 * 7 * 11 * 23;
+  std::vector<std::string> results =
+      Pollardpm1Batch({ToBytes(n)}, ToBytes(m), ToBytes(1), 1);
+  EXPECT_EQ(n, FromBytes(results[0]));
+}
+
+TEST(PollardPm1Test, NotSmooth) {
+  mpz_class n = 23 * 47;
+  mpz_class m = 2 * 3 * 5 * 7;
+  std::vector<std::string> results =
+      Pollardpm1Batch({ToBytes(n)}, ToBytes(m), ToBytes(1), 1);
+  EXPECT_EQ(1, FromBytes(results[0]));
+}
+
+TEST(PollardPm1Test, GcdFilterSkips) {
+  // gcd(n - 1, m) is below the bound, so the modulus is not tested.
+  mpz_class n = 23 * 47;
+  mpz_class m = 2 * 3 * 5 * 7 * 11 * 23;
+  std::vector<std::string> results = Pollardpm1Batch(
+      {ToBytes(n)}, ToBytes(m), ToBytes(mpz_class(1) << 60), 1);
+  EXPECT_EQ(0, FromBytes(results[0]));
+}
+
+TEST(PollardPm1Test, BatchWithThreads) {
+  // A batch mixing primes p with 2000-powersmooth p - 1 and primes where
+  // Pollard p-1 must fail, with several thread counts.
+  mpz_class m = 1;
+  for (int prime = 2; prime < 2000; prime++) {
+    mpz_class value = prime;
+    if (mpz_probab_prime_p(value.get_mpz_t(), 25)) {
+      mpz_class power = value;
+      while (power * value < (mpz_class(1) << 40)) {
+        power *= value;
+      }
+      m *= power;
+    }
+  }
+  // Primes of the form k * 510510 + 1 with k < 2000, so p - 1 divides m.
+  auto smooth_prime = [](int first_k) {
+    for (int k = first_k;; k++) {
+      mpz_class p = mpz_class(510510) * k + 1;
+      if (mpz_probab_prime_p(p.get_mpz_t(), 25)) {
+        return p;
+      }
+    }
+  };
+  mpz_class p = smooth_prime(2);
+  mpz_class q = smooth_prime(100);
+  mpz_class hard_p, hard_q;
+  mpz_class start = mpz_class(1) << 64;
+  mpz_nextprime(hard_p.get_mpz_t(), start.get_mpz_t());
+  mpz_nextprime(hard_q.get_mpz_t(), hard_p.get_mpz_t());
+  std::vector<std::string> moduli = {ToBytes(p * q), ToBytes(hard_p * hard_q),
+                                     ToBytes(p * hard_q)};
+  for (int num_threads : {1, 2, 0}) {
+    std::vector<std::string> results =
+        Pollardpm1Batch(moduli, ToBytes(m), ToBytes(1), num_threads);
+    ASSERT_EQ(3, results.size());
+    EXPECT_EQ(0, (p * q) % FromBytes(results[0]));
+    EXPECT_NE(1, FromBytes(results[0]));
+    EXPECT_EQ(1, FromBytes(results[1]));
+    EXPECT_EQ(p, FromBytes(results[2]));
+  }
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,54 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/batch_gcd.h"
+
+#include <string>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// The values and the returned GCDs are unsigned little endian byte strings
+// as produced by int.to_bytes. The result is built as a list of bytes
+// explicitly, since letting pybind convert std::string would produce str
+// objects. The GIL is released for the computation itself.
+py::list BatchGcdBinding(const std::vector<std::string>& values,
+                         const std::string& other_prod, int num_threads,
+                         const std::string& temp_dir) {
+  std::vector<std::string> gcds;
+  {
+    py::gil_scoped_release release;
+    gcds = BatchGcd(values, other_prod, num_threads, temp_dir);
+  }
+  py::list result;
+  for (const std::string& gcd : gcds) {
+    result.append(py::bytes(gcd));
+  }
+  return result;
+}
+
+}  // namespace
+
+PYBIND11_MODULE(batch_gcd, m) {
+  m.def("BatchGcd", BatchGcdBinding);
+}
+
+}  // namespace paranoid_crypto::lib::cc_util::pybind
@@ -0,0 +1,64 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+from absl.testing import absltest
+from paranoid_crypto.lib.cc_util.pybind import batch_gcd
+
+
+def _ToBytes(value: int) -> bytes:
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
+
+
+def _FromBytes(value: bytes) -> int:
+  return int.from_bytes(value, "little")
+
+
+class BatchGcdTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/cc_util/batch_gcd_test.cc
+  The tests comparing with the python implementation are in
+    paranoid_crypto/lib/rsa_util_test.py
+  """
+
+  def testBatchGcd(self):
+    values = [15, 21, 22]
+    gcds = batch_gcd.BatchGcd([_ToBytes(v) for v in values], b"", 0, "")
+    self.assertEqual([3, 3, 1], [_FromBytes(g) for g in gcds])
+
+  def testOtherProd(self):
+    values = [15, 21, 22]
+    gcds = batch_gcd.BatchGcd([_ToBytes(v) for v in values], _ToBytes(11), 0,
+                              "")
+    self.assertEqual([3, 3, 11], [_FromBytes(g) for g in gcds])
+
+  def testSpilled(self):
+    values = [3 * 5 * 257, 7 * 257, 11 * 13, 5 * 11]
+    temp_dir = self.create_tempdir().full_path
+    gcds = batch_gcd.BatchGcd([_ToBytes(v) for v in values], b"", 2, temp_dir)
+    expected = [
+        math.gcd(v, math.prod(values) // v) for v in values
+    ]
+    self.assertEqual(expected, [_FromBytes(g) for g in gcds])
+
+  def testInconsistentParameters(self):
+    self.assertEqual([], batch_gcd.BatchGcd([], b"", 0, ""))
+    self.assertEqual([], batch_gcd.BatchGcd([_ToBytes(15), b"\x00"], b"", 0,
+                                            ""))
+
+
+if __name__ == "__main__":
+  absltest.main()
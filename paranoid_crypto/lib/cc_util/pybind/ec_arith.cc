@@ -0,0 +1,151 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/ec_arith.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "pybind11/numpy.h"
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// The bindings release the GIL for the computation and build the results
+// as lists of bytes explicitly, since letting pybind convert std::string
+// would produce str objects. Integers are unsigned little endian byte
+// strings as produced by int.to_bytes, an empty string is None, and point
+// lists are flat lists of coordinates; see ec_arith.h.
+py::list ToBytesList(const std::vector<std::string>& values) {
+  py::list result;
+  for (const std::string& value : values) {
+    result.append(py::bytes(value));
+  }
+  return result;
+}
+
+py::list BatchInverseBinding(const EcGroup& group,
+                             const std::vector<std::string>& values) {
+  std::vector<std::string> res;
+  {
+    py::gil_scoped_release release;
+    res = group.BatchInverse(values);
+  }
+  return ToBytesList(res);
+}
+
+py::list BatchAddBinding(const EcGroup& group, const std::string& px,
+                         const std::string& py_coord,
+                         const std::vector<std::string>& points) {
+  std::vector<std::string> res;
+  {
+    py::gil_scoped_release release;
+    res = group.BatchAdd(px, py_coord, points);
+  }
+  return ToBytesList(res);
+}
+
+py::list BatchAddListBinding(const EcGroup& group,
+                             const std::vector<std::string>& p_list,
+                             const std::vector<std::string>& q_list) {
+  std::vector<std::string> res;
+  {
+    py::gil_scoped_release release;
+    res = group.BatchAddList(p_list, q_list);
+  }
+  return ToBytesList(res);
+}
+
+py::list BatchDoubleBinding(const EcGroup& group,
+                            const std::vector<std::string>& p_list) {
+  std::vector<std::string> res;
+  {
+    py::gil_scoped_release release;
+    res = group.BatchDouble(p_list);
+  }
+  return ToBytesList(res);
+}
+
+py::list BatchMultiplyGBinding(EcGroup& group,
+                               const std::vector<std::string>& scalars) {
+  std::vector<std::string> res;
+  {
+    py::gil_scoped_release release;
+    res = group.BatchMultiplyG(scalars);
+  }
+  return ToBytesList(res);
+}
+
+// The logs are returned as a numpy int64 array with DLOG_NOT_FOUND for
+// misses: the batches of the discrete log scans are large and 8 bytes per
+// log beat a list of Python integers.
+py::array_t<int64_t> ToInt64Array(const std::vector<int64_t>& values) {
+  py::array_t<int64_t> result(values.size());
+  std::memcpy(result.mutable_data(), values.data(),
+              values.size() * sizeof(int64_t));
+  return result;
+}
+
+void BuildDlogTableBinding(EcGroup& group, uint64_t table_size) {
+  py::gil_scoped_release release;
+  group.BuildDlogTable(table_size);
+}
+
+py::array_t<int64_t> BatchDlBinding(EcGroup& group,
+                                    const std::vector<std::string>& points,
+                                    uint64_t n, int num_threads) {
+  std::vector<int64_t> logs;
+  {
+    py::gil_scoped_release release;
+    logs = group.BatchDl(points, n, num_threads);
+  }
+  return ToInt64Array(logs);
+}
+
+py::array_t<int64_t> DlogLookupBinding(const EcGroup& group,
+                                       const std::vector<std::string>& xs) {
+  std::vector<int64_t> pairs;
+  {
+    py::gil_scoped_release release;
+    pairs = group.DlogLookup(xs);
+  }
+  return ToInt64Array(pairs);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(ec_arith, m) {
+  m.attr("DLOG_NOT_FOUND") = py::int_(kDlogNotFound);
+  py::class_<EcGroup>(m, "EcGroup")
+      .def(py::init<const std::string&, const std::string&,
+                    const std::string&, const std::string&,
+                    const std::string&, const std::string&>())
+      .def("BatchInverse", BatchInverseBinding)
+      .def("BatchAdd", BatchAddBinding)
+      .def("BatchAddList", BatchAddListBinding)
+      .def("BatchDouble", BatchDoubleBinding)
+      .def("BatchMultiplyG", BatchMultiplyGBinding)
+      .def("BuildDlogTable", BuildDlogTableBinding)
+      .def("dlog_table_size", &EcGroup::dlog_table_size)
+      .def("BatchDl", BatchDlBinding)
+      .def("DlogLookup", DlogLookupBinding);
+}
+
+}  // namespace paranoid_crypto::lib::cc_util::pybind
@@ -0,0 +1,110 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.cc_util.pybind import ec_arith
+
+# The curve secp256r1.
+MOD = 2**256 - 2**224 + 2**192 + 2**96 - 1
+A = MOD - 3
+B = int("5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b", 16)
+GX = int("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16)
+GY = int("4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5", 16)
+N = int("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551", 16)
+
+
+def _ToBytes(value: int) -> bytes:
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
+
+
+def _FromBytes(value: bytes) -> int:
+  return int.from_bytes(value, "little")
+
+
+class EcArithTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/cc_util/ec_arith_test.cc
+  The tests comparing with the python implementation are in
+    paranoid_crypto/lib/ec_util_test.py
+  """
+
+  def setUp(self):
+    super().setUp()
+    self.group = ec_arith.EcGroup(
+        _ToBytes(MOD), _ToBytes(A), _ToBytes(B), _ToBytes(GX), _ToBytes(GY),
+        _ToBytes(N))
+
+  def testBatchInverse(self):
+    values = [2, 3, 0, MOD - 1]
+    inverses = self.group.BatchInverse([_ToBytes(v) for v in values])
+    self.assertLen(inverses, 4)
+    self.assertEqual(b"", inverses[2])
+    for v, inv in zip(values, inverses):
+      if v:
+        self.assertEqual(1, v * _FromBytes(inv) % MOD)
+
+  def testBatchMultiplyG(self):
+    points = self.group.BatchMultiplyG([_ToBytes(0), _ToBytes(1)])
+    self.assertEqual([b"", b"", _ToBytes(GX), _ToBytes(GY)], points)
+
+  def testBatchDouble(self):
+    # 2g computed with BatchMultiplyG and BatchDouble must agree.
+    doubled = self.group.BatchDouble([_ToBytes(GX), _ToBytes(GY)])
+    self.assertEqual(self.group.BatchMultiplyG([_ToBytes(2)]), doubled)
+
+  def testBatchAdd(self):
+    doubled = self.group.BatchDouble([_ToBytes(GX), _ToBytes(GY)])
+    # g + g, g + infinity and g + (-g)
+    points = [
+        _ToBytes(GX), _ToBytes(GY), b"", b"", _ToBytes(GX),
+        _ToBytes(MOD - GY)
+    ]
+    sums = self.group.BatchAdd(_ToBytes(GX), _ToBytes(GY), points)
+    self.assertEqual(doubled + [_ToBytes(GX), _ToBytes(GY), b"", b""], sums)
+
+  def testBatchAddList(self):
+    g3 = self.group.BatchMultiplyG([_ToBytes(3)])
+    doubled = self.group.BatchDouble([_ToBytes(GX), _ToBytes(GY)])
+    sums = self.group.BatchAddList(doubled, [_ToBytes(GX), _ToBytes(GY)])
+    self.assertEqual(g3, sums)
+
+  def testBatchDl(self):
+    self.group.BuildDlogTable(1000)
+    self.assertEqual(1000, self.group.dlog_table_size())
+    points = self.group.BatchMultiplyG(
+        [_ToBytes(dl) for dl in [0, 5, 123456]])
+    logs = self.group.BatchDl(points, 200000, 0)
+    self.assertEqual([0, 5, 123456], list(logs))
+
+  def testBatchDlNotFound(self):
+    self.group.BuildDlogTable(1000)
+    points = self.group.BatchMultiplyG([_ToBytes(2**40)])
+    logs = self.group.BatchDl(points, 2**20, 0)
+    self.assertEqual([ec_arith.DLOG_NOT_FOUND], list(logs))
+
+  def testDlogLookup(self):
+    self.group.BuildDlogTable(1000)
+    points = self.group.BatchMultiplyG([_ToBytes(17)])
+    pairs = list(self.group.DlogLookup([points[0], b""]))
+    self.assertIn((0, 17), list(zip(pairs[0::2], pairs[1::2])))
+
+  def testInconsistentParameters(self):
+    self.assertEqual([], self.group.BatchAddList([b"", b""], []))
+    self.assertEqual([], self.group.BatchDouble([b""]))
+
+
+if __name__ == "__main__":
+  absltest.main()
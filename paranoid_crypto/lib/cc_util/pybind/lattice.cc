@@ -0,0 +1,78 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/lattice.h"
+
+#include <string>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// Matrix entries are signed little endian byte strings, as produced by
+// int.to_bytes(..., "little", signed=True); see lattice.h. The bindings
+// release the GIL for the reduction and build the results as lists of
+// bytes explicitly, since letting pybind convert std::string would
+// produce str objects.
+py::list ToMatrix(const std::vector<std::vector<std::string>>& rows) {
+  py::list matrix;
+  for (const std::vector<std::string>& row : rows) {
+    py::list matrix_row;
+    for (const std::string& value : row) {
+      matrix_row.append(py::bytes(value));
+    }
+    matrix.append(matrix_row);
+  }
+  return matrix;
+}
+
+py::list LllReduceBinding(
+    const std::vector<std::vector<std::string>>& matrix) {
+  std::vector<std::vector<std::string>> res;
+  {
+    py::gil_scoped_release release;
+    res = LllReduce(matrix);
+  }
+  return ToMatrix(res);
+}
+
+py::list LllReduceBatchBinding(
+    const std::vector<std::vector<std::vector<std::string>>>& matrices,
+    int num_threads) {
+  std::vector<std::vector<std::vector<std::string>>> res;
+  {
+    py::gil_scoped_release release;
+    res = LllReduceBatch(matrices, num_threads);
+  }
+  py::list results;
+  for (const std::vector<std::vector<std::string>>& matrix : res) {
+    results.append(ToMatrix(matrix));
+  }
+  return results;
+}
+
+}  // namespace
+
+PYBIND11_MODULE(lattice, m) {
+  m.def("LllReduce", LllReduceBinding);
+  m.def("LllReduceBatch", LllReduceBatchBinding);
+}
+
+}  // namespace paranoid_crypto::lib::cc_util::pybind
@@ -0,0 +1,66 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.cc_util.pybind import lattice
+
+
+def _Encode(matrix: list[list[int]]) -> list[list[bytes]]:
+  return [[
+      v.to_bytes((v.bit_length() + 8) // 8, "little", signed=True) for v in row
+  ] for row in matrix]
+
+
+def _Decode(matrix: list[list[bytes]]) -> list[list[int]]:
+  return [[int.from_bytes(v, "little", signed=True) for v in row]
+          for row in matrix]
+
+
+class LatticeTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/cc_util/lattice_test.cc
+  The python wrapper lll.py is covered indirectly by
+    paranoid_crypto/lib/hidden_number_problem_test.py
+  """
+
+  def testLllReduce(self):
+    reduced = _Decode(lattice.LllReduce(_Encode([[1, 1, 1], [-1, 0, 2],
+                                                 [3, 5, 6]])))
+    self.assertLen(reduced, 3)
+    # The first row is a shortest vector of this lattice.
+    self.assertEqual(1, sum(v**2 for v in reduced[0]))
+
+  def testLllReduceNegativeEntries(self):
+    reduced = _Decode(lattice.LllReduce(_Encode([[-5, 0], [3, -4]])))
+    det = reduced[0][0] * reduced[1][1] - reduced[0][1] * reduced[1][0]
+    self.assertEqual(20, abs(det))
+
+  def testLllReduceBatch(self):
+    matrices = [
+        _Encode([[1, 1, 1], [-1, 0, 2], [3, 5, 6]]),
+        _Encode([[-5, 0], [3, -4]]),
+    ]
+    reduced = lattice.LllReduceBatch(matrices, 0)
+    self.assertLen(reduced, 2)
+    for matrix, res in zip(matrices, reduced):
+      self.assertEqual(lattice.LllReduce(matrix), res)
+
+  def testInconsistentParameters(self):
+    self.assertEqual([], lattice.LllReduce(_Encode([[1], [1, 2]])))
+
+
+if __name__ == "__main__":
+  absltest.main()
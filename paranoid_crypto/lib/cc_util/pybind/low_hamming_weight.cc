@@ -0,0 +1,60 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/low_hamming_weight.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// The binding releases the GIL for the search and builds each result as
+// a (weak, factors) tuple with the factors as bytes explicitly, since
+// letting pybind convert std::string would produce str objects. Integers
+// are unsigned little endian byte strings as produced by int.to_bytes;
+// see low_hamming_weight.h.
+py::list LowHammingWeightBatchBinding(const std::vector<std::string>& moduli,
+                                      int64_t cutoff, int64_t maxsteps,
+                                      int num_threads) {
+  std::vector<LowHammingWeightResult> res;
+  {
+    py::gil_scoped_release release;
+    res = LowHammingWeightBatch(moduli, cutoff, maxsteps, num_threads);
+  }
+  py::list results;
+  for (const LowHammingWeightResult& result : res) {
+    py::list factors;
+    for (const std::string& factor : result.factors) {
+      factors.append(py::bytes(factor));
+    }
+    results.append(py::make_tuple(result.weak, factors));
+  }
+  return results;
+}
+
+}  // namespace
+
+PYBIND11_MODULE(low_hamming_weight, m) {
+  m.def("LowHammingWeightBatch", LowHammingWeightBatchBinding);
+}
+
+}  // namespace paranoid_crypto::lib::cc_util::pybind
@@ -0,0 +1,66 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import random
+
+from absl.testing import absltest
+from paranoid_crypto.lib.cc_util.pybind import low_hamming_weight
+
+
+def _ToBytes(value: int) -> bytes:
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
+
+
+def _LowHammingWeightValue(bits: int, weight: int, rand: random.Random) -> int:
+  value = (1 << (bits - 1)) | 1
+  while bin(value).count("1") < weight:
+    value |= 1 << rand.randrange(1, bits - 1)
+  return value
+
+
+class LowHammingWeightTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/cc_util/low_hamming_weight_test.cc
+  The tests for the check using this engine are in
+    paranoid_crypto/lib/paranoid_rsa_test.py
+  """
+
+  def testFactorsLowHammingWeightProduct(self):
+    rand = random.Random(1)
+    p = _LowHammingWeightValue(256, 10, rand)
+    q = _LowHammingWeightValue(256, 10, rand)
+    results = low_hamming_weight.LowHammingWeightBatch([_ToBytes(p * q)],
+                                                       2500, 10**6, 0)
+    self.assertLen(results, 1)
+    weak, factors = results[0]
+    self.assertTrue(weak)
+    if factors:
+      f0 = int.from_bytes(factors[0], "little")
+      f1 = int.from_bytes(factors[1], "little")
+      self.assertEqual(p * q, f0 * f1)
+
+  def testPassesRandomProduct(self):
+    rand = random.Random(2)
+    n = rand.getrandbits(512) * rand.getrandbits(512)
+    results = low_hamming_weight.LowHammingWeightBatch([_ToBytes(n)], 2500,
+                                                       10**6, 0)
+    weak, factors = results[0]
+    self.assertFalse(weak)
+    self.assertEmpty(factors)
+
+
+if __name__ == "__main__":
+  absltest.main()
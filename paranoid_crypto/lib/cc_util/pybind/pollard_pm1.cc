@@ -0,0 +1,55 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/pollard_pm1.h"
+
+#include <string>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// The binding releases the GIL for the computation and builds the result
+// as a list of bytes explicitly, since letting pybind convert std::string
+// would produce str objects. Integers are unsigned little endian byte
+// strings as produced by int.to_bytes; see pollard_pm1.h.
+py::list Pollardpm1BatchBinding(const std::vector<std::string>& moduli,
+                                const std::string& m,
+                                const std::string& gcd_bound,
+                                int num_threads) {
+  std::vector<std::string> res;
+  {
+    py::gil_scoped_release release;
+    res = Pollardpm1Batch(moduli, m, gcd_bound, num_threads);
+  }
+  py::list result;
+  for (const std::string& value : res) {
+    result.append(py::bytes(value));
+  }
+  return result;
+}
+
+}  // namespace
+
+PYBIND11_MODULE(pollard_pm1, m) {
+  m.def("Pollardpm1Batch", Pollardpm1BatchBinding);
+}
+
+}  // namespace paranoid_crypto::lib::cc_util::pybind
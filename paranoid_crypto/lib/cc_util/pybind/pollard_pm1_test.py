@@ -0,0 +1,56 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.cc_util.pybind import pollard_pm1
+
+
+def _ToBytes(value: int) -> bytes:
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
+
+
+def _FromBytes(value: bytes) -> int:
+  return int.from_bytes(value, "little")
+
+
+class PollardPm1Test(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/cc_util/pollard_pm1_test.cc
+  The tests for the python wrapper are in
+    paranoid_crypto/lib/rsa_util_test.py
+  """
+
+  def testPollardpm1Batch(self):
+    n = 23 * 47
+    moduli = [_ToBytes(n)] * 3
+    ms = [2 * 3 * 5 * 7 * 11, 2 * 3 * 5 * 7 * 11 * 23, 2 * 3 * 5 * 7]
+    expected = [23, n, 1]
+    for m, gcd in zip(ms, expected):
+      results = pollard_pm1.Pollardpm1Batch(moduli, _ToBytes(m), _ToBytes(1),
+                                            0)
+      self.assertLen(results, 3)
+      for res in results:
+        self.assertEqual(gcd, _FromBytes(res))
+
+  def testGcdFilter(self):
+    results = pollard_pm1.Pollardpm1Batch([_ToBytes(23 * 47)],
+                                          _ToBytes(2 * 3 * 5 * 7 * 11 * 23),
+                                          _ToBytes(2**60), 1)
+    self.assertEqual([0], [_FromBytes(res) for res in results])
+
+
+if __name__ == "__main__":
+  absltest.main()
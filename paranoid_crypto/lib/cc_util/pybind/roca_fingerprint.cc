@@ -0,0 +1,46 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/roca_fingerprint.h"
+
+#include <string>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// The moduli are unsigned little endian byte strings as produced by
+// int.to_bytes. Returns one mask per modulus; the bits are
+// ROCA_FINGERPRINT and ROCA_VARIANT_RESIDUES below.
+std::vector<uint8_t> RocaFingerprintBatchBinding(
+    const std::vector<std::string>& moduli, int num_threads) {
+  py::gil_scoped_release release;
+  return RocaFingerprintBatch(moduli, num_threads);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(roca_fingerprint, m) {
+  m.attr("ROCA_FINGERPRINT") = py::int_(kRocaFingerprint);
+  m.attr("ROCA_VARIANT_RESIDUES") = py::int_(kRocaVariantResidues);
+  m.def("RocaFingerprintBatch", RocaFingerprintBatchBinding);
+}
+
+}  // namespace paranoid_crypto::lib::cc_util::pybind
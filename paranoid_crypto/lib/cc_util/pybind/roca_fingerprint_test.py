@@ -0,0 +1,56 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib import roca
+from paranoid_crypto.lib.cc_util.pybind import roca_fingerprint
+
+
+def _ToBytes(value: int) -> bytes:
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
+
+
+class RocaFingerprintTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/cc_util/roca_fingerprint_test.cc
+  """
+
+  def testCompareWithPython(self):
+    detector = roca.ROCAKeyDetector()
+    variant_detector = roca.ROCAKeyVariantDetector()
+    # Constructs a modulus matching the ROCA fingerprint: a power of 65537
+    # modulo every small prime.
+    product = detector.product_of_primes
+    for p in variant_detector.PRIMES:
+      if p > 173:
+        product *= p
+    roca_modulus = pow(65537, 17, product)
+    moduli = [roca_modulus, 3 * 5 * 7, 2**2047 + 981]
+    masks = roca_fingerprint.RocaFingerprintBatch(
+        [_ToBytes(n) for n in moduli], 0)
+    self.assertLen(masks, 3)
+    for n, mask in zip(moduli, masks):
+      self.assertEqual(detector.IsWeak(n),
+                       bool(mask & roca_fingerprint.ROCA_FINGERPRINT))
+      self.assertEqual(variant_detector.IsWeak(n),
+                       mask == roca_fingerprint.ROCA_VARIANT_RESIDUES)
+
+  def testEmptyBatch(self):
+    self.assertEqual([], roca_fingerprint.RocaFingerprintBatch([], 0))
+
+
+if __name__ == "__main__":
+  absltest.main()
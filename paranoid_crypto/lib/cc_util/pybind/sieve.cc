@@ -0,0 +1,69 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/sieve.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "pybind11/numpy.h"
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// The primes are returned as a numpy uint64 array: a prime table up to
+// 2^30 has tens of millions of entries, and 8 bytes per prime beats a
+// list of Python integers by an order of magnitude.
+py::array_t<uint64_t> SievePrimesBinding(uint64_t bound) {
+  std::vector<uint64_t> primes;
+  {
+    py::gil_scoped_release release;
+    primes = SievePrimes(bound);
+  }
+  py::array_t<uint64_t> result(primes.size());
+  std::memcpy(result.mutable_data(), primes.data(),
+              primes.size() * sizeof(uint64_t));
+  return result;
+}
+
+// As in the batch_gcd binding, the values and results are unsigned little
+// endian byte strings and the result is built as a list of bytes.
+py::list SmallPrimeFactorsBatchBinding(const std::vector<std::string>& values,
+                                       uint64_t bound, int num_threads) {
+  std::vector<std::string> factors;
+  {
+    py::gil_scoped_release release;
+    factors = SmallPrimeFactorsBatch(values, bound, num_threads);
+  }
+  py::list result;
+  for (const std::string& f : factors) {
+    result.append(py::bytes(f));
+  }
+  return result;
+}
+
+}  // namespace
+
+PYBIND11_MODULE(sieve, m) {
+  m.def("SievePrimes", SievePrimesBinding);
+  m.def("SmallPrimeFactorsBatch", SmallPrimeFactorsBatchBinding);
+}
+
+}  // namespace paranoid_crypto::lib::cc_util::pybind
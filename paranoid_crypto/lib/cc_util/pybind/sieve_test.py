@@ -0,0 +1,47 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.cc_util.pybind import sieve
+
+
+class SieveTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/cc_util/sieve_test.cc
+  The tests comparing with the python implementation are in
+    paranoid_crypto/lib/ntheory_util_test.py
+  """
+
+  def testSievePrimes(self):
+    primes = sieve.SievePrimes(30)
+    self.assertEqual("uint64", str(primes.dtype))
+    self.assertEqual([2, 3, 5, 7, 11, 13, 17, 19, 23, 29], primes.tolist())
+    self.assertEmpty(sieve.SievePrimes(2))
+
+  def testSmallPrimeFactorsBatch(self):
+    values = [15, 21, 22, 17]
+    value_bytes = [v.to_bytes(1, "little") for v in values]
+    factors = sieve.SmallPrimeFactorsBatch(value_bytes, 10, 0)
+    self.assertEqual([15, 21, 2, 1],
+                     [int.from_bytes(f, "little") for f in factors])
+
+  def testInconsistentParameters(self):
+    self.assertEqual([], sieve.SmallPrimeFactorsBatch([], 100, 0))
+    self.assertEqual([], sieve.SmallPrimeFactorsBatch([b"\x00"], 100, 0))
+
+
+if __name__ == "__main__":
+  absltest.main()
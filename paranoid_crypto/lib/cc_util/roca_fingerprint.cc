@@ -0,0 +1,127 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/roca_fingerprint.h"
+
+#include <gmpxx.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "paranoid_crypto/lib/cc_util/parallel.h"
+
+namespace paranoid_crypto::lib::cc_util {
+
+namespace {
+
+// The primes of roca.ROCAKeyDetector.PRIMES.
+constexpr uint32_t kRocaPrimes[] = {
+    3,   5,   7,   11,  13,  17,  19,  23,  29,  31,  37,  41,  43,
+    47,  53,  59,  61,  67,  71,  73,  79,  83,  89,  97,  101, 103,
+    107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173};
+
+// The primes of roca.ROCAKeyVariantDetector.PRIMES.
+constexpr uint32_t kVariantPrimes[] = {
+    5,   7,   11,  13,  17,  19,  23,  29,  31,  37,  41,  43,
+    47,  53,  59,  61,  67,  71,  73,  79,  83,  89,  97,  101,
+    103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163,
+    167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227, 229};
+
+constexpr uint32_t kF4 = 0x10001;
+
+// The residue tables and the product of all the small primes. Each table
+// is a bitset with one bit per residue (std::vector<bool> is bit packed).
+struct Tables {
+  // powers[i][v] is set if v is a power of 65537 modulo kRocaPrimes[i].
+  std::vector<std::vector<bool>> powers;
+  // residues[i][v] is set if v is a quadratic residue modulo
+  // kVariantPrimes[i].
+  std::vector<std::vector<bool>> residues;
+  // The product of the primes of both lists (they differ only in 3, 179,
+  // .., 229), used to shorten the moduli before the per prime reductions.
+  mpz_class prime_product;
+};
+
+const Tables& GetTables() {
+  static const Tables* tables = []() {
+    Tables* t = new Tables;
+    for (uint32_t p : kRocaPrimes) {
+      std::vector<bool> is_power(p, false);
+      uint32_t acc = 1;
+      do {
+        is_power[acc] = true;
+        acc = static_cast<uint64_t>(acc) * (kF4 % p) % p;
+      } while (acc != 1);
+      t->powers.push_back(std::move(is_power));
+    }
+    for (uint32_t p : kVariantPrimes) {
+      std::vector<bool> is_residue(p, false);
+      for (uint32_t i = 0; i < p; i++) {
+        is_residue[static_cast<uint64_t>(i) * i % p] = true;
+      }
+      t->residues.push_back(std::move(is_residue));
+    }
+    t->prime_product = 3;
+    for (uint32_t p : kVariantPrimes) {
+      t->prime_product *= p;
+    }
+    return t;
+  }();
+  return *tables;
+}
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  return value;
+}
+
+uint8_t Fingerprint(const mpz_class& modulus, const Tables& tables) {
+  // One bignum reduction; the short remainder is then reduced per prime
+  // with word arithmetic.
+  mpz_class rem = modulus % tables.prime_product;
+  uint8_t mask = kRocaFingerprint | kRocaVariantResidues;
+  for (size_t i = 0; i < std::size(kRocaPrimes); i++) {
+    uint32_t r = mpz_fdiv_ui(rem.get_mpz_t(), kRocaPrimes[i]);
+    if (!tables.powers[i][r]) {
+      mask &= ~kRocaFingerprint;
+      break;
+    }
+  }
+  for (size_t i = 0; i < std::size(kVariantPrimes); i++) {
+    uint32_t r = mpz_fdiv_ui(rem.get_mpz_t(), kVariantPrimes[i]);
+    if (!tables.residues[i][r]) {
+      mask &= ~kRocaVariantResidues;
+      break;
+    }
+  }
+  return mask;
+}
+
+}  // namespace
+
+std::vector<uint8_t> RocaFingerprintBatch(
+    const std::vector<std::string>& moduli, int num_threads) {
+  const int n = moduli.size();
+  const Tables& tables = GetTables();
+  std::vector<uint8_t> masks(n);
+  ParallelFor(n, num_threads, [&](int i) {
+    masks[i] = Fingerprint(FromBytes(moduli[i]), tables);
+  });
+  return masks;
+}
+
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,50 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_ROCA_FINGERPRINT_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_ROCA_FINGERPRINT_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// Bits of the per modulus result of RocaFingerprintBatch.
+//
+// The modulus matches the ROCA fingerprint: modulo every prime of
+// roca.ROCAKeyDetector.PRIMES it is a power of 65537. This is the
+// condition of roca.ROCAKeyDetector.IsWeak.
+inline constexpr uint8_t kRocaFingerprint = 1;
+// The modulus is a quadratic residue modulo every prime of
+// roca.ROCAKeyVariantDetector.PRIMES. This is the residue condition of
+// roca.ROCAKeyVariantDetector.IsWeak, without the exclusion of moduli
+// that already match the ROCA fingerprint; callers combine the two bits.
+inline constexpr uint8_t kRocaVariantResidues = 2;
+
+// Tests a batch of RSA moduli against the ROCA fingerprints. The per prime
+// tables (the powers of 65537 and the quadratic residues, one packed
+// bitset per prime) are computed once per process. Each modulus is reduced
+// once modulo the product of all the small primes and then modulo each
+// prime with word arithmetic, so the cost per modulus is a single bignum
+// reduction. The moduli are distributed over num_threads worker threads
+// (the number of hardware threads if num_threads <= 0).
+//
+// Moduli are unsigned little endian byte strings as produced by
+// int.to_bytes. Returns one result byte per modulus with the bits above.
+std::vector<uint8_t> RocaFingerprintBatch(
+    const std::vector<std::string>& moduli, int num_threads);
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_ROCA_FINGERPRINT_H_
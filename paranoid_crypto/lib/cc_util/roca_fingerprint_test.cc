@@ -0,0 +1,153 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/roca_fingerprint.h"
+
+#include <gmpxx.h>
+
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::cc_util {
+namespace {
+
+constexpr uint32_t kRocaPrimes[] = {
+    3,   5,   7,   11,  13,  17,  19,  23,  29,  31,  37,  41,  43,
+    47,  53,  59,  61,  67,  71,  73,  79,  83,  89,  97,  101, 103,
+    107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173};
+
+constexpr uint32_t kVariantPrimes[] = {
+    5,   7,   11,  13,  17,  19,  23,  29,  31,  37,  41,  43,
+    47,  53,  59,  61,  67,  71,  73,  79,  83,  89,  97,  101,
+    103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163,
+    167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227, 229};
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, -1, 1, 0, 0, value.get_mpz_t());
+  bytes.resize(count > 0 ? count : 1);
+  return bytes;
+}
+
+// The per value reference, following roca.py step by step.
+bool RefHasDiscreteLog(uint32_t value, uint32_t p) {
+  uint64_t acc = 1;
+  for (uint32_t e = 1; e < p; e++) {
+    if (acc == value) {
+      return true;
+    }
+    acc = acc * (0x10001 % p) % p;
+  }
+  return false;
+}
+
+uint8_t RefFingerprint(const mpz_class& modulus) {
+  uint8_t mask = kRocaFingerprint | kRocaVariantResidues;
+  for (uint32_t p : kRocaPrimes) {
+    if (!RefHasDiscreteLog(mpz_fdiv_ui(modulus.get_mpz_t(), p), p)) {
+      mask &= ~kRocaFingerprint;
+      break;
+    }
+  }
+  for (uint32_t p : kVariantPrimes) {
+    uint32_t r = mpz_fdiv_ui(modulus.get_mpz_t(), p);
+    bool is_residue = false;
+    for (uint32_t i = 0; i < p && !is_residue; i++) {
+      is_residue = static_cast<uint64_t>(i) * i % p == r;
+    }
+    if (!is_residue) {
+      mask &= ~kRocaVariantResidues;
+      break;
+    }
+  }
+  return mask;
+}
+
+// A modulus matching the ROCA fingerprint: a power of 65537 modulo every
+// small prime, constructed with the CRT.
+mpz_class RocaLikeModulus(int exponent) {
+  mpz_class result = 0;
+  mpz_class product = 1;
+  for (uint32_t p : kRocaPrimes) {
+    product *= p;
+  }
+  for (uint32_t p : kVariantPrimes) {
+    if (p > 173) {
+      product *= p;
+    }
+  }
+  for (uint32_t p : kRocaPrimes) {
+    uint64_t target = 1;
+    for (int e = 0; e < exponent; e++) {
+      target = target * (0x10001 % p) % p;
+    }
+    mpz_class m = product / p;
+    mpz_class inv;
+    mpz_invert(inv.get_mpz_t(), m.get_mpz_t(), mpz_class(p).get_mpz_t());
+    result += mpz_class(static_cast<unsigned long>(target)) * m * inv;
+  }
+  // The primes above 173 are left unconstrained (residue 0).
+  return result % product;
+}
+
+TEST(RocaFingerprintTest, CompareWithRef) {
+  gmp_randclass rand(gmp_randinit_default);
+  rand.seed(4567);
+  std::vector<std::string> moduli;
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 500; i++) {
+    mpz_class m = rand.get_z_bits(64 + 16 * (i % 120));
+    moduli.push_back(ToBytes(m));
+    expected.push_back(RefFingerprint(m));
+  }
+  for (int num_threads : {1, 4, 0}) {
+    EXPECT_EQ(RocaFingerprintBatch(moduli, num_threads), expected);
+  }
+}
+
+TEST(RocaFingerprintTest, DetectsRocaModulus) {
+  for (int exponent : {1, 2, 17, 1000}) {
+    mpz_class m = RocaLikeModulus(exponent);
+    std::vector<uint8_t> masks = RocaFingerprintBatch({ToBytes(m)}, 1);
+    ASSERT_EQ(masks.size(), 1);
+    EXPECT_EQ(masks[0] & kRocaFingerprint, kRocaFingerprint)
+        << "exponent:" << exponent;
+    EXPECT_EQ(masks[0], RefFingerprint(m));
+  }
+}
+
+TEST(RocaFingerprintTest, RandomModuliAreClean) {
+  // The false positive rates are about 2^-108 for the fingerprint and
+  // 2^-48 for the residues, so random moduli must not match.
+  gmp_randclass rand(gmp_randinit_default);
+  rand.seed(89);
+  std::vector<std::string> moduli;
+  for (int i = 0; i < 100; i++) {
+    moduli.push_back(ToBytes(rand.get_z_bits(2048)));
+  }
+  std::vector<uint8_t> masks = RocaFingerprintBatch(moduli, 0);
+  for (uint8_t mask : masks) {
+    EXPECT_EQ(mask, 0);
+  }
+}
+
+TEST(RocaFingerprintTest, EmptyBatch) {
+  EXPECT_TRUE(RocaFingerprintBatch({}, 1).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,213 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/sieve.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+namespace {
+
+// The number of odd values per sieve segment. One segment needs
+// kSegmentBits / 8 = 256 KiB, which fits in a typical L2 cache.
+constexpr uint64_t kSegmentBits = 1 << 21;
+
+// The number of primes that are multiplied into one primorial chunk of
+// SmallPrimeFactorsBatch. A chunk of 2^16 primes stays a few hundred
+// kilobytes, so several reductions can run in parallel without memory
+// pressure.
+constexpr size_t kChunkPrimes = 1 << 16;
+
+uint64_t ISqrt(uint64_t n) {
+  uint64_t r = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+  // Keeps r * r and (r + 1) * (r + 1) below 2^64.
+  r = std::min(r, uint64_t{0xFFFFFFFE});
+  while (r > 0 && r * r > n) {
+    r--;
+  }
+  while ((r + 1) * (r + 1) <= n) {
+    r++;
+  }
+  return r;
+}
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, /*order=*/-1, /*size=*/1, /*endian=*/0,
+             /*nails=*/0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+// Computes the product of primes[first .. first + count) with a pairwise
+// product tree, as ntheory_util.FastProduct.
+mpz_class PrimorialChunk(const std::vector<uint64_t>& primes, size_t first,
+                         size_t count) {
+  std::vector<mpz_class> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = mpz_class(static_cast<unsigned long>(primes[first + i]));
+  }
+  while (values.size() > 1) {
+    size_t half = values.size() / 2;
+    for (size_t i = 0; i < half; i++) {
+      values[i] = values[2 * i] * values[2 * i + 1];
+    }
+    if (values.size() % 2 == 1) {
+      values[half] = std::move(values.back());
+      half++;
+    }
+    values.resize(half);
+  }
+  return values[0];
+}
+
+}  // namespace
+
+std::vector<uint64_t> SievePrimes(uint64_t bound) {
+  std::vector<uint64_t> primes;
+  if (bound <= 2) {
+    return primes;
+  }
+  if (bound > 3) {
+    // Leaves room so that the result can grow without reallocating much.
+    double b = static_cast<double>(bound);
+    primes.reserve(static_cast<size_t>(b / (std::log(b) - 1.1)) + 16);
+  }
+  primes.push_back(2);
+  // The base sieve: odd primes up to sqrt(bound), with index i
+  // representing the odd number 2 * i + 3.
+  uint64_t root = ISqrt(bound - 1);
+  std::vector<uint64_t> base;
+  if (root >= 3) {
+    size_t num = (root - 1) / 2;
+    std::vector<bool> composite(num, false);
+    for (size_t i = 0; i < num; i++) {
+      if (!composite[i]) {
+        uint64_t p = 2 * i + 3;
+        base.push_back(p);
+        for (uint64_t j = (p * p - 3) / 2; j < num; j += p) {
+          composite[j] = true;
+        }
+      }
+    }
+  }
+  // The segmented sieve: each segment covers the kSegmentBits odd numbers
+  // low, low + 2, .. and keeps one bit per number.
+  std::vector<uint64_t> segment(kSegmentBits / 64);
+  for (uint64_t low = 3; low < bound; low += 2 * kSegmentBits) {
+    uint64_t high = std::min(bound, low + 2 * kSegmentBits);
+    std::fill(segment.begin(), segment.end(), 0);
+    for (uint64_t p : base) {
+      if (p * p >= high) {
+        break;
+      }
+      // The first odd multiple of p in the segment that is >= p * p.
+      uint64_t start = p * p;
+      if (start < low) {
+        start = (low + p - 1) / p * p;
+        if (start % 2 == 0) {
+          start += p;
+        }
+      }
+      for (uint64_t v = start; v < high; v += 2 * p) {
+        uint64_t idx = (v - low) / 2;
+        segment[idx / 64] |= uint64_t{1} << (idx % 64);
+      }
+    }
+    uint64_t count = (high - low + 1) / 2;
+    for (uint64_t idx = 0; idx < count; idx++) {
+      if (((segment[idx / 64] >> (idx % 64)) & 1) == 0) {
+        primes.push_back(low + 2 * idx);
+      }
+    }
+  }
+  return primes;
+}
+
+std::vector<std::string> SmallPrimeFactorsBatch(
+    const std::vector<std::string>& values, uint64_t bound, int num_threads) {
+  const int n = values.size();
+  if (n == 0) {
+    return {};
+  }
+  std::vector<mpz_class> vals(n);
+  for (int i = 0; i < n; i++) {
+    vals[i] = FromBytes(values[i]);
+    if (vals[i] == 0) {
+      // Every prime divides zero, so there is no meaningful answer.
+      return {};
+    }
+  }
+  if (num_threads <= 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  num_threads = std::max(1, std::min(num_threads, n));
+  std::vector<uint64_t> primes = SievePrimes(bound);
+  std::vector<mpz_class> factors(n, mpz_class(1));
+  for (size_t first = 0; first < primes.size(); first += kChunkPrimes) {
+    size_t count = std::min(kChunkPrimes, primes.size() - first);
+    mpz_class chunk = PrimorialChunk(primes, first, count);
+    // gcd(v, chunk % v) == gcd(v, chunk) is the product of the distinct
+    // chunk primes dividing v. Every prime is in exactly one chunk, so the
+    // per chunk gcds multiply to the product over all primes below bound.
+    std::atomic<int> next_value{0};
+    auto worker = [&]() {
+      mpz_class rem, gcd;
+      while (true) {
+        int i = next_value.fetch_add(1);
+        if (i >= n) {
+          return;
+        }
+        rem = chunk % vals[i];
+        mpz_gcd(gcd.get_mpz_t(), vals[i].get_mpz_t(), rem.get_mpz_t());
+        if (gcd != 1) {
+          factors[i] *= gcd;
+        }
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; i++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : threads) {
+      t.join();
+    }
+  }
+  std::vector<std::string> result(n);
+  for (int i = 0; i < n; i++) {
+    result[i] = ToBytes(factors[i]);
+  }
+  return result;
+}
+
+}  // namespace paranoid_crypto::lib::cc_util
@@ -0,0 +1,44 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_CC_UTIL_SIEVE_H_
+#define PARANOID_CRYPTO_LIB_CC_UTIL_SIEVE_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::cc_util {
+
+// Returns all primes below bound, as ntheory_util.Sieve. The sieve only
+// keeps one bit per odd number and works in segments that fit in the L2
+// cache, so sieving large bounds is memory bound by the prime table alone.
+std::vector<uint64_t> SievePrimes(uint64_t bound);
+
+// Trial division of many values against the primes below bound in one
+// call. Element i of the result is the product of the distinct primes
+// below bound that divide values[i] (so 1 if values[i] has no small
+// factor). The primes are multiplied into chunk primorials and each value
+// is reduced once per chunk, so the cost per value is a few bignum
+// operations per chunk instead of one division per prime; the reductions
+// are distributed over num_threads worker threads (the number of hardware
+// threads if num_threads <= 0).
+//
+// Values and results are unsigned little endian byte strings as produced
+// by int.to_bytes. Returns an empty vector if a value is zero.
+std::vector<std::string> SmallPrimeFactorsBatch(
+    const std::vector<std::string>& values, uint64_t bound, int num_threads);
+
+}  // namespace paranoid_crypto::lib::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_CC_UTIL_SIEVE_H_
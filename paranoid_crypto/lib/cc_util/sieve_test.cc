@@ -0,0 +1,128 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/cc_util/sieve.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::cc_util {
+namespace {
+
+// The plain one bool per number sieve, as ntheory_util.Sieve.
+std::vector<uint64_t> RefSieve(uint64_t bound) {
+  std::vector<bool> composite(bound, false);
+  std::vector<uint64_t> primes;
+  for (uint64_t i = 2; i < bound; i++) {
+    if (!composite[i]) {
+      primes.push_back(i);
+      for (uint64_t j = i * i; j < bound; j += i) {
+        composite[j] = true;
+      }
+    }
+  }
+  return primes;
+}
+
+std::string ToBytes(uint64_t value) {
+  std::string bytes;
+  do {
+    bytes.push_back(static_cast<char>(value & 255));
+    value >>= 8;
+  } while (value);
+  return bytes;
+}
+
+uint64_t FromBytes(const std::string& bytes) {
+  uint64_t value = 0;
+  for (size_t i = bytes.size(); i > 0; i--) {
+    value = (value << 8) | static_cast<uint8_t>(bytes[i - 1]);
+  }
+  return value;
+}
+
+TEST(SieveTest, SmallBounds) {
+  EXPECT_TRUE(SievePrimes(0).empty());
+  EXPECT_TRUE(SievePrimes(1).empty());
+  EXPECT_TRUE(SievePrimes(2).empty());
+  EXPECT_EQ(SievePrimes(3), std::vector<uint64_t>({2}));
+  EXPECT_EQ(SievePrimes(4), std::vector<uint64_t>({2, 3}));
+  EXPECT_EQ(SievePrimes(5), std::vector<uint64_t>({2, 3}));
+  EXPECT_EQ(SievePrimes(30), std::vector<uint64_t>({2, 3, 5, 7, 11, 13, 17,
+                                                    19, 23, 29}));
+}
+
+TEST(SieveTest, CompareWithRef) {
+  for (uint64_t bound : {100, 101, 1000, 65536, 65537, 100000}) {
+    EXPECT_EQ(SievePrimes(bound), RefSieve(bound)) << "bound:" << bound;
+  }
+}
+
+TEST(SieveTest, CrossesSegments) {
+  // 10000019 is well past the first segment of 2^21 odd numbers.
+  std::vector<uint64_t> primes = SievePrimes(10000019);
+  EXPECT_EQ(primes.size(), 664579);
+  EXPECT_EQ(primes.back(), 9999991);
+  std::vector<uint64_t> more = SievePrimes(10000020);
+  EXPECT_EQ(more.size(), 664580);
+  EXPECT_EQ(more.back(), 10000019);
+}
+
+TEST(SieveTest, SmallPrimeFactorsBatch) {
+  // 15 = 3 * 5 and 21 = 3 * 7 are 10-smooth, 22 = 2 * 11 is not.
+  std::vector<std::string> factors = SmallPrimeFactorsBatch(
+      {ToBytes(15), ToBytes(21), ToBytes(22), ToBytes(17), ToBytes(1)}, 10, 1);
+  ASSERT_EQ(factors.size(), 5);
+  EXPECT_EQ(FromBytes(factors[0]), 15);
+  EXPECT_EQ(FromBytes(factors[1]), 21);
+  EXPECT_EQ(FromBytes(factors[2]), 2);
+  EXPECT_EQ(FromBytes(factors[3]), 1);
+  EXPECT_EQ(FromBytes(factors[4]), 1);
+}
+
+TEST(SieveTest, SmallPrimeFactorsBatchCompareWithRef) {
+  std::vector<std::string> values;
+  std::vector<uint64_t> raw;
+  for (uint64_t j = 1; j < 2000; j++) {
+    uint64_t v = (j * j * 56843) % 4294967291 + 1;
+    raw.push_back(v);
+    values.push_back(ToBytes(v));
+  }
+  for (int num_threads : {1, 4}) {
+    std::vector<std::string> factors =
+        SmallPrimeFactorsBatch(values, 1000, num_threads);
+    ASSERT_EQ(factors.size(), raw.size());
+    for (size_t i = 0; i < raw.size(); i++) {
+      uint64_t expected = 1;
+      for (uint64_t p : RefSieve(1000)) {
+        if (raw[i] % p == 0) {
+          expected *= p;
+        }
+      }
+      EXPECT_EQ(FromBytes(factors[i]), expected) << "i:" << i;
+    }
+  }
+}
+
+TEST(SieveTest, SmallPrimeFactorsBatchInconsistent) {
+  EXPECT_TRUE(SmallPrimeFactorsBatch({}, 100, 1).empty());
+  EXPECT_TRUE(
+      SmallPrimeFactorsBatch({std::string(1, '\0')}, 100, 1).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::cc_util
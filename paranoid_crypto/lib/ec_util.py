@@ -47,6 +47,7 @@ from typing import Optional, Union
 import gmpy2 as gmpy
 from paranoid_crypto import paranoid_pb2
 from paranoid_crypto.lib import util
+from paranoid_crypto.lib.cc_util.pybind import ec_arith
 
 # The point at infinity when using affine coordinates.
 INFINITY = (None, None)
@@ -63,6 +64,48 @@ EcPoint = Union[tuple[int, int], tuple[None, None]]
 EcPointJacobian = tuple[int, int, int]
 
 
+def _EncodeInt(value: int) -> bytes:
+  """Encodes a non-negative integer for cc_util.ec_arith."""
+  value = int(value)
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
+
+
+def _EncodePoints(points: list[EcPoint]) -> list[bytes]:
+  """Encodes affine points as the flat lists used by cc_util.ec_arith.
+
+  The kernel represents a list of points as a flat list of coordinates
+  [x0, y0, x1, y1, ...], where the point at infinity has two empty
+  coordinates.
+
+  Args:
+    points: a list of points
+
+  Returns:
+    the flat list of encoded coordinates
+  """
+  flat = []
+  for x, y in points:
+    if x is None:
+      flat.append(b"")
+      flat.append(b"")
+    else:
+      flat.append(_EncodeInt(x))
+      flat.append(_EncodeInt(y))
+  return flat
+
+
+def _DecodePoints(flat: list[bytes]) -> list[EcPoint]:
+  """Decodes a flat list of coordinates from cc_util.ec_arith."""
+  res = []
+  for i in range(0, len(flat), 2):
+    if flat[i]:
+      res.append((gmpy.mpz(int.from_bytes(flat[i], "little")),
+                  gmpy.mpz(int.from_bytes(flat[i + 1], "little"))))
+    else:
+      res.append(INFINITY)
+  return res
+
+
 class EcCurve:
   """An elliptic curve over a prime field in Weierstrass form."""
 
@@ -96,15 +139,13 @@ class EcCurve:
     self.n = gmpy.mpz(n)
     self.name = name
     self.h = h
-    # A cache that stores results of the form:
-    #   self._cache[k] = self.Multiply(self.g, k)
-    # These results are used for batch multiplications.
-    self._cache = {}
-
-    # A lookup table for the x-coordinate of the points self.g*i for
-    # i < self._table_size.
-    self._table = {}
-    self._table_size = 0
+    # The batch methods are delegated to the native kernel in
+    # cc_util.ec_arith, which also keeps a cache of generator multiples for
+    # the batch multiplications.
+    self._native = ec_arith.EcGroup(
+        _EncodeInt(self.mod), _EncodeInt(self.a % self.mod),
+        _EncodeInt(self.b % self.mod), _EncodeInt(self.g[0]),
+        _EncodeInt(self.g[1]), _EncodeInt(self.n))
 
   def OnCurve(self, p: EcPoint) -> bool:
     """Checks whether the point p is on the curve.
@@ -445,22 +486,13 @@ class EcCurve:
       ArithmeticError: if an internal invariant failed.
     """
     mod = self.mod
-    res = [None] * len(values)
-    product = 1
-    for i, v in enumerate(values):
-      if v:
-        res[i] = product
-        product = product * v % mod
-    inverse = gmpy.invert(product, mod)
-    for i in range(len(values) - 1, -1, -1):
-      v = values[i]
-      if v:
-        res[i] = res[i] * inverse % mod
-        inverse = inverse * v % mod
-    # a simple self check
-    if inverse != 1:
+    encoded = [_EncodeInt(v % mod) if v else b"" for v in values]
+    res = self._native.BatchInverse(encoded)
+    if len(res) != len(values):
       raise ArithmeticError("failed invariant")
-    return res
+    return [
+        gmpy.mpz(int.from_bytes(r, "little")) if r else None for r in res
+    ]
 
   def BatchAddList(
       self, p_list: list[EcPoint], q_list: list[EcPoint]
@@ -477,29 +509,15 @@ class EcCurve:
 
     Raises:
       ValueError: if the p_list and q_list are of the same size.
+      ArithmeticError: if an internal invariant failed.
     """
     if len(p_list) != len(q_list):
       raise ValueError("length of inputs must be equal")
-    size = len(p_list)
-    tmp = [None] * size
-    for i in range(size):
-      p = p_list[i]
-      q = q_list[i]
-      if p != INFINITY and q != INFINITY:
-        tmp[i] = (p[0] - q[0]) % self.mod
-    tmp = self.BatchInverse(tmp)
-    res = [(None, None)] * size
-    for i, v in enumerate(tmp):
-      if v is None:
-        res[i] = self.Add(p_list[i], q_list[i])
-      else:
-        p = p_list[i]
-        q = q_list[i]
-        t = v * (p[1] - q[1]) % self.mod
-        x = (t * t - p[0] - q[0]) % self.mod
-        y = (t * (p[0] - x) - p[1]) % self.mod
-        res[i] = (x, y)
-    return res
+    flat = self._native.BatchAddList(
+        _EncodePoints(p_list), _EncodePoints(q_list))
+    if len(flat) != 2 * len(p_list):
+      raise ArithmeticError("failed invariant")
+    return _DecodePoints(flat)
 
   def BatchDouble(self, p_list: list[EcPoint]) -> list[EcPoint]:
     """Doubles all points in a list.
@@ -509,25 +527,14 @@ class EcCurve:
 
     Returns:
         The result is the same as [self.Double(p) for p in p_list].
+
+    Raises:
+      ArithmeticError: if an internal invariant failed.
     """
-    size = len(p_list)
-    tmp = [None] * size
-    for i, p in enumerate(p_list):
-      if p != INFINITY:
-        tmp[i] = 2 * p[1]
-    tmp = self.BatchInverse(tmp)
-    res = [(None, None)] * size
-    for i, p in enumerate(p_list):
-      if tmp[i] is None:
-        res[i] = self.Double(p)
-      else:
-        x, y = p
-        num = (3 * x * x + self.a) % self.mod
-        t = num * tmp[i] % self.mod
-        x2 = (t * t - 2 * x) % self.mod
-        y2 = (t * (x - x2) - y) % self.mod
-        res[i] = (x2, y2)
-    return res
+    flat = self._native.BatchDouble(_EncodePoints(p_list))
+    if len(flat) != 2 * len(p_list):
+      raise ArithmeticError("failed invariant")
+    return _DecodePoints(flat)
 
   def BatchAdd(self, p: EcPoint, points: list[EcPoint]) -> list[EcPoint]:
     """Computes the addition of a point and a list of points.
@@ -538,24 +545,17 @@ class EcCurve:
 
     Returns:
         The result is the same as [self.Add(p, q) for q in points].
+
+    Raises:
+      ArithmeticError: if an internal invariant failed.
     """
     if p == INFINITY:
       return points[:]
-    tmp = [None] * len(points)
-    for i, q in enumerate(points):
-      if q != INFINITY:
-        tmp[i] = (p[0] - q[0]) % self.mod
-    tmp = self.BatchInverse(tmp)
-    res = [(None, None)] * len(points)
-    for i, v in enumerate(tmp):
-      if v:
-        t = v * (p[1] - points[i][1]) % self.mod
-        x = (t * t - p[0] - points[i][0]) % self.mod
-        y = (t * (p[0] - x) - p[1]) % self.mod
-        res[i] = (x, y)
-      else:
-        res[i] = self.Add(p, points[i])
-    return res
+    flat = self._native.BatchAdd(
+        _EncodeInt(p[0]), _EncodeInt(p[1]), _EncodePoints(points))
+    if len(flat) != 2 * len(points):
+      raise ArithmeticError("failed invariant")
+    return _DecodePoints(flat)
 
   def BatchAddX(self, p: EcPoint, points: list[EcPoint]) -> list[Coordinate]:
     """Computes the X-coordinate of the sum of a point and a list of points.
@@ -638,28 +638,15 @@ class EcCurve:
 
     Returns:
       [self.Multiply(self.g, x) for x in scalars]
+
+    Raises:
+      ArithmeticError: if an internal invariant failed.
     """
-    scalars = [x % self.n for x in scalars]
-
-    # Number of bits processed in one step. This will require 2**window_size
-    # precomputed points.
-    window_size = 8
-    steps = (self.n.bit_length() + window_size - 1) // window_size
-    mask = sum(1 << j for j in range(0, self.n.bit_length(), steps))
-    size = len(scalars)
-    for i in range(steps - 1, -1, -1):
-      points = [(None, None)] * size
-      for j, s in enumerate(scalars):
-        multiplier = (s >> i) & mask
-        if multiplier not in self._cache:
-          self._cache[multiplier] = self.Multiply(self.g, multiplier)
-        points[j] = self._cache[multiplier]
-      if i == steps - 1:
-        res = points
-      else:
-        res = self.BatchDouble(res)
-        res = self.BatchAddList(res, points)
-    return res
+    encoded = [_EncodeInt(x % self.n) for x in scalars]
+    flat = self._native.BatchMultiplyG(encoded)
+    if len(flat) != 2 * len(scalars):
+      raise ArithmeticError("failed invariant")
+    return _DecodePoints(flat)
 
   def PointSequence(self, base: EcPoint, n: int) -> list[Optional[EcPoint]]:
     """Returns [self.Multiply(base, i) for i in range(n)].
@@ -723,38 +710,23 @@ class EcCurve:
     Returns:
        The result is a list that either contains the discrete logarithms
        or None if the DL could not be bound.
+
+    Raises:
+      ValueError: if the bound does not fit the native dlog engine.
     """
+    if not points:
+      return []
+    if n >= 2**62:
+      raise ValueError("bound is too large for the native dlog engine")
+    # The baby step table and the giant step walks are done by the native
+    # BSGS engine in cc_util.ec_arith; a table with a size not larger than
+    # an already built one reuses the existing table.
     table_size = int(math.sqrt(n * len(points)))
-    base = self.g
-    if table_size > self._table_size:
-      # TODO(pedroysb): An improvement would be to generate from
-      # self._table_size up to table_size.
-      self._table = self.PointTable(base, table_size)
-      self._table_size = table_size
-    # Computes the size of a giant step. This size can be about twice the size
-    # of the table above, since the coordinate x in a table represents both
-    # a point and its inverse.
-    t = 2 * table_size - 1
-    # The number of giant steps needs to be 2 larger than n // t, once to offset
-    # rounding and once to adjust for the fact that DL might be a difference
-    # between a giant step and a baby step.
-    giant_steps = 2 + n // t
-    list_c = self.PointSequence(self.Multiply(base, -t), giant_steps)
-    res = [None] * len(points)
-    for i, p in enumerate(points):
-      if p == INFINITY:
-        res[i] = 0
-        continue
-      for j, x in enumerate(self.BatchAddX(p, list_c)):
-        if x in self._table:
-          for dl in [j * t + self._table[x], j * t - self._table[x]]:
-            y = self.Multiply(base, dl)
-            if y[0] == p[0]:
-              if y[1] == p[1]:
-                res[i] = dl
-              elif y[1] == -p[1] % self.mod:
-                res[i] = -dl
-    return res
+    self._native.BuildDlogTable(table_size)
+    logs = self._native.BatchDl(_EncodePoints(points), n, 0)
+    return [
+        int(dl) if dl != ec_arith.DLOG_NOT_FOUND else None for dl in logs
+    ]
 
   def ExtendedBatchDL(self, points: list[EcPoint]) -> list[Optional[int]]:
     """Finds the DLs of points assuming the DLs have a special form.
@@ -847,26 +819,30 @@ class EcCurve:
     if not points or len(points) + len(other_points) < 2:
       return res
     base = self.g
-    if max_diff > self._table_size:
-      # TODO(pedroysb): An improvement would be to generate from
-      # self._table_size up to max_diff.
-      self._table = self.PointTable(base, max_diff)
-      self._table_size = max_diff
+    # Uses the baby step table of the native BSGS engine instead of a
+    # Python dict; the engine returns candidate baby steps for the
+    # x-coordinates, which are verified below since the fingerprints of
+    # the table can have false positives. Duplicated keys have no
+    # x-coordinate (the difference is the point at infinity) and are
+    # skipped by the engine.
+    self._native.BuildDlogTable(max_diff)
     negated = [self.Negate(q) for q in other_points]
     for i, p in enumerate(points):
-      for j, x in enumerate(self.BatchAddX(p, negated)):
-        if x is None:
-          continue  # key is a duplicate
-        if x in self._table:
-          q = self.Negate(negated[j])
-          diff = self.Subtract(p, q)
-          for dl in (self._table[x], -self._table[x]):
-            diff2 = self.Multiply(base, dl)
-            if diff == diff2:
-              res[i] = "key - (%x, %x) = %d * G" % (q[0], q[1], dl)
-              if j >= len(other_points):
-                key2 = j - len(other_points)
-                res[key2] = "key - (%x, %x) = %d * G" % (p[0], p[1], -dl)
+      xs = self.BatchAddX(p, negated)
+      pairs = self._native.DlogLookup(
+          [_EncodeInt(x) if x is not None else b"" for x in xs])
+      for k in range(0, len(pairs), 2):
+        j = int(pairs[k])
+        candidate = int(pairs[k + 1])
+        q = self.Negate(negated[j])
+        diff = self.Subtract(p, q)
+        for dl in (candidate, -candidate):
+          diff2 = self.Multiply(base, dl)
+          if diff == diff2:
+            res[i] = "key - (%x, %x) = %d * G" % (q[0], q[1], dl)
+            if j >= len(other_points):
+              key2 = j - len(other_points)
+              res[key2] = "key - (%x, %x) = %d * G" % (p[0], p[1], -dl)
       negated.append(self.Negate(p))
     return res
 
@@ -11,9 +11,33 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
-"""Wrapper around fpylll."""
+"""Wrapper around the native LLL engine in cc_util."""
 
-import fpylll
+from paranoid_crypto.lib.cc_util.pybind import lattice
+
+
+def _EncodeMatrix(matrix: list[list[int]]) -> list[list[bytes]]:
+  """Encodes entries as signed little endian byte strings.
+
+  The conversion to python integers is done to avoid potential problems,
+  when the input uses different int implementations. (E.g. using sagemath
+  had previously lead to problems).
+
+  Args:
+    matrix: the integer matrix to encode
+
+  Returns:
+    the matrix with each entry encoded as bytes
+  """
+  return [[
+      int(v).to_bytes((int(v).bit_length() + 8) // 8, "little", signed=True)
+      for v in row
+  ] for row in matrix]
+
+
+def _DecodeMatrix(matrix: list[list[bytes]]) -> list[list[int]]:
+  return [[int.from_bytes(v, "little", signed=True) for v in row]
+          for row in matrix]
 
 
 def reduce(matrix: list[list[int]]) -> list[list[int]]:
@@ -28,13 +52,27 @@ def reduce(matrix: list[list[int]]) -> list[list[int]]:
     the reduce basis. Typically the first row of the result is one of the
     shortest vectors in the lattice
   """
-  # Convert the input to python integers if necessary.
-  # This is done to avoid potential problems, when the underlying library uses
-  # different int implementations. (E.g. using sagemath instead of fpylll had
-  # previously lead to problems).
-  tmp = [[int(v) for v in row] for row in matrix]
-  m = fpylll.IntegerMatrix.from_matrix(tmp)
-  reduced = fpylll.LLL.reduction(m)
-  res = [[0] * reduced.ncols for _ in range(reduced.nrows)]
-  reduced.to_matrix(res)
-  return res
+  return _DecodeMatrix(lattice.LllReduce(_EncodeMatrix(matrix)))
+
+
+def reduce_batch(matrices: list[list[list[int]]],
+                 num_threads: int = 0) -> list[list[list[int]]]:
+  """Reduces a batch of independent lattices in parallel.
+
+  Checks such as the ECDSA checks build one small lattice per key or per
+  window of signatures; reducing them on multiple cores is much faster
+  than calling reduce in a loop.
+
+  Args:
+    matrices: the integer lattices to reduce
+    num_threads: the number of threads to use. num_threads <= 0 uses the
+      number of cores.
+
+  Returns:
+    the reduced bases, in the order of the input
+  """
+  encoded = [_EncodeMatrix(matrix) for matrix in matrices]
+  return [
+      _DecodeMatrix(matrix)
+      for matrix in lattice.LllReduceBatch(encoded, num_threads)
+  ]
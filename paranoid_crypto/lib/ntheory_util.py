@@ -16,6 +16,8 @@
 import itertools
 from typing import Optional
 import gmpy2 as gmpy
+import numpy
+from paranoid_crypto.lib.cc_util.pybind import sieve as cc_sieve
 
 
 def FastProduct(values: list[int]) -> int:
@@ -202,9 +204,17 @@ def DivmodRounded(a: int, b: int) -> tuple[int, int]:
 
 def Sieve(n: int) -> list[int]:
   """Using Sieve of Eratosthenes, returns all primes lower than n."""
-  table = [True] * n
-  for i in range(2, gmpy.isqrt(n) + 1):
-    if table[i]:
-      for j in range(i * i, n, i):
-        table[j] = False
-  return [i for i, v in enumerate(table) if v][2:]
+  return SieveArray(n).tolist()
+
+
+def SieveArray(n: int) -> numpy.ndarray:
+  """Returns all primes lower than n as a numpy uint64 array.
+
+  The sieve itself runs in cc_util.sieve. Unlike Sieve, the primes are not
+  converted into Python integers, which matters for the large bounds used
+  by deep scans: the array needs 8 bytes per prime.
+
+  Args:
+    n: the exclusive upper bound for the primes.
+  """
+  return cc_sieve.SievePrimes(n)
@@ -41,6 +41,80 @@ def LinearComplexity(s: int, length: int) -> int:
   return berlekamp_massey.LfsrLength(ba, length)
 
 
+def LinearComplexityBatch(blocks: list[int],
+                          length: int,
+                          num_threads: int = 1) -> list[int]:
+  """Computes the linear complexity of a list of equally sized sequences.
+
+  This function computes the same result as calling LinearComplexity for
+  each block individually. All blocks are passed to the C++ implementation
+  in a single call, which avoids the overhead of one Python to C++
+  transition and several temporary buffers per block. The NIST
+  LinearComplexity test splits its input into hundreds or thousands of
+  short blocks, where this overhead dominates the actual computation.
+
+  The bindings release the GIL, so multiple Python threads can run
+  independent computations concurrently. Alternatively a single call can
+  fan the blocks out over a C++ thread pool with num_threads.
+
+  Args:
+    blocks: a list of bit-sequences, each represented as an integer as in
+      LinearComplexity.
+    length: the length of each bit sequence in blocks.
+    num_threads: the number of C++ worker threads to use. 1 computes the
+      blocks sequentially, 0 uses one thread per available core.
+
+  Returns:
+    a list containing the length of the shortest LFSR for each block.
+  """
+  size = (length + 7) // 8
+  if not 0 < size < 2**31:
+    raise ValueError("Size out of range")
+  buffer = b"".join(b.to_bytes(size, "little") for b in blocks)
+  if num_threads == 1:
+    lengths = berlekamp_massey.LfsrLengthBatch(buffer, length, len(blocks))
+  else:
+    lengths = berlekamp_massey.LfsrLengthBatchParallel(buffer, length,
+                                                       len(blocks), num_threads)
+  if len(lengths) != len(blocks):
+    raise ValueError("Inconsistent parameters")
+  return lengths
+
+
+def LinearComplexityProfile(s: int,
+                            length: int,
+                            stride: int = 1) -> list[int]:
+  """Computes the linear complexity of every prefix of a sequence.
+
+  Entry k of the result is the linear complexity of the prefix consisting
+  of the first (k + 1) * stride bits of s, so with stride 1 the result is
+  the full linear complexity profile. The profile is computed in a single
+  pass: the Berlekamp-Massey algorithm visits every prefix anyway, so this
+  is asymptotically as fast as a single LinearComplexity call. Calling
+  LinearComplexity once per prefix instead would cost another factor of
+  length.
+
+  Args:
+    s: the bit-sequence s_0, s_1, ... s_length-1 represented as s = sum(2 ** i *
+      s_i for i = 0 .. length-1).
+    length: the length of the bit sequence.
+    stride: record the linear complexity after every stride-th bit.
+
+  Returns:
+    a list with length // stride entries as described above.
+  """
+  size = (length + 7) // 8
+  if not 0 <= size < 2**31:
+    raise ValueError("Size out of range")
+  if stride <= 0:
+    raise ValueError("Stride must be positive")
+  ba = s.to_bytes(size, "little")
+  profile = berlekamp_massey.LfsrProfile(ba, length, stride)
+  if len(profile) != length // stride:
+    raise ValueError("Inconsistent parameters")
+  return profile
+
+
 def LinearComplexityNative(s: int, length: int) -> int:
   """Native implementation of Berlekamp-Massey.
 
@@ -238,6 +238,26 @@ class BerlekampMasseyTest(absltest.TestCase):
     # The probability of this test failing is about 2^-40
     self.assertBetween(lfsr_len, size // 2 - 20, size // 2 + 20)
 
+  def testLinearComplexityBatch(self):
+    for length in (10, 129, 512):
+      blocks = [RandomBits(length) for _ in range(20)]
+      expected = [
+          berlekamp_massey.LinearComplexity(b, length) for b in blocks
+      ]
+      self.assertEqual(expected,
+                       berlekamp_massey.LinearComplexityBatch(blocks, length))
+
+  def testLinearComplexityProfile(self):
+    length = 300
+    s = RandomBits(length)
+    profile = berlekamp_massey.LinearComplexityProfile(s, length)
+    self.assertLen(profile, length)
+    for k in range(length):
+      self.assertEqual(
+          berlekamp_massey.LinearComplexity(s % 2**(k + 1), k + 1), profile[k])
+    strided = berlekamp_massey.LinearComplexityProfile(s, length, stride=7)
+    self.assertEqual(profile[6::7], strided)
+
   def testLfsrCount(self):
     for length in (9, 10):
       count = [0] * (length + 1)
@@ -14,180 +14,35 @@
 
 #include "paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey.h"
 
-#ifdef __x86_64__
-#ifdef __CLMUL__
-#include <emmintrin.h>  // SSE2
-#include <wmmintrin.h>  // clmul
-#include <xmmintrin.h>  // Datatype __mm128i
-#define USE_CLMUL
-#endif
-#endif
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
 
-#ifdef __aarch64__
-#ifdef __ARM_NEON
-#include <arm_neon.h>
-#define USE_CLMUL
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_PMULL
+#define HWCAP_PMULL (1 << 4)
 #endif
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace paranoid_crypto::lib::randomness_tests::cc_util {
 
-#ifdef USE_CLMUL
-#ifdef __x86_64__
-#define _mm_extract_epi64(x, imm) \
-  _mm_cvtsi128_si64(_mm_srli_si128((x), 8 * (imm)))
-
-inline void clmul(uint64_t x, uint64_t y, uint64_t *hi, uint64_t *lo) {
-  __m128i t0 = _mm_set_epi64x(0, x);
-  __m128i t1 = _mm_set_epi64x(0, y);
-  __m128i tmp = _mm_clmulepi64_si128(t0, t1, 0x00);
-  *hi = _mm_extract_epi64(tmp, 1);
-  *lo = _mm_extract_epi64(tmp, 0);
-}
-#endif
-#ifdef __aarch64__
-#ifdef __ARM_NEON
-inline void clmul(uint64_t x, uint64_t y, uint64_t *hi, uint64_t *lo) {
-  poly128_t t = vmull_p64(x, y);
-  *hi = static_cast<uint64_t>(t >> 64);
-  *lo = static_cast<uint64_t>(t);
-}
-#endif
-#endif
-
-// Implements the Berlekamp-Massey algorithm for binary sequences.
-//
-// The Berlekamp-Massey algorithm iteratively computes two shortest LFSRs
-// poly_b, poly_c for a subsequence of the input sequence seq. The algorithm
-// extends these polynomials to larger subsequences by computing a discrepancy.
-// The discrepancy can be derived from the product of the polynomials seq and
-// poly_c, by determining if the coefficient at a given position is 0 or not.
-//
-// The implementation here does not compute poly_b and poly_c. Instead it uses
-// two auxiliary variables sb and sc, which are truncated products of seq with
-// the polynomials poly_b and poly_c respectively. Computing sb and sc
-// incrementally can be done efficiently since doing so allows to use carry-less
-// multiplication.
-//
-// The main loop in this implementation works in steps of 64 bits.
-// Each step processes 64 bits of the input sequence. It computes polynomials
-// a, b, c, d, such that the shortest LFSRs after these 64 bits could be
-// computed from the shortest LFSRs before as:
-//   poly_b' = a * poly_b + b * poly_c
-//   poly_c' = c * poly_b + d * poly_c
-// This computation is of course not being performed, since there is no need
-// for poly_b and poly_c. Instead sb and sc are updated in a similar manner.
-//
-// The speedup from using carry-less multiplication is constant. The complexity
-// is still O(n^2) like typical implementations of Berlekamp-Massey. Faster
-// algorithms (e.g. by using Karatsuba multiplication) are possible.
-// Such implementations are much more complex and may not give a lot of
-// improvement for typical sequences of a few thousand bits.
-int LfsrLengthImpl(const std::vector<uint64_t> &seq, int n) {
-  std::vector<uint64_t> sb(seq);
-  std::vector<uint64_t> sc(seq);
-  std::vector<uint64_t> tb(seq.size(), 0);
-  std::vector<uint64_t> tc(seq.size(), 0);
-  int lfsr_len = 0;
-  int n0 = n - (n & 63);
-  int size = seq.size();
-  for (int j = 0; j < n0; j += 64) {
-    uint64_t sb0 = sb[0];
-    uint64_t sc0 = sc[0];
-    uint64_t a = 1;
-    uint64_t b = 0;
-    uint64_t c = 0;
-    uint64_t d = 1;
-    uint64_t carry_a = 0;
-    uint64_t carry_c = 0;
-    for (int i = 0; i < 64; i++) {
-      int disc = sc0 & 1;
-      sc0 >>= 1;
-      carry_a = a >> 63;
-      carry_c = 0;
-      a <<= 1;
-      b <<= 1;
-      if (disc == 1) {
-        if (2 * lfsr_len <= i + j) {
-          lfsr_len = (i + j) + 1 - lfsr_len;
-          std::swap(sb0, sc0);
-          std::swap(a, c);
-          std::swap(b, d);
-          std::swap(carry_a, carry_c);
-        }
-        sc0 ^= sb0;
-        c ^= a;
-        carry_c ^= carry_a;
-        d ^= b;
-      }
-    }
-    if (carry_a) {
-      tb = sb;
-    } else {
-      for (int i = 0; i < size; i++) {
-        tb[i] = 0;
-      }
-    }
-    if (carry_c) {
-      tc = sb;
-    } else {
-      for (int i = 0; i < size; i++) {
-        tc[i] = 0;
-      }
-    }
-    tb[0] = sb0;
-    tc[0] = sc0;
-    for (int i = 1; i < size; i++) {
-      uint64_t hi;
-      uint64_t lo;
-      uint64_t sbi = sb[i];
-      uint64_t sci = sc[i];
-      clmul(a, sbi, &hi, &lo);
-      tb[i - 1] ^= lo;
-      tb[i] ^= hi;
-      clmul(b, sci, &hi, &lo);
-      tb[i - 1] ^= lo;
-      tb[i] ^= hi;
-      clmul(c, sbi, &hi, &lo);
-      tc[i - 1] ^= lo;
-      tc[i] ^= hi;
-      clmul(d, sci, &hi, &lo);
-      tc[i - 1] ^= lo;
-      tc[i] ^= hi;
-    }
-    sb.swap(tb);
-    sc.swap(tc);
-    size--;
-  }
-  uint64_t sb0 = sb[0];
-  uint64_t sc0 = sc[0];
-  for (int i = n0; i < n; i++) {
-    int disc = sc0 & 1;
-    sc0 >>= 1;
-    if (disc == 1) {
-      if (2 * lfsr_len <= i) {
-        lfsr_len = i + 1 - lfsr_len;
-        std::swap(sb0, sc0);
-      }
-      sc0 ^= sb0;
-    }
-  }
-  return lfsr_len;
-}
-
-#else
 // This is fall-back code for CPU's without clmul.
 // The code hasn't been optimized.
-int LfsrLengthImpl(const std::vector<uint64_t> &seq, int n) {
-  std::vector<uint64_t> sb(seq);
-  std::vector<uint64_t> sc(seq);
+int LfsrLengthImplGeneric(const uint64_t *seq, size_t num_words, int n,
+                          LfsrScratch *scratch) {
+  std::vector<uint64_t> &sb = scratch->sb;
+  std::vector<uint64_t> &sc = scratch->sc;
+  sb.assign(seq, seq + num_words);
+  sc.assign(seq, seq + num_words);
   int lfsr_len = 0;
   for (int i = 0; i < n; i++) {
     int disc = sc[0] & 1;
-    for (int j = 0; j < sc.size() - 1; j++) {
+    for (size_t j = 0; j < sc.size() - 1; j++) {
       sc[j] = (sc[j] >> 1) | (sc[j + 1] << 63);
     }
     sc[sc.size() - 1] >>= 1;
@@ -196,28 +51,201 @@ int LfsrLengthImpl(const std::vector<uint64_t> &seq, int n) {
         lfsr_len = i + 1 - lfsr_len;
         sb.swap(sc);
       }
-      for (int j = 0; j < sc.size(); j++) {
+      for (size_t j = 0; j < sc.size(); j++) {
         sc[j] ^= sb[j];
       }
     }
   }
   return lfsr_len;
 }
+
+bool CpuSupportsClmul() {
+#if defined(__x86_64__)
+  return __builtin_cpu_supports("pclmul");
+#elif defined(__aarch64__) && defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#else
+  return false;
 #endif
+}
 
-bool LfsrLength(const std::vector<uint8_t> &seq, int n, int *length) {
-  if (n < 0 || (size_t)n > 8 * seq.size()) {
-    return false;
+bool CpuSupportsVpclmul() {
+#if defined(__x86_64__)
+  return __builtin_cpu_supports("vpclmulqdq") &&
+         __builtin_cpu_supports("avx512f");
+#else
+  return false;
+#endif
+}
+
+namespace {
+
+// Cumulative counters of the LFSR kernels; see kernel_stats.h. The entry
+// points record one call per language transition, so batch calls count
+// once. The function local static avoids initialization order issues with
+// the counter registry.
+KernelStats &Stats() {
+  static KernelStats *stats = new KernelStats("LfsrLength");
+  return *stats;
+}
+
+using LfsrLengthFn = int (*)(const uint64_t *, size_t, int, LfsrScratch *);
+
+// Selects the fastest kernel that both was compiled into the binary and is
+// supported by the running CPU. The detection runs once at load time.
+// The selected variant is published to the instrumentation counters; above
+// kSubquadraticCutoff bits the subquadratic engine runs instead, built on
+// the same multiplication kernel.
+LfsrLengthFn ResolveLfsrLengthImpl() {
+  if (HasVpclmulKernel() && CpuSupportsVpclmul()) {
+    Stats().SetVariant("vpclmul");
+    return LfsrLengthImplVpclmul;
+  }
+  if (HasClmulKernel() && CpuSupportsClmul()) {
+    Stats().SetVariant("clmul");
+    return LfsrLengthImplClmul;
   }
-  std::vector<uint64_t> s((seq.size() + 7) / 8);
-  for (size_t i = 0; i < seq.size(); i++) {
+  Stats().SetVariant("generic");
+  return LfsrLengthImplGeneric;
+}
+
+int LfsrLengthImpl(const uint64_t *seq, size_t num_words, int n,
+                   LfsrScratch *scratch) {
+  static const LfsrLengthFn impl = ResolveLfsrLengthImpl();
+  if (n >= kSubquadraticCutoff) {
+    return LfsrLengthSubquadratic(seq, num_words, n, scratch);
+  }
+  return impl(seq, num_words, n, scratch);
+}
+
+// Packs a byte sequence into the little endian word representation using
+// scratch->packed as storage.
+const std::vector<uint64_t> &PackWords(const uint8_t *seq, size_t size,
+                                       LfsrScratch *scratch) {
+  std::vector<uint64_t> &s = scratch->packed;
+  s.assign((size + 7) / 8, 0);
+  for (size_t i = 0; i < size; i++) {
     uint64_t byte = seq[i];
     s[i / 8] ^= byte << (8 * (i & 7));
   }
-  *length = LfsrLengthImpl(s, n);
+  return s;
+}
+
+}  // namespace
+
+bool LfsrLength(const std::vector<uint8_t> &seq, int n, int *length) {
+  if (n < 0 || (size_t)n > 8 * seq.size()) {
+    return false;
+  }
+  ScopedKernelTimer timer(&Stats(), seq.size());
+  LfsrScratch scratch;
+  const std::vector<uint64_t> &s = PackWords(seq.data(), seq.size(), &scratch);
+  *length = LfsrLengthImpl(s.data(), s.size(), n, &scratch);
   return true;
 }
 
+int LfsrLengthRaw(const uint8_t *seq, size_t size, int n,
+                  LfsrScratch *scratch) {
+  if (n < 0 || static_cast<size_t>(n) > 8 * size) {
+    return -1;
+  }
+  ScopedKernelTimer timer(&Stats(), size);
+  if (size % 8 == 0 && reinterpret_cast<uintptr_t>(seq) % 8 == 0) {
+    // The caller's memory already is a valid little endian word
+    // representation, so no copy is needed at all.
+    return LfsrLengthImpl(reinterpret_cast<const uint64_t *>(seq), size / 8, n,
+                          scratch);
+  }
+  const std::vector<uint64_t> &s = PackWords(seq, size, scratch);
+  return LfsrLengthImpl(s.data(), s.size(), n, scratch);
+}
+
+int LfsrLengthRaw(const uint8_t *seq, size_t size, int n) {
+  LfsrScratch scratch;
+  return LfsrLengthRaw(seq, size, n, &scratch);
+}
+
+std::vector<int> LfsrLengthBatch(const std::string &buffer, int block_size,
+                                 int num_blocks) {
+  if (block_size <= 0 || num_blocks < 0) {
+    return {};
+  }
+  size_t bytes_per_block = (block_size + 7) / 8;
+  if (buffer.size() < bytes_per_block * num_blocks) {
+    return {};
+  }
+  ScopedKernelTimer timer(&Stats(), bytes_per_block * num_blocks);
+  std::vector<int> lengths(num_blocks);
+  // All scratch buffers are allocated once and reused for all blocks.
+  LfsrScratch scratch;
+  for (int block = 0; block < num_blocks; block++) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(buffer.data()) +
+                           block * bytes_per_block;
+    const std::vector<uint64_t> &s = PackWords(bytes, bytes_per_block,
+                                               &scratch);
+    lengths[block] = LfsrLengthImpl(s.data(), s.size(), block_size, &scratch);
+  }
+  return lengths;
+}
+
+std::vector<int> LfsrLengthBatchParallel(const std::string &buffer,
+                                         int block_size, int num_blocks,
+                                         int num_threads) {
+  if (block_size <= 0 || num_blocks < 0) {
+    return {};
+  }
+  size_t bytes_per_block = (block_size + 7) / 8;
+  if (buffer.size() < bytes_per_block * num_blocks) {
+    return {};
+  }
+  ScopedKernelTimer timer(&Stats(), bytes_per_block * num_blocks);
+  if (num_threads <= 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  num_threads = std::max(1, std::min(num_threads, num_blocks));
+  std::vector<int> lengths(num_blocks);
+  std::atomic<int> next_block{0};
+  auto worker = [&]() {
+    // Each worker owns its scratch, so no synchronization is needed.
+    LfsrScratch scratch;
+    while (true) {
+      int block = next_block.fetch_add(1);
+      if (block >= num_blocks) {
+        return;
+      }
+      const uint8_t *bytes = reinterpret_cast<const uint8_t *>(buffer.data()) +
+                             block * bytes_per_block;
+      const std::vector<uint64_t> &s = PackWords(bytes, bytes_per_block,
+                                                 &scratch);
+      lengths[block] = LfsrLengthImpl(s.data(), s.size(), block_size,
+                                      &scratch);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int i = 1; i < num_threads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  return lengths;
+}
+
+std::vector<int> LfsrProfileStr(const std::string &seq, int n, int stride) {
+  if (n < 0 || static_cast<size_t>(n) > 8 * seq.size() || stride <= 0) {
+    return {};
+  }
+  ScopedKernelTimer timer(&Stats(), seq.size());
+  std::vector<int> profile(n / stride);
+  LfsrScratch scratch;
+  const std::vector<uint64_t> &s = PackWords(
+      reinterpret_cast<const uint8_t *>(seq.data()), seq.size(), &scratch);
+  LfsrProfileImpl(s.data(), s.size(), n, stride, profile.data());
+  return profile;
+}
+
 int LfsrLengthStr(const std::string &seq, int n) {
   // TODO(bleichen): To avoid duplication of memory it would be better to
   //   convert python bytes directly to vector<uint8_t>.
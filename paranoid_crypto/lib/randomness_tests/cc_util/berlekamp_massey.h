@@ -14,12 +14,98 @@
 
 #ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BERLEKAMP_MASSEY_H_
 #define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BERLEKAMP_MASSEY_H_
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
 namespace paranoid_crypto::lib::randomness_tests::cc_util {
 
+// Owns the working buffers of the Berlekamp-Massey kernels. A single call
+// needs four word vectors plus the packed representation of the sequence.
+// Reusing one scratch across many calls of similar size (as the batch entry
+// points do) avoids tens of thousands of identical heap allocations per
+// LinearComplexity run. The buffers grow as needed and are never shrunk.
+// A scratch must not be shared between concurrent calls.
+struct LfsrScratch {
+  std::vector<uint64_t> packed;
+  std::vector<uint64_t> sb;
+  std::vector<uint64_t> sc;
+  std::vector<uint64_t> tb;
+  std::vector<uint64_t> tc;
+};
+
+// Implementation variants of the Berlekamp-Massey algorithm. The entry
+// points below dispatch to the fastest variant that was compiled into the
+// binary and is supported by the running CPU. The variants are exposed here
+// for tests and benchmarks only.
+//
+// The sequence is given as num_words little endian 64-bit words, hence bit j
+// of the sequence is (seq[j / 64] >> (j % 64)) & 1.
+int LfsrLengthImplGeneric(const uint64_t* seq, size_t num_words, int n,
+                          LfsrScratch* scratch);
+
+// The carry-less multiplication kernel, defined in berlekamp_massey_clmul.cc.
+// Falls back to LfsrLengthImplGeneric if the binary was built without the
+// instruction set flags; HasClmulKernel tells the two cases apart.
+int LfsrLengthImplClmul(const uint64_t* seq, size_t num_words, int n,
+                        LfsrScratch* scratch);
+
+// The vectorized carry-less multiplication kernel, defined in
+// berlekamp_massey_vpclmul.cc. Updates the running products eight words at
+// a time with VPCLMULQDQ on 512-bit vectors. Falls back to
+// LfsrLengthImplClmul if the binary was built without the instruction set
+// flags; HasVpclmulKernel tells the two cases apart.
+int LfsrLengthImplVpclmul(const uint64_t* seq, size_t num_words, int n,
+                          LfsrScratch* scratch);
+
+// A subquadratic variant, defined in berlekamp_massey_fast.cc. It combines
+// the per-block transfer matrices of the quadratic kernels recursively and
+// multiplies them with Karatsuba carry-less multiplication. The entry
+// points select it automatically for sequences of at least
+// kSubquadraticCutoff bits; below that the quadratic CLMUL kernel is
+// faster. The scratch argument is accepted for signature compatibility but
+// unused, since the recursion manages its own buffers.
+int LfsrLengthSubquadratic(const uint64_t* seq, size_t num_words, int n,
+                           LfsrScratch* scratch);
+
+// Computes the full linear complexity profile in the same single pass as
+// LfsrLengthSubquadratic: profile[k] receives the LFSR length of the
+// prefix of (k + 1) * stride bits, for all k < n / stride. Returns the
+// length of the full sequence. This replaces calling LfsrLength once per
+// prefix, which would cost another factor of n.
+int LfsrProfileImpl(const uint64_t* seq, size_t num_words, int n, int stride,
+                    int* profile);
+
+// Sequence length in bits above which the entry points switch from the
+// quadratic kernels to LfsrLengthSubquadratic. Determined by benchmarks;
+// the crossover is flat, so the exact value is not critical.
+constexpr int kSubquadraticCutoff = 1 << 18;
+
+// School book carry-less multiplication of two word polynomials over GF(2).
+// The na + nb word product is xored into out. The Clmul variant is defined
+// in berlekamp_massey_clmul.cc and requires CPU support; the Generic
+// variant works everywhere. These are building blocks of the subquadratic
+// engine, exposed for tests.
+void PolyMulAccClmul(const uint64_t* a, size_t na, const uint64_t* b,
+                     size_t nb, uint64_t* out);
+void PolyMulAccGeneric(const uint64_t* a, size_t na, const uint64_t* b,
+                       size_t nb, uint64_t* out);
+
+// True if the CLMUL kernel was compiled into this binary.
+bool HasClmulKernel();
+
+// True if the vectorized CLMUL kernel was compiled into this binary.
+bool HasVpclmulKernel();
+
+// True if the running CPU supports carry-less multiplication
+// (PCLMULQDQ on x86-64, PMULL on aarch64).
+bool CpuSupportsClmul();
+
+// True if the running CPU supports vectorized carry-less multiplication
+// on 512-bit vectors (VPCLMULQDQ with AVX-512).
+bool CpuSupportsVpclmul();
+
 // Computes the linear complexity of a binary sequence of length n.
 // The sequence is represented using little endian byte ordering.
 // Hence bit j of the sequence is (seq[j / 8] >> (j % 8)) & 1.
@@ -31,6 +117,46 @@ bool LfsrLength(const std::vector<uint8_t>& seq, int n, int* length);
 // Hence bit j of the sequence is (seq[j / 8] >> (j % 8)) & 1.
 int LfsrLengthStr(const std::string& seq, int n);
 
+// Same as LfsrLength, but reads the sequence directly from the caller's
+// memory. If seq is 8-byte aligned and size is a multiple of 8 then the
+// memory is used as the word representation without any copy. This is the
+// entry point used by the buffer protocol binding, which accepts bytes,
+// bytearray, memoryview and numpy arrays without copying them.
+// Returns the LFSR length or -1 if n is out of range.
+int LfsrLengthRaw(const uint8_t* seq, size_t size, int n);
+
+// Same as above, but uses the caller's scratch buffers instead of
+// allocating its own. Repeated callers (e.g. the stateful Python handle)
+// keep one scratch alive and pass it to every call.
+int LfsrLengthRaw(const uint8_t* seq, size_t size, int n,
+                  LfsrScratch* scratch);
+
+// Computes the linear complexity of num_blocks sequences of block_size bits
+// each in a single call. The blocks are stored back to back in buffer, each
+// block starting at a byte boundary and occupying (block_size + 7) / 8 bytes.
+// Within a block the bits are represented using little endian byte ordering
+// as in LfsrLength. A single call amortizes the cost of the language
+// transition and the temporary buffers over all blocks.
+// Returns a vector with one LFSR length per block, or an empty vector if the
+// parameters are inconsistent (e.g. buffer is too small).
+std::vector<int> LfsrLengthBatch(const std::string& buffer, int block_size,
+                                 int num_blocks);
+
+// Computes the linear complexity profile of a binary sequence of length n
+// in a single pass: entry k of the result is the LFSR length of the prefix
+// of (k + 1) * stride bits. The sequence is represented using little
+// endian byte ordering as in LfsrLength.
+// Returns an empty vector if n or stride is out of range.
+std::vector<int> LfsrProfileStr(const std::string& seq, int n, int stride);
+
+// Same as LfsrLengthBatch, but distributes the blocks over num_threads
+// worker threads. Each worker owns its own scratch buffers, so no
+// synchronization is needed apart from handing out block indices.
+// If num_threads <= 0 then the number of hardware threads is used.
+std::vector<int> LfsrLengthBatchParallel(const std::string& buffer,
+                                         int block_size, int num_blocks,
+                                         int num_threads);
+
 }  // namespace paranoid_crypto::lib::randomness_tests::cc_util
 
 #endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BERLEKAMP_MASSEY_H_
@@ -0,0 +1,179 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks for the Berlekamp-Massey kernels. Every benchmark reports a
+// bits_per_second counter, so kernels and sequence lengths can be compared
+// directly and regressions show up as numbers. The sweep goes from the
+// 512-bit NIST LinearComplexity block up to 16 Mbit; the quadratic kernels
+// stop at 1 Mbit, where one iteration already takes seconds and the entry
+// points have long switched to the subquadratic engine.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+// A fixed xorshift sequence. The kernels are data independent apart from
+// the final LFSR length, so any full length sequence is representative.
+std::vector<uint64_t> PRandWords(size_t num_words) {
+  std::vector<uint64_t> seq(num_words);
+  uint64_t x = 0x9e3779b97f4a7c15;
+  for (size_t j = 0; j < num_words; j++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    seq[j] = x;
+  }
+  return seq;
+}
+
+// The block layout of LfsrLengthBatch: blocks stored back to back, each
+// starting at a byte boundary.
+std::string PRandBlocks(int block_size, int num_blocks) {
+  size_t bytes_per_block = (block_size + 7) / 8;
+  std::vector<uint64_t> words =
+      PRandWords((bytes_per_block * num_blocks + 7) / 8);
+  return std::string(reinterpret_cast<const char*>(words.data()),
+                     bytes_per_block * num_blocks);
+}
+
+void ReportBitsPerSecond(benchmark::State& state, int64_t bits_per_iteration) {
+  state.counters["bits_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations()) *
+                             static_cast<double>(bits_per_iteration),
+                         benchmark::Counter::kIsRate);
+}
+
+void BM_LfsrLengthImplGeneric(benchmark::State& state) {
+  const int n = state.range(0);
+  const size_t num_words = (n + 63) / 64;
+  std::vector<uint64_t> seq = PRandWords(num_words);
+  LfsrScratch scratch;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        LfsrLengthImplGeneric(seq.data(), num_words, n, &scratch));
+  }
+  ReportBitsPerSecond(state, n);
+}
+BENCHMARK(BM_LfsrLengthImplGeneric)->RangeMultiplier(8)->Range(512, 1 << 20);
+
+void BM_LfsrLengthImplClmul(benchmark::State& state) {
+  if (!HasClmulKernel() || !CpuSupportsClmul()) {
+    state.SkipWithError("CLMUL kernel not available");
+    return;
+  }
+  const int n = state.range(0);
+  const size_t num_words = (n + 63) / 64;
+  std::vector<uint64_t> seq = PRandWords(num_words);
+  LfsrScratch scratch;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        LfsrLengthImplClmul(seq.data(), num_words, n, &scratch));
+  }
+  ReportBitsPerSecond(state, n);
+}
+BENCHMARK(BM_LfsrLengthImplClmul)->RangeMultiplier(8)->Range(512, 1 << 20);
+
+void BM_LfsrLengthImplVpclmul(benchmark::State& state) {
+  if (!HasVpclmulKernel() || !CpuSupportsVpclmul()) {
+    state.SkipWithError("VPCLMULQDQ kernel not available");
+    return;
+  }
+  const int n = state.range(0);
+  const size_t num_words = (n + 63) / 64;
+  std::vector<uint64_t> seq = PRandWords(num_words);
+  LfsrScratch scratch;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        LfsrLengthImplVpclmul(seq.data(), num_words, n, &scratch));
+  }
+  ReportBitsPerSecond(state, n);
+}
+BENCHMARK(BM_LfsrLengthImplVpclmul)->RangeMultiplier(8)->Range(512, 1 << 20);
+
+void BM_LfsrLengthSubquadratic(benchmark::State& state) {
+  const int n = state.range(0);
+  const size_t num_words = (n + 63) / 64;
+  std::vector<uint64_t> seq = PRandWords(num_words);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        LfsrLengthSubquadratic(seq.data(), num_words, n, nullptr));
+  }
+  ReportBitsPerSecond(state, n);
+}
+BENCHMARK(BM_LfsrLengthSubquadratic)
+    ->RangeMultiplier(8)
+    ->Range(512, 16 << 20);
+
+// The dispatching entry point, as called from the pybind binding. This is
+// the number the Python test suite sees.
+void BM_LfsrLengthRaw(benchmark::State& state) {
+  const int n = state.range(0);
+  const size_t num_words = (n + 63) / 64;
+  std::vector<uint64_t> seq = PRandWords(num_words);
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(seq.data());
+  LfsrScratch scratch;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        LfsrLengthRaw(bytes, num_words * 8, n, &scratch));
+  }
+  ReportBitsPerSecond(state, n);
+}
+BENCHMARK(BM_LfsrLengthRaw)->RangeMultiplier(8)->Range(512, 16 << 20);
+
+// The batch entry points with the block sizes that the NIST LinearComplexity
+// parameters of random_test_suite use. Every argument pair processes about
+// 1 Mbit per iteration.
+void BM_LfsrLengthBatch(benchmark::State& state) {
+  const int block_size = state.range(0);
+  const int num_blocks = state.range(1);
+  std::string buffer = PRandBlocks(block_size, num_blocks);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(LfsrLengthBatch(buffer, block_size, num_blocks));
+  }
+  ReportBitsPerSecond(state,
+                      static_cast<int64_t>(block_size) * num_blocks);
+}
+BENCHMARK(BM_LfsrLengthBatch)
+    ->Args({512, 2048})
+    ->Args({1024, 1024})
+    ->Args({2048, 512})
+    ->Args({4096, 256});
+
+void BM_LfsrLengthBatchParallel(benchmark::State& state) {
+  const int block_size = state.range(0);
+  const int num_blocks = state.range(1);
+  std::string buffer = PRandBlocks(block_size, num_blocks);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        LfsrLengthBatchParallel(buffer, block_size, num_blocks,
+                                /*num_threads=*/0));
+  }
+  ReportBitsPerSecond(state,
+                      static_cast<int64_t>(block_size) * num_blocks);
+}
+BENCHMARK(BM_LfsrLengthBatchParallel)
+    ->Args({512, 2048})
+    ->Args({1024, 1024})
+    ->Args({2048, 512})
+    ->Args({4096, 256});
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
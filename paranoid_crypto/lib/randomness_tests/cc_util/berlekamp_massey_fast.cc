@@ -0,0 +1,335 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A subquadratic variant of the Berlekamp-Massey algorithm.
+//
+// The quadratic kernels process the sequence in blocks of 64 bits. Each
+// block computes a 2x2 matrix of polynomials (a, b, c, d) of degree at most
+// 64 such that the running products sb, sc are updated as
+//   sb' = (a * sb + b * sc) >> 64
+//   sc' = (c * sb + d * sc) >> 64
+// Applying each block matrix to the full-length sb and sc immediately is
+// what makes those kernels quadratic.
+//
+// The implementation here instead combines the matrices of adjacent
+// segments recursively: the matrix of a segment of length l is the product
+// of the matrices of its two halves, and only needs the low l bits of sb
+// and sc to be computed. Matrices are multiplied with Karatsuba carry-less
+// polynomial multiplication, giving a total complexity of
+// O(n^1.59 log n) instead of O(n^2). For the short blocks of the NIST
+// LinearComplexity test the quadratic CLMUL kernel is still faster, so the
+// dispatcher only selects this engine above kSubquadraticCutoff bits.
+
+#include <cstring>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+void PolyMulAccGeneric(const uint64_t *a, size_t na, const uint64_t *b,
+                       size_t nb, uint64_t *out) {
+  for (size_t i = 0; i < na; i++) {
+    uint64_t x = a[i];
+    if (x == 0) continue;
+    for (size_t j = 0; j < nb; j++) {
+      uint64_t y = b[j];
+      if (y == 0) continue;
+      uint64_t hi = 0;
+      uint64_t lo = 0;
+      // Software carry-less multiplication. Only used on CPUs without a
+      // carry-less multiply instruction.
+      for (int k = 0; k < 64; k++) {
+        if ((y >> k) & 1) {
+          lo ^= x << k;
+          if (k) hi ^= x >> (64 - k);
+        }
+      }
+      out[i + j] ^= lo;
+      out[i + j + 1] ^= hi;
+    }
+  }
+}
+
+namespace {
+
+using PolyMulAccFn = void (*)(const uint64_t *, size_t, const uint64_t *,
+                              size_t, uint64_t *);
+
+PolyMulAccFn GetPolyMulAccFn() {
+  static const PolyMulAccFn fn = (HasClmulKernel() && CpuSupportsClmul())
+                                     ? PolyMulAccClmul
+                                     : PolyMulAccGeneric;
+  return fn;
+}
+
+// Below this operand size (in words) Karatsuba recursion stops and the
+// school book base case is used. The value is based on experiments.
+constexpr size_t kKaratsubaBaseWords = 24;
+
+// Multiplies two word polynomials of equal size n and xors the 2n word
+// product into out.
+void KaratsubaEqual(const uint64_t *a, const uint64_t *b, size_t n,
+                    uint64_t *out) {
+  if (n <= kKaratsubaBaseWords) {
+    GetPolyMulAccFn()(a, n, b, n, out);
+    return;
+  }
+  size_t h = n / 2;
+  size_t hi_words = n - h;
+  // t = (a_lo + a_hi) * (b_lo + b_hi), with the shorter halves zero padded.
+  std::vector<uint64_t> sums(2 * hi_words, 0);
+  uint64_t *sum_a = sums.data();
+  uint64_t *sum_b = sums.data() + hi_words;
+  for (size_t i = 0; i < hi_words; i++) {
+    sum_a[i] = a[h + i] ^ (i < h ? a[i] : 0);
+    sum_b[i] = b[h + i] ^ (i < h ? b[i] : 0);
+  }
+  std::vector<uint64_t> t(4 * hi_words, 0);
+  uint64_t *t0 = t.data();                  // a_lo * b_lo, 2h words
+  uint64_t *t2 = t.data() + 2 * hi_words;   // a_hi * b_hi, 2 * hi_words words
+  KaratsubaEqual(a, b, h, t0);
+  KaratsubaEqual(a + h, b + h, hi_words, t2);
+  std::vector<uint64_t> t1(2 * hi_words, 0);
+  KaratsubaEqual(sum_a, sum_b, hi_words, t1.data());
+  // out += t0 + x^(128h) t2 + x^(64h) (t1 + t0 + t2)
+  for (size_t i = 0; i < 2 * h; i++) {
+    out[i] ^= t0[i];
+    out[h + i] ^= t0[i];
+  }
+  for (size_t i = 0; i < 2 * hi_words; i++) {
+    out[2 * h + i] ^= t2[i];
+    out[h + i] ^= t2[i] ^ t1[i];
+  }
+}
+
+// Multiplies two word polynomials of possibly different sizes and xors the
+// na + nb word product into out. Unequal sizes are handled by chunking the
+// longer operand.
+void PolyMulAcc(const uint64_t *a, size_t na, const uint64_t *b, size_t nb,
+                uint64_t *out) {
+  if (na < nb) {
+    std::swap(a, b);
+    std::swap(na, nb);
+  }
+  if (nb == 0) return;
+  if (nb <= kKaratsubaBaseWords) {
+    GetPolyMulAccFn()(a, na, b, nb, out);
+    return;
+  }
+  size_t offset = 0;
+  while (na - offset >= nb) {
+    KaratsubaEqual(a + offset, b, nb, out + offset);
+    offset += nb;
+  }
+  if (na > offset) {
+    PolyMulAcc(b, nb, a + offset, na - offset, out + offset);
+  }
+}
+
+// The transfer matrix of a segment of the sequence. Entries are polynomials
+// over GF(2) stored as little endian words. A matrix for a segment of l
+// bits has entries of degree at most l and includes the shift by l
+// consumed bits: (sb', sc') = (a * sb + b * sc, c * sb + d * sc) >> l.
+struct TransferMatrix {
+  std::vector<uint64_t> a;
+  std::vector<uint64_t> b;
+  std::vector<uint64_t> c;
+  std::vector<uint64_t> d;
+};
+
+// Receives the LFSR length after every stride-th bit. The recursion
+// processes the bits of the sequence in increasing order, so the profile
+// can be emitted in the same single pass that computes the final length.
+struct ProfileSink {
+  int stride;
+  int *out;
+};
+
+// Records the LFSR length for the prefix of num_bits bits.
+inline void RecordProfile(const ProfileSink *sink, int num_bits,
+                          int lfsr_len) {
+  if (sink != nullptr && num_bits % sink->stride == 0) {
+    sink->out[num_bits / sink->stride - 1] = lfsr_len;
+  }
+}
+
+// Computes the transfer matrix for 64 bits starting at global position pos.
+// Only the low words of sb and sc are needed. This is the same control loop
+// as in the quadratic kernels; it also advances lfsr_len. The matrix
+// entries a and c can have degree 64, so every entry is two words.
+void LeafMatrix(uint64_t sb0, uint64_t sc0, int pos, int *lfsr_len,
+                const ProfileSink *sink, TransferMatrix *m) {
+  uint64_t a = 1;
+  uint64_t b = 0;
+  uint64_t c = 0;
+  uint64_t d = 1;
+  uint64_t carry_a = 0;
+  uint64_t carry_c = 0;
+  for (int i = 0; i < 64; i++) {
+    int disc = sc0 & 1;
+    sc0 >>= 1;
+    carry_a = a >> 63;
+    carry_c = 0;
+    a <<= 1;
+    b <<= 1;
+    if (disc == 1) {
+      if (2 * *lfsr_len <= i + pos) {
+        *lfsr_len = (i + pos) + 1 - *lfsr_len;
+        std::swap(sb0, sc0);
+        std::swap(a, c);
+        std::swap(b, d);
+        std::swap(carry_a, carry_c);
+      }
+      sc0 ^= sb0;
+      c ^= a;
+      carry_c ^= carry_a;
+      d ^= b;
+    }
+    RecordProfile(sink, pos + i + 1, *lfsr_len);
+  }
+  m->a = {a, carry_a};
+  m->b = {b, 0};
+  m->c = {c, carry_c};
+  m->d = {d, 0};
+}
+
+// Applies a transfer matrix for shift_words * 64 consumed bits to sb and
+// sc, truncating the results to out_words words.
+void ApplyMatrix(const TransferMatrix &m, size_t shift_words,
+                 std::vector<uint64_t> *sb, std::vector<uint64_t> *sc,
+                 size_t out_words) {
+  size_t in_words = sb->size();
+  size_t prod_words = m.a.size() + in_words;
+  std::vector<uint64_t> tb(prod_words, 0);
+  std::vector<uint64_t> tc(prod_words, 0);
+  PolyMulAcc(m.a.data(), m.a.size(), sb->data(), in_words, tb.data());
+  PolyMulAcc(m.b.data(), m.b.size(), sc->data(), in_words, tb.data());
+  PolyMulAcc(m.c.data(), m.c.size(), sb->data(), in_words, tc.data());
+  PolyMulAcc(m.d.data(), m.d.size(), sc->data(), in_words, tc.data());
+  sb->assign(out_words, 0);
+  sc->assign(out_words, 0);
+  for (size_t i = 0; i < out_words && shift_words + i < prod_words; i++) {
+    (*sb)[i] = tb[shift_words + i];
+    (*sc)[i] = tc[shift_words + i];
+  }
+}
+
+// Multiplies two transfer matrices: out = m2 * m1 applies m1 first. The
+// entries of the product are truncated to out_entry_words words, which is
+// sufficient since the degrees add up to the combined segment length.
+void MatMul(const TransferMatrix &m2, const TransferMatrix &m1,
+            size_t out_entry_words, TransferMatrix *out) {
+  size_t prod_words = m2.a.size() + m1.a.size();
+  std::vector<uint64_t> tmp(prod_words);
+  auto mul2 = [&](const std::vector<uint64_t> &x1,
+                  const std::vector<uint64_t> &y1,
+                  const std::vector<uint64_t> &x2,
+                  const std::vector<uint64_t> &y2,
+                  std::vector<uint64_t> *entry) {
+    std::fill(tmp.begin(), tmp.end(), 0);
+    PolyMulAcc(x1.data(), x1.size(), y1.data(), y1.size(), tmp.data());
+    PolyMulAcc(x2.data(), x2.size(), y2.data(), y2.size(), tmp.data());
+    entry->assign(tmp.begin(),
+                  tmp.begin() + std::min(out_entry_words, prod_words));
+    entry->resize(out_entry_words, 0);
+  };
+  mul2(m2.a, m1.a, m2.b, m1.c, &out->a);
+  mul2(m2.a, m1.b, m2.b, m1.d, &out->b);
+  mul2(m2.c, m1.a, m2.d, m1.c, &out->c);
+  mul2(m2.c, m1.b, m2.d, m1.d, &out->d);
+}
+
+// Computes the transfer matrix of the len bits starting at global position
+// pos. len must be a positive multiple of 64 and sb, sc must contain at
+// least len / 64 words.
+void SegmentMatrix(const uint64_t *sb, const uint64_t *sc, int pos, int len,
+                   int *lfsr_len, const ProfileSink *sink, TransferMatrix *m) {
+  if (len == 64) {
+    LeafMatrix(sb[0], sc[0], pos, lfsr_len, sink, m);
+    return;
+  }
+  int l1 = (len / 2) & ~63;
+  int l2 = len - l1;
+  TransferMatrix m1;
+  SegmentMatrix(sb, sc, pos, l1, lfsr_len, sink, &m1);
+  std::vector<uint64_t> sb2(sb, sb + len / 64);
+  std::vector<uint64_t> sc2(sc, sc + len / 64);
+  ApplyMatrix(m1, l1 / 64, &sb2, &sc2, l2 / 64);
+  TransferMatrix m2;
+  SegmentMatrix(sb2.data(), sc2.data(), pos + l1, l2, lfsr_len, sink, &m2);
+  MatMul(m2, m1, len / 64 + 1, m);
+}
+
+// Processes the len bits starting at global position pos and applies the
+// updates to the full-width vectors sb and sc. len must be a multiple
+// of 64. This avoids computing the top-level transfer matrix, which no
+// caller needs.
+void ProcessSegment(std::vector<uint64_t> *sb, std::vector<uint64_t> *sc,
+                    int pos, int len, int *lfsr_len, const ProfileSink *sink) {
+  if (len == 0) return;
+  if (len == 64) {
+    TransferMatrix m;
+    LeafMatrix((*sb)[0], (*sc)[0], pos, lfsr_len, sink, &m);
+    ApplyMatrix(m, 1, sb, sc, sb->size() > 0 ? sb->size() - 1 : 0);
+    return;
+  }
+  int l1 = (len / 2) & ~63;
+  TransferMatrix m1;
+  SegmentMatrix(sb->data(), sc->data(), pos, l1, lfsr_len, sink, &m1);
+  ApplyMatrix(m1, l1 / 64, sb, sc, sb->size() - l1 / 64);
+  ProcessSegment(sb, sc, pos + l1, len - l1, lfsr_len, sink);
+}
+
+// Shared implementation of the plain subquadratic entry point and the
+// profile variant.
+int SubquadraticImpl(const uint64_t *seq, size_t num_words, int n,
+                     const ProfileSink *sink) {
+  std::vector<uint64_t> sb(seq, seq + num_words);
+  std::vector<uint64_t> sc(seq, seq + num_words);
+  int lfsr_len = 0;
+  int n0 = n - (n & 63);
+  ProcessSegment(&sb, &sc, 0, n0, &lfsr_len, sink);
+  uint64_t sb0 = sb.empty() ? 0 : sb[0];
+  uint64_t sc0 = sc.empty() ? 0 : sc[0];
+  for (int i = n0; i < n; i++) {
+    int disc = sc0 & 1;
+    sc0 >>= 1;
+    if (disc == 1) {
+      if (2 * lfsr_len <= i) {
+        lfsr_len = i + 1 - lfsr_len;
+        std::swap(sb0, sc0);
+      }
+      sc0 ^= sb0;
+    }
+    RecordProfile(sink, i + 1, lfsr_len);
+  }
+  return lfsr_len;
+}
+
+}  // namespace
+
+int LfsrLengthSubquadratic(const uint64_t *seq, size_t num_words, int n,
+                           LfsrScratch *scratch) {
+  (void)scratch;  // This engine manages its own temporary buffers.
+  return SubquadraticImpl(seq, num_words, n, nullptr);
+}
+
+int LfsrProfileImpl(const uint64_t *seq, size_t num_words, int n, int stride,
+                    int *profile) {
+  ProfileSink sink = {stride, profile};
+  return SubquadraticImpl(seq, num_words, n, &sink);
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
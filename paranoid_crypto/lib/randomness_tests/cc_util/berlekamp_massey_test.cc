@@ -88,6 +88,176 @@ TEST(BerlekampMassey, Compare) {
   }
 }
 
+TEST(BerlekampMassey, KernelVariantsAgree) {
+  // The CLMUL kernel and the generic kernel must return identical results,
+  // since runtime dispatch may select either depending on the CPU.
+  for (int words : {1, 2, 3, 9}) {
+    std::vector<uint8_t> bytes(8 * words);
+    FillVectorWithPRand(&bytes);
+    std::vector<uint64_t> seq(words);
+    for (int i = 0; i < 8 * words; i++) {
+      seq[i / 8] ^= static_cast<uint64_t>(bytes[i]) << (8 * (i & 7));
+    }
+    LfsrScratch scratch_a;
+    LfsrScratch scratch_b;
+    for (int n : {1, 63, 64, 64 * words - 1, 64 * words}) {
+      if (n > 64 * words) continue;
+      int expected = LfsrLengthImplGeneric(seq.data(), words, n, &scratch_a);
+      EXPECT_EQ(expected, LfsrLengthImplClmul(seq.data(), words, n, &scratch_b))
+          << words << " " << n;
+      EXPECT_EQ(expected,
+                LfsrLengthImplVpclmul(seq.data(), words, n, &scratch_b))
+          << words << " " << n;
+    }
+  }
+}
+
+TEST(BerlekampMassey, PolyMulVariantsAgree) {
+  // The Karatsuba engine picks either base case at runtime, so both must
+  // compute the same products.
+  for (int na : {1, 2, 7, 25}) {
+    for (int nb : {1, 3, 25}) {
+      std::vector<uint8_t> bytes(8 * (na + nb));
+      FillVectorWithPRand(&bytes);
+      std::vector<uint64_t> ops(na + nb);
+      for (int i = 0; i < 8 * (na + nb); i++) {
+        ops[i / 8] ^= static_cast<uint64_t>(bytes[i]) << (8 * (i & 7));
+      }
+      std::vector<uint64_t> out1(na + nb + 1, 0);
+      std::vector<uint64_t> out2(na + nb + 1, 0);
+      PolyMulAccClmul(ops.data(), na, ops.data() + na, nb, out1.data());
+      PolyMulAccGeneric(ops.data(), na, ops.data() + na, nb, out2.data());
+      EXPECT_EQ(out1, out2) << na << " " << nb;
+    }
+  }
+}
+
+TEST(BerlekampMassey, SubquadraticAgrees) {
+  // The subquadratic engine must return the same lengths as the quadratic
+  // kernels, including for lengths that are not multiples of 64 and for
+  // sequences with long runs of zeros.
+  LfsrScratch scratch;
+  for (int n : {1, 63, 64, 65, 1000, 4096, 4100, 10007}) {
+    int words = (n + 63) / 64;
+    std::vector<uint8_t> bytes(8 * words);
+    FillVectorWithPRand(&bytes);
+    std::vector<uint64_t> seq(words);
+    for (int i = 0; i < 8 * words; i++) {
+      seq[i / 8] ^= static_cast<uint64_t>(bytes[i]) << (8 * (i & 7));
+    }
+    EXPECT_EQ(LfsrLengthImplGeneric(seq.data(), words, n, &scratch),
+              LfsrLengthSubquadratic(seq.data(), words, n, nullptr))
+        << n;
+    // Leading zeros delay the first length change past block boundaries.
+    for (int i = 0; i < words / 2; i++) seq[i] = 0;
+    EXPECT_EQ(LfsrLengthImplGeneric(seq.data(), words, n, &scratch),
+              LfsrLengthSubquadratic(seq.data(), words, n, nullptr))
+        << n;
+    // Trailing zeros keep the length at its earlier value.
+    std::vector<uint64_t> zeros(words, 0);
+    if (n > 1) zeros[(n - 2) / 64] = 1ull << ((n - 2) % 64);
+    EXPECT_EQ(LfsrLengthImplGeneric(zeros.data(), words, n, &scratch),
+              LfsrLengthSubquadratic(zeros.data(), words, n, nullptr))
+        << n;
+  }
+}
+
+TEST(BerlekampMassey, Profile) {
+  // Every profile entry must match the length computed for the prefix.
+  const int n = 500;
+  std::vector<uint8_t> seq((n + 7) / 8);
+  FillVectorWithPRand(&seq);
+  std::string buffer(seq.begin(), seq.end());
+  for (int stride : {1, 7, 64}) {
+    std::vector<int> profile = LfsrProfileStr(buffer, n, stride);
+    ASSERT_EQ(n / stride, profile.size()) << stride;
+    for (int k = 0; k < n / stride; k++) {
+      int expected;
+      ASSERT_TRUE(LfsrLength(seq, (k + 1) * stride, &expected));
+      EXPECT_EQ(expected, profile[k]) << stride << " " << k;
+    }
+  }
+  EXPECT_TRUE(LfsrProfileStr(buffer, n, 0).empty());
+  EXPECT_TRUE(LfsrProfileStr(buffer, 8 * static_cast<int>(seq.size()) + 1, 1)
+                  .empty());
+}
+
+TEST(BerlekampMassey, ScratchReuse) {
+  // One scratch can be reused across calls with different sizes.
+  LfsrScratch scratch;
+  for (int size : {128, 8, 64, 1024, 16}) {
+    std::vector<uint8_t> seq(size);
+    FillVectorWithPRand(&seq);
+    int expected;
+    ASSERT_TRUE(LfsrLength(seq, 8 * size, &expected));
+    EXPECT_EQ(expected, LfsrLengthRaw(seq.data(), size, 8 * size, &scratch))
+        << size;
+  }
+}
+
+TEST(BerlekampMassey, Raw) {
+  // Covers both the aligned zero-copy path and the packing path with an
+  // unaligned pointer.
+  for (int size : {8, 15, 16, 64, 127, 128}) {
+    std::vector<uint8_t> seq(size + 1);
+    FillVectorWithPRand(&seq);
+    int expected;
+    ASSERT_TRUE(LfsrLength(std::vector<uint8_t>(seq.begin(), seq.end() - 1),
+                           8 * size, &expected));
+    EXPECT_EQ(expected, LfsrLengthRaw(seq.data(), size, 8 * size)) << size;
+    std::vector<uint8_t> unaligned(seq.begin() + 1, seq.end());
+    int expected2;
+    ASSERT_TRUE(LfsrLength(unaligned, 8 * size, &expected2));
+    EXPECT_EQ(expected2, LfsrLengthRaw(seq.data() + 1, size, 8 * size)) << size;
+  }
+  EXPECT_EQ(-1, LfsrLengthRaw(nullptr, 0, -1));
+  std::vector<uint8_t> seq(8);
+  EXPECT_EQ(-1, LfsrLengthRaw(seq.data(), 8, 65));
+}
+
+TEST(BerlekampMassey, Batch) {
+  for (int block_size : {9, 64, 100, 512}) {
+    const int num_blocks = 16;
+    int bytes_per_block = (block_size + 7) / 8;
+    std::vector<uint8_t> bytes(bytes_per_block * num_blocks);
+    FillVectorWithPRand(&bytes);
+    int mask = (1 << (((block_size - 1) % 8) + 1)) - 1;
+    for (int i = 0; i < num_blocks; i++) {
+      bytes[(i + 1) * bytes_per_block - 1] &= mask;
+    }
+    std::string buffer(bytes.begin(), bytes.end());
+    std::vector<int> lengths = LfsrLengthBatch(buffer, block_size, num_blocks);
+    ASSERT_EQ(num_blocks, lengths.size());
+    for (int i = 0; i < num_blocks; i++) {
+      std::vector<uint8_t> block(bytes.begin() + i * bytes_per_block,
+                                 bytes.begin() + (i + 1) * bytes_per_block);
+      int expected;
+      ASSERT_TRUE(LfsrLength(block, block_size, &expected));
+      EXPECT_EQ(expected, lengths[i]) << block_size << " " << i;
+    }
+  }
+}
+
+TEST(BerlekampMassey, BatchParallel) {
+  const int block_size = 512;
+  const int num_blocks = 64;
+  std::vector<uint8_t> bytes(block_size / 8 * num_blocks);
+  FillVectorWithPRand(&bytes);
+  std::string buffer(bytes.begin(), bytes.end());
+  std::vector<int> expected = LfsrLengthBatch(buffer, block_size, num_blocks);
+  for (int num_threads : {0, 1, 2, 7}) {
+    std::vector<int> lengths =
+        LfsrLengthBatchParallel(buffer, block_size, num_blocks, num_threads);
+    EXPECT_EQ(expected, lengths) << num_threads;
+  }
+}
+
+TEST(BerlekampMassey, BatchInvalidParameters) {
+  EXPECT_TRUE(LfsrLengthBatch(std::string(8, 'a'), 0, 1).empty());
+  EXPECT_TRUE(LfsrLengthBatch(std::string(8, 'a'), 64, 2).empty());
+  EXPECT_TRUE(LfsrLengthBatch(std::string(8, 'a'), 65, 1).empty());
+}
+
 TEST(BerlekampMassey, EdgeCases) {
   // Edge cases are sequences starting with lots of 0 bits.
   for (int size = 16; size < 300; size++) {
@@ -0,0 +1,222 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The vectorized carry-less multiplication kernel for the Berlekamp-Massey
+// algorithm.
+//
+// This is the same algorithm as in berlekamp_massey_clmul.cc, but the inner
+// update of the running products sb and sc processes eight words at a time
+// with VPCLMULQDQ on 512-bit vectors (plus one 256-bit step for the
+// remainder). A single VPCLMULQDQ instruction computes four carry-less
+// products, so the update needs 8 instead of 32 multiplications per eight
+// words. Like the other kernel translation units this file is the only one
+// compiled with the necessary instruction set flags (see setup.py); the
+// kernel is selected at load time on CPUs that support it.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey.h"
+
+#if defined(__x86_64__) && defined(__VPCLMULQDQ__) && defined(__AVX512F__)
+#include <immintrin.h>
+#define USE_VPCLMUL
+#endif
+
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+#ifdef USE_VPCLMUL
+
+namespace {
+
+inline void clmul(uint64_t x, uint64_t y, uint64_t *hi, uint64_t *lo) {
+  __m128i tmp = _mm_clmulepi64_si128(_mm_set_epi64x(0, x),
+                                     _mm_set_epi64x(0, y), 0x00);
+  *hi = _mm_cvtsi128_si64(_mm_srli_si128(tmp, 8));
+  *lo = _mm_cvtsi128_si64(tmp);
+}
+
+// Computes the products of the eight words at sb with mul_b plus the eight
+// words at sc with mul_c and xors them into dst[-1] .. dst[8]. Each
+// 128-bit product of word j covers the word slots j - 1 and j of the
+// shifted result, so the combined products of the even words line up with
+// an unaligned store at dst - 1 and those of the odd words with a store at
+// dst. Combining both multiplicands before touching memory halves the
+// read-modify-write traffic on dst.
+inline void MulAcc8(__m512i mul_b, __m512i mul_c, const uint64_t *sb,
+                    const uint64_t *sc, uint64_t *dst, __m512i *prev_odd) {
+  __m512i vb = _mm512_loadu_si512(sb);
+  __m512i vc = _mm512_loadu_si512(sc);
+  __m512i even = _mm512_xor_si512(_mm512_clmulepi64_epi128(vb, mul_b, 0x00),
+                                  _mm512_clmulepi64_epi128(vc, mul_c, 0x00));
+  __m512i odd = _mm512_xor_si512(_mm512_clmulepi64_epi128(vb, mul_b, 0x01),
+                                 _mm512_clmulepi64_epi128(vc, mul_c, 0x01));
+  // The odd products belong one word slot higher than the even products.
+  // Shifting them by one slot (pulling in the word carried over from the
+  // previous group) folds everything into a single store per group, which
+  // avoids overlapping read-modify-write cycles on dst.
+  __m512i shifted = _mm512_alignr_epi64(odd, *prev_odd, 7);
+  *prev_odd = odd;
+  _mm512_storeu_si512(
+      dst - 1, _mm512_xor_si512(_mm512_loadu_si512(dst - 1),
+                                _mm512_xor_si512(even, shifted)));
+}
+
+// Same as MulAcc8 for four words, xoring into dst[-1] .. dst[4].
+inline void MulAcc4(__m256i mul_b, __m256i mul_c, const uint64_t *sb,
+                    const uint64_t *sc, uint64_t *dst) {
+  __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sb));
+  __m256i vc = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sc));
+  __m256i even = _mm256_xor_si256(_mm256_clmulepi64_epi128(vb, mul_b, 0x00),
+                                  _mm256_clmulepi64_epi128(vc, mul_c, 0x00));
+  __m256i odd = _mm256_xor_si256(_mm256_clmulepi64_epi128(vb, mul_b, 0x01),
+                                 _mm256_clmulepi64_epi128(vc, mul_c, 0x01));
+  __m256i *d0 = reinterpret_cast<__m256i *>(dst - 1);
+  _mm256_storeu_si256(d0, _mm256_xor_si256(_mm256_loadu_si256(d0), even));
+  __m256i *d1 = reinterpret_cast<__m256i *>(dst);
+  _mm256_storeu_si256(d1, _mm256_xor_si256(_mm256_loadu_si256(d1), odd));
+}
+
+}  // namespace
+
+int LfsrLengthImplVpclmul(const uint64_t *seq, size_t num_words, int n,
+                          LfsrScratch *scratch) {
+  std::vector<uint64_t> &sb = scratch->sb;
+  std::vector<uint64_t> &sc = scratch->sc;
+  std::vector<uint64_t> &tb = scratch->tb;
+  std::vector<uint64_t> &tc = scratch->tc;
+  sb.assign(seq, seq + num_words);
+  sc.assign(seq, seq + num_words);
+  tb.assign(num_words, 0);
+  tc.assign(num_words, 0);
+  int lfsr_len = 0;
+  int n0 = n - (n & 63);
+  int size = num_words;
+  for (int j = 0; j < n0; j += 64) {
+    uint64_t sb0 = sb[0];
+    uint64_t sc0 = sc[0];
+    uint64_t a = 1;
+    uint64_t b = 0;
+    uint64_t c = 0;
+    uint64_t d = 1;
+    uint64_t carry_a = 0;
+    uint64_t carry_c = 0;
+    for (int i = 0; i < 64; i++) {
+      int disc = sc0 & 1;
+      sc0 >>= 1;
+      carry_a = a >> 63;
+      carry_c = 0;
+      a <<= 1;
+      b <<= 1;
+      if (disc == 1) {
+        if (2 * lfsr_len <= i + j) {
+          lfsr_len = (i + j) + 1 - lfsr_len;
+          std::swap(sb0, sc0);
+          std::swap(a, c);
+          std::swap(b, d);
+          std::swap(carry_a, carry_c);
+        }
+        sc0 ^= sb0;
+        c ^= a;
+        carry_c ^= carry_a;
+        d ^= b;
+      }
+    }
+    for (int i = 0; i < size; i++) {
+      tb[i] = carry_a ? sb[i] : 0;
+      tc[i] = carry_c ? sb[i] : 0;
+    }
+    tb[0] = sb0;
+    tc[0] = sc0;
+    int i = 1;
+    if (size - i >= 8) {
+      __m512i av = _mm512_set1_epi64(a);
+      __m512i bv = _mm512_set1_epi64(b);
+      __m512i cv = _mm512_set1_epi64(c);
+      __m512i dv = _mm512_set1_epi64(d);
+      __m512i odd_b = _mm512_setzero_si512();
+      __m512i odd_c = _mm512_setzero_si512();
+      for (; size - i >= 8; i += 8) {
+        MulAcc8(av, bv, &sb[i], &sc[i], &tb[i], &odd_b);
+        MulAcc8(cv, dv, &sb[i], &sc[i], &tc[i], &odd_c);
+      }
+      // The carried words of the last group still need to be applied.
+      tb[i - 1] ^= static_cast<uint64_t>(
+          _mm256_extract_epi64(_mm512_extracti64x4_epi64(odd_b, 1), 3));
+      tc[i - 1] ^= static_cast<uint64_t>(
+          _mm256_extract_epi64(_mm512_extracti64x4_epi64(odd_c, 1), 3));
+    }
+    if (size - i >= 4) {
+      __m256i av = _mm256_set1_epi64x(a);
+      __m256i bv = _mm256_set1_epi64x(b);
+      __m256i cv = _mm256_set1_epi64x(c);
+      __m256i dv = _mm256_set1_epi64x(d);
+      MulAcc4(av, bv, &sb[i], &sc[i], &tb[i]);
+      MulAcc4(cv, dv, &sb[i], &sc[i], &tc[i]);
+      i += 4;
+    }
+    for (; i < size; i++) {
+      uint64_t hi;
+      uint64_t lo;
+      uint64_t sbi = sb[i];
+      uint64_t sci = sc[i];
+      clmul(a, sbi, &hi, &lo);
+      tb[i - 1] ^= lo;
+      tb[i] ^= hi;
+      clmul(b, sci, &hi, &lo);
+      tb[i - 1] ^= lo;
+      tb[i] ^= hi;
+      clmul(c, sbi, &hi, &lo);
+      tc[i - 1] ^= lo;
+      tc[i] ^= hi;
+      clmul(d, sci, &hi, &lo);
+      tc[i - 1] ^= lo;
+      tc[i] ^= hi;
+    }
+    sb.swap(tb);
+    sc.swap(tc);
+    size--;
+  }
+  uint64_t sb0 = sb[0];
+  uint64_t sc0 = sc[0];
+  for (int i = n0; i < n; i++) {
+    int disc = sc0 & 1;
+    sc0 >>= 1;
+    if (disc == 1) {
+      if (2 * lfsr_len <= i) {
+        lfsr_len = i + 1 - lfsr_len;
+        std::swap(sb0, sc0);
+      }
+      sc0 ^= sb0;
+    }
+  }
+  return lfsr_len;
+}
+
+bool HasVpclmulKernel() { return true; }
+
+#else
+
+// If this translation unit was built without the instruction set flags then
+// the kernel is not available and the dispatcher falls back to the next
+// fastest variant.
+int LfsrLengthImplVpclmul(const uint64_t *seq, size_t num_words, int n,
+                          LfsrScratch *scratch) {
+  return LfsrLengthImplClmul(seq, num_words, n, scratch);
+}
+
+bool HasVpclmulKernel() { return false; }
+
+#endif
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
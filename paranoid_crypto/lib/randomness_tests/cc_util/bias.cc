@@ -0,0 +1,93 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/bias.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// Cumulative counters of the bias kernel; see kernel_stats.h. One call
+// covers all transforms.
+KernelStats& Stats() {
+  static KernelStats* stats = new KernelStats("BiasSums");
+  return *stats;
+}
+
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), /*order=*/-1, /*size=*/1,
+             /*endian=*/0, /*nails=*/0, bytes.data());
+  return value;
+}
+
+std::string ToBytes(const mpz_class& value) {
+  std::string bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8, '\0');
+  size_t count = 0;
+  mpz_export(&bytes[0], &count, /*order=*/-1, /*size=*/1, /*endian=*/0,
+             /*nails=*/0, value.get_mpz_t());
+  bytes.resize(std::max<size_t>(count, 1));
+  return bytes;
+}
+
+}  // namespace
+
+std::vector<std::string> BiasSums(
+    const std::vector<std::string>& sample, const std::string& n,
+    const std::vector<std::pair<std::string, std::string>>& transforms) {
+  const mpz_class modulus = FromBytes(n);
+  if (modulus == 0) {
+    return {};
+  }
+  int64_t input_bytes = n.size();
+  for (const std::string& s : sample) {
+    input_bytes += s.size();
+  }
+  ScopedKernelTimer timer(&Stats(), input_bytes);
+  std::vector<mpz_class> elements;
+  elements.reserve(sample.size());
+  for (const std::string& s : sample) {
+    elements.push_back(FromBytes(s));
+  }
+  std::vector<std::string> results;
+  results.reserve(transforms.size());
+  mpz_class v, dist;
+  for (const auto& [a_bytes, b_bytes] : transforms) {
+    const mpz_class a = FromBytes(a_bytes);
+    const mpz_class b = FromBytes(b_bytes);
+    mpz_class t = 0;
+    for (const mpz_class& s : elements) {
+      // v = (a * s + b) mod n. The operands stay in the preallocated
+      // temporaries, so the inner loop does not allocate.
+      v = a * s;
+      v += b;
+      mpz_mod(v.get_mpz_t(), v.get_mpz_t(), modulus.get_mpz_t());
+      dist = modulus - v;
+      t += std::min(v, dist);
+    }
+    results.push_back(ToBytes(t));
+  }
+  return results;
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,42 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BIAS_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BIAS_H_
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Kernel for the bias statistic of lattice_suite.Bias. The sample elements
+// are residues modulo n of the size of the tested blocks (256 bits and
+// more), hence the arithmetic uses GMP rather than native words. All
+// integers cross the boundary as unsigned little endian byte strings, as
+// in the engines of lib/cc_util.
+
+// Computes, for each transform (a, b), the sum over all sample elements s
+// of the distance of a * s + b to the closest multiple of n, i.e.
+// min(v, n - v) with v = (a * s + b) mod n. This is the statistic t of
+// lattice_suite.Bias, evaluated for all transforms in a single call, so
+// that the per element cost is a few GMP word operations instead of
+// Python bignum arithmetic. a and b must already be reduced modulo n.
+// Returns one sum per transform, or an empty vector if n is zero.
+std::vector<std::string> BiasSums(
+    const std::vector<std::string>& sample, const std::string& n,
+    const std::vector<std::pair<std::string, std::string>>& transforms);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BIAS_H_
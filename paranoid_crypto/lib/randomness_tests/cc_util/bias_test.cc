@@ -0,0 +1,117 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/bias.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+// Minimal little endian encoding of a word, as int.to_bytes produces it.
+std::string Bytes(uint64_t value) {
+  std::string bytes;
+  do {
+    bytes.push_back(static_cast<char>(value & 0xff));
+    value >>= 8;
+  } while (value != 0);
+  return bytes;
+}
+
+uint64_t ToWord(const std::string& bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes.size() && i < 8; i++) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+  }
+  return value;
+}
+
+TEST(Bias, KnownAnswer) {
+  // For n = 10, the transform (3, 2) maps the sample 1, 7, 9 to the
+  // residues 5, 3, 9 with distances 5, 3, 1 to the closest multiple of 10.
+  std::vector<std::string> sample = {Bytes(1), Bytes(7), Bytes(9)};
+  std::vector<std::pair<std::string, std::string>> transforms = {
+      {Bytes(3), Bytes(2)}, {Bytes(1), Bytes(0)}};
+  std::vector<std::string> sums = BiasSums(sample, Bytes(10), transforms);
+  ASSERT_EQ(sums.size(), 2);
+  EXPECT_EQ(ToWord(sums[0]), 9);
+  // The identity transform leaves the residues 1, 7, 9 with distances
+  // 1, 3, 1.
+  EXPECT_EQ(ToWord(sums[1]), 5);
+}
+
+TEST(Bias, MatchesReference) {
+  // Compares the kernel with a word sized reference computation over many
+  // transforms.
+  constexpr uint64_t n = 0x100000001;
+  std::vector<uint64_t> sample;
+  for (uint64_t j = 0; j < 200; j++) {
+    sample.push_back((j * j * 56843 + j * 903840143) % n);
+  }
+  std::vector<std::pair<std::string, std::string>> transforms;
+  std::vector<uint64_t> expected;
+  for (uint64_t k = 0; k < 25; k++) {
+    uint64_t a = (k * 2718281828459045235ull + 1) % n;
+    uint64_t b = (k * 3141592653589793238ull) % n;
+    transforms.push_back({Bytes(a), Bytes(b)});
+    uint64_t t = 0;
+    for (uint64_t s : sample) {
+      uint64_t v = (static_cast<unsigned __int128>(a) * s + b) % n;
+      t += std::min(v, n - v);
+    }
+    expected.push_back(t);
+  }
+  std::vector<std::string> sample_bytes;
+  for (uint64_t s : sample) {
+    sample_bytes.push_back(Bytes(s));
+  }
+  std::vector<std::string> sums = BiasSums(sample_bytes, Bytes(n), transforms);
+  ASSERT_EQ(sums.size(), transforms.size());
+  for (size_t k = 0; k < sums.size(); k++) {
+    EXPECT_EQ(ToWord(sums[k]), expected[k]) << k;
+  }
+}
+
+TEST(Bias, WideModulus) {
+  // A 256-bit modulus: n = 2^256, the sample element 2^255 + 5 has the
+  // residue 2^255 + 5 under the identity transform, with the distance
+  // 2^255 - 5 to the closest multiple.
+  std::string n(33, '\0');
+  n[32] = 1;
+  std::string s(32, '\0');
+  s[0] = 5;
+  s[31] = static_cast<char>(0x80);
+  std::vector<std::string> sums =
+      BiasSums({s}, n, {{Bytes(1), Bytes(0)}, {Bytes(2), Bytes(0)}});
+  ASSERT_EQ(sums.size(), 2);
+  // 2^255 - 5 in little endian bytes.
+  std::string expected(32, static_cast<char>(0xff));
+  expected[0] = static_cast<char>(0xfb);
+  expected[31] = 0x7f;
+  EXPECT_EQ(sums[0], expected);
+  // Doubling maps the element to the residue 10 with distance 10.
+  EXPECT_EQ(ToWord(sums[1]), 10);
+}
+
+TEST(Bias, ZeroModulusRejected) {
+  EXPECT_TRUE(BiasSums({Bytes(1)}, Bytes(0), {{Bytes(1), Bytes(0)}}).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
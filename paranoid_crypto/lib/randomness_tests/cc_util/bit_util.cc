@@ -0,0 +1,125 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/bit_util.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// Reads the byte starting at bit offset of the sequence. Bits past the end
+// of the buffer read as zero.
+inline uint8_t ByteAt(const uint8_t *seq, size_t size, size_t offset) {
+  size_t idx = offset / 8;
+  int shift = offset % 8;
+  uint8_t lo = idx < size ? seq[idx] : 0;
+  if (shift == 0) {
+    return lo;
+  }
+  uint8_t hi = idx + 1 < size ? seq[idx + 1] : 0;
+  return (lo >> shift) | (hi << (8 - shift));
+}
+
+// The table to reverse the bits of a byte, built like util._ReversedBytes.
+const uint8_t *ReversedBytesTable() {
+  static const uint8_t *table = [] {
+    uint8_t *res = new uint8_t[256]();
+    for (int j = 1; j < 256; j++) {
+      res[j] = (res[j >> 1] >> 1) ^ ((j & 1) << 7);
+    }
+    return res;
+  }();
+  return table;
+}
+
+}  // namespace
+
+std::string SplitBlocks(const uint8_t *seq, size_t size, int n, int m) {
+  if (n < 0 || m <= 0 || static_cast<size_t>(n) > 8 * size) {
+    return {};
+  }
+  int num_blocks = n / m;
+  size_t bytes_per_block = (m + 7) / 8;
+  std::string out(bytes_per_block * num_blocks, 0);
+  uint8_t last_mask = static_cast<uint8_t>((1 << (((m - 1) % 8) + 1)) - 1);
+  for (int i = 0; i < num_blocks; i++) {
+    size_t offset = static_cast<size_t>(i) * m;
+    uint8_t *block = reinterpret_cast<uint8_t *>(&out[i * bytes_per_block]);
+    for (size_t j = 0; j < bytes_per_block; j++) {
+      block[j] = ByteAt(seq, size, offset + 8 * j);
+    }
+    block[bytes_per_block - 1] &= last_mask;
+  }
+  return out;
+}
+
+std::vector<std::string> ScatterBits(const uint8_t *seq, size_t size, int n,
+                                     int m) {
+  if (n < 0 || m <= 0 || static_cast<size_t>(n) > 8 * size) {
+    return {};
+  }
+  // Stream i receives the bits i, i + m, i + 2 * m, ... and hence
+  // (n - i + m - 1) / m bits in total.
+  std::vector<std::string> out(m);
+  for (int i = 0; i < m; i++) {
+    out[i].assign(((n - i + m - 1) / m + 7) / 8, 0);
+  }
+  for (int k = 0; k < n; k++) {
+    if ((seq[k / 8] >> (k % 8)) & 1) {
+      int pos = k / m;
+      out[k % m][pos / 8] |= static_cast<char>(1 << (pos % 8));
+    }
+  }
+  return out;
+}
+
+std::string ReverseBits(const uint8_t *seq, size_t size, int n) {
+  if (n < 0 || static_cast<size_t>(n) > 8 * size) {
+    return {};
+  }
+  const uint8_t *table = ReversedBytesTable();
+  size_t num_bytes = (n + 7) / 8;
+  // Reverses the bits in each byte and the byte order, then shifts the
+  // extra bits of a partial last byte out.
+  std::string tmp(num_bytes, 0);
+  for (size_t i = 0; i < num_bytes; i++) {
+    tmp[i] = static_cast<char>(table[seq[num_bytes - 1 - i]]);
+  }
+  int shift = (8 - n % 8) % 8;
+  if (shift == 0) {
+    return tmp;
+  }
+  std::string out(num_bytes, 0);
+  for (size_t i = 0; i < num_bytes; i++) {
+    uint8_t lo = static_cast<uint8_t>(tmp[i]) >> shift;
+    uint8_t hi = i + 1 < num_bytes
+                     ? static_cast<uint8_t>(tmp[i + 1]) << (8 - shift)
+                     : 0;
+    out[i] = static_cast<char>(lo | hi);
+  }
+  return out;
+}
+
+std::string BitsToSigns(const uint8_t *seq, size_t size, int n) {
+  if (n < 0 || static_cast<size_t>(n) > 8 * size) {
+    return {};
+  }
+  std::string out(n, 0);
+  for (int k = 0; k < n; k++) {
+    out[k] = (seq[k / 8] >> (k % 8)) & 1 ? 0x01 : '\xff';
+  }
+  return out;
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
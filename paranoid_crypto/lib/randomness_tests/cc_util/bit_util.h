@@ -0,0 +1,58 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BIT_UTIL_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BIT_UTIL_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Bit manipulation kernels for the randomness tests. All functions read a
+// bit sequence of n bits directly from the caller's memory in the little
+// endian byte representation used throughout this directory: bit j of the
+// sequence is (seq[j / 8] >> (j % 8)) & 1. The Python bindings pass the
+// underlying buffer of bytes objects without copying it, so a sequence is
+// unpacked once and shared by every test. All functions return empty
+// results if the parameters are inconsistent (e.g. n > 8 * size).
+
+// Splits the first n bits into n / m non-overlapping blocks of m bits.
+// In the result every block starts at a byte boundary and occupies
+// (m + 7) / 8 bytes, which is the layout the batched Berlekamp-Massey and
+// matrix rank kernels consume. A partial last block is ignored, as in
+// util.SplitSequence.
+std::string SplitBlocks(const uint8_t* seq, size_t size, int n, int m);
+
+// Divides the first n bits into m interleaved bit strings: the i-th result
+// contains the bits i, i + m, i + 2 * m, ... of the sequence, packed in
+// the same little endian representation.
+std::vector<std::string> ScatterBits(const uint8_t* seq, size_t size, int n,
+                                     int m);
+
+// Reverses the first n bits of the sequence, so that bit j of the result
+// is bit n - 1 - j of the input. Uses a 256-entry table to reverse the
+// bits of each byte, like util._ReversedBytes.
+std::string ReverseBits(const uint8_t* seq, size_t size, int n);
+
+// Converts the first n bits to the balanced representation used by the
+// Spectral test: byte k of the result is 0x01 if bit k is set and 0xff
+// (i.e. -1 as a signed byte) otherwise. The result can be viewed as a
+// numpy int8 array or an array.array("b") without a further copy.
+std::string BitsToSigns(const uint8_t* seq, size_t size, int n);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_BIT_UTIL_H_
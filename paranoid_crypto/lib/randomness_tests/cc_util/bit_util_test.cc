@@ -0,0 +1,115 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/bit_util.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+int BitAt(const std::vector<uint8_t>& seq, int j) {
+  return (seq[j / 8] >> (j % 8)) & 1;
+}
+
+int BitAt(const std::string& s, int j) {
+  return (static_cast<uint8_t>(s[j / 8]) >> (j % 8)) & 1;
+}
+
+std::vector<uint8_t> PRandBytes(int size) {
+  std::vector<uint8_t> seq(size);
+  for (int j = 0; j < size; j++) {
+    seq[j] = ((j * j * 57641) % 67723) & 255;
+  }
+  return seq;
+}
+
+TEST(BitUtil, SplitBlocks) {
+  std::vector<uint8_t> seq = PRandBytes(40);
+  for (int m : {1, 3, 8, 9, 64, 100}) {
+    for (int n : {0, 17, 320}) {
+      std::string blocks = SplitBlocks(seq.data(), seq.size(), n, m);
+      int num_blocks = n / m;
+      size_t bytes_per_block = (m + 7) / 8;
+      ASSERT_EQ(bytes_per_block * num_blocks, blocks.size()) << m << " " << n;
+      for (int i = 0; i < num_blocks; i++) {
+        for (int j = 0; j < m; j++) {
+          EXPECT_EQ(BitAt(seq, i * m + j),
+                    (static_cast<uint8_t>(
+                         blocks[i * bytes_per_block + j / 8]) >>
+                     (j % 8)) &
+                        1)
+              << m << " " << n << " " << i << " " << j;
+        }
+        // Padding bits of the last byte of a block must be zero.
+        for (int j = m; j < 8 * static_cast<int>(bytes_per_block); j++) {
+          EXPECT_EQ(0, (static_cast<uint8_t>(
+                            blocks[i * bytes_per_block + j / 8]) >>
+                        (j % 8)) &
+                           1);
+        }
+      }
+    }
+  }
+  EXPECT_TRUE(SplitBlocks(seq.data(), seq.size(), 400, 0).empty());
+  EXPECT_TRUE(SplitBlocks(seq.data(), seq.size(), 8 * 40 + 1, 8).empty());
+}
+
+TEST(BitUtil, ScatterBits) {
+  std::vector<uint8_t> seq = PRandBytes(25);
+  for (int m : {1, 2, 7, 16}) {
+    int n = 171;
+    std::vector<std::string> streams = ScatterBits(seq.data(), seq.size(), n,
+                                                   m);
+    ASSERT_EQ(m, streams.size());
+    for (int k = 0; k < n; k++) {
+      EXPECT_EQ(BitAt(seq, k), BitAt(streams[k % m], k / m)) << m << " " << k;
+    }
+  }
+  EXPECT_TRUE(ScatterBits(seq.data(), seq.size(), 171, 0).empty());
+}
+
+TEST(BitUtil, ReverseBits) {
+  std::vector<uint8_t> seq = PRandBytes(25);
+  for (int n : {1, 7, 8, 171, 200}) {
+    std::string rev = ReverseBits(seq.data(), seq.size(), n);
+    ASSERT_EQ((n + 7) / 8, rev.size()) << n;
+    for (int j = 0; j < n; j++) {
+      EXPECT_EQ(BitAt(seq, n - 1 - j), BitAt(rev, j)) << n << " " << j;
+    }
+    // Reversing twice is the identity.
+    std::string rev2 = ReverseBits(
+        reinterpret_cast<const uint8_t*>(rev.data()), rev.size(), n);
+    for (int j = 0; j < n; j++) {
+      EXPECT_EQ(BitAt(seq, j), BitAt(rev2, j)) << n << " " << j;
+    }
+  }
+}
+
+TEST(BitUtil, BitsToSigns) {
+  std::vector<uint8_t> seq = PRandBytes(10);
+  int n = 77;
+  std::string signs = BitsToSigns(seq.data(), seq.size(), n);
+  ASSERT_EQ(n, signs.size());
+  for (int k = 0; k < n; k++) {
+    EXPECT_EQ(BitAt(seq, k) ? 1 : -1, static_cast<signed char>(signs[k]))
+        << k;
+  }
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,101 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/frequency_count.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+#include "paranoid_crypto/lib/randomness_tests/cc_util/template_matching.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// Cumulative counters of the popcount kernel; see kernel_stats.h.
+// FrequencyCount has no counter of its own: it is a thin wrapper whose
+// time is recorded by the TemplateCounts kernel it delegates to.
+KernelStats& BitCountStats() {
+  static KernelStats* stats = new KernelStats("BitCountBlocks");
+  return *stats;
+}
+
+int BitAt(const uint8_t* seq, int j) { return (seq[j >> 3] >> (j & 7)) & 1; }
+
+// Loads 8 consecutive bytes starting at byte_offset as a little endian
+// 64-bit integer. Bytes past the end of the buffer are zero.
+uint64_t LoadWord(const uint8_t* seq, size_t size, size_t byte_offset) {
+  uint64_t word = 0;
+  size_t count = std::min<size_t>(8, size - std::min(size, byte_offset));
+  for (size_t i = 0; i < count; i++) {
+    word |= static_cast<uint64_t>(seq[byte_offset + i]) << (8 * i);
+  }
+  return word;
+}
+
+}  // namespace
+
+std::vector<int64_t> FrequencyCount(const uint8_t* seq, size_t size, int n,
+                                    int m, bool wrap) {
+  // The subsequences that do not wrap around are counted by the sliding
+  // window of the template matching kernel.
+  std::vector<int64_t> counts = TemplateCounts(seq, size, n, m);
+  if (counts.empty() || !wrap) {
+    return counts;
+  }
+  // The m - 1 wrapping subsequences consist of the i least significant
+  // bits of the last m bits followed by the first m - i bits.
+  uint64_t w = 0;
+  for (int t = 0; t < m; t++) {
+    w |= static_cast<uint64_t>(BitAt(seq, n - m + t)) << t;
+    w |= static_cast<uint64_t>(BitAt(seq, t)) << (m + t);
+  }
+  const uint64_t mask = (uint64_t{1} << m) - 1;
+  for (int i = 1; i < m; i++) {
+    counts[(w >> i) & mask]++;
+  }
+  return counts;
+}
+
+std::vector<int64_t> BitCountBlocks(const uint8_t* seq, size_t size, int n,
+                                    int m) {
+  if (m < 1 || n < 0 || static_cast<size_t>(n) > 8 * size) {
+    return std::vector<int64_t>();
+  }
+  ScopedKernelTimer timer(&BitCountStats(), (n + 7) / 8);
+  int num_blocks = n / m;
+  std::vector<int64_t> counts(num_blocks);
+  int64_t pos = 0;
+  for (int i = 0; i < num_blocks; i++) {
+    int64_t count = 0;
+    int remaining = m;
+    while (remaining > 0) {
+      // Up to 64 - pos % 8 bits of the block are loaded per word.
+      uint64_t word = LoadWord(seq, size, pos >> 3) >> (pos & 7);
+      int take = std::min<int>(64 - (pos & 7), remaining);
+      if (take < 64) {
+        word &= (uint64_t{1} << take) - 1;
+      }
+      count += __builtin_popcountll(word);
+      pos += take;
+      remaining -= take;
+    }
+    counts[i] = count;
+  }
+  return counts;
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,49 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_FREQUENCY_COUNT_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_FREQUENCY_COUNT_H_
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Counting kernels shared by the Serial, ApproximateEntropy and
+// BlockFrequency tests. The sequences use the little endian bit
+// representation of this directory: bit j is (seq[j / 8] >> (j % 8)) & 1.
+
+// Counts the number of occurrences of the m-bit subsequences among the
+// first n bits, with the semantics of util.FrequencyCount: element i of
+// the result is the number of positions j where bits j .. j + m - 1 equal
+// i, bit j being the least significant bit of i. If wrap is true then the
+// sequence is treated as a loop, so that there are n subsequences and the
+// last m - 1 of them wrap around to the first bits. The histograms for all
+// smaller values of m follow by summing pairs of adjacent counts, as in
+// nist_suite.Serial, hence one pass serves every block size of a test.
+// Returns an empty vector if the parameters are inconsistent (m < 1,
+// m > n, m > 24 or n > 8 * size).
+std::vector<int64_t> FrequencyCount(const uint8_t* seq, size_t size, int n,
+                                    int m, bool wrap);
+
+// Counts the 1 bits of each of the n / m non-overlapping m-bit blocks of
+// the first n bits, using word popcounts. A partial last block is ignored,
+// as in util.SplitSequence. Returns an empty vector if the parameters are
+// inconsistent (m < 1 or n > 8 * size).
+std::vector<int64_t> BitCountBlocks(const uint8_t* seq, size_t size, int n,
+                                    int m);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_FREQUENCY_COUNT_H_
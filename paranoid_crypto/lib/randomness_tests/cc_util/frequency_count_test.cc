@@ -0,0 +1,107 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/frequency_count.h"
+
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+int BitAt(const std::vector<uint8_t>& seq, int j) {
+  return (seq[j / 8] >> (j % 8)) & 1;
+}
+
+std::vector<uint8_t> PRandBytes(int size) {
+  std::vector<uint8_t> seq(size);
+  for (int j = 0; j < size; j++) {
+    seq[j] = ((j * j * 50753) % 65777) & 255;
+  }
+  return seq;
+}
+
+// Counts the m-bit subsequences one bit at a time.
+std::vector<int64_t> RefCounts(const std::vector<uint8_t>& seq, int n, int m,
+                               bool wrap) {
+  std::vector<int64_t> counts(1 << m);
+  int num_windows = wrap ? n : n - m + 1;
+  for (int j = 0; j < num_windows; j++) {
+    int w = 0;
+    for (int t = 0; t < m; t++) {
+      w |= BitAt(seq, (j + t) % n) << t;
+    }
+    counts[w]++;
+  }
+  return counts;
+}
+
+TEST(FrequencyCount, CompareWithReference) {
+  std::vector<uint8_t> seq = PRandBytes(80);
+  for (bool wrap : {false, true}) {
+    for (int m : {1, 2, 3, 8, 13}) {
+      for (int n : {m, 17, 171, 640}) {
+        EXPECT_EQ(RefCounts(seq, n, m, wrap),
+                  FrequencyCount(seq.data(), seq.size(), n, m, wrap))
+            << wrap << " " << m << " " << n;
+      }
+    }
+  }
+}
+
+TEST(FrequencyCount, Tv) {
+  // The bit string 110 read from the least significant bit, as a loop.
+  std::vector<uint8_t> seq = {0b011};
+  // Windows: 11, 10 and the wrapping 01.
+  std::vector<int64_t> expected = {0, 1, 1, 1};
+  EXPECT_EQ(expected, FrequencyCount(seq.data(), seq.size(), 3, 2, true));
+  // Without wrapping the last window is dropped.
+  std::vector<int64_t> expected_nowrap = {0, 1, 0, 1};
+  EXPECT_EQ(expected_nowrap,
+            FrequencyCount(seq.data(), seq.size(), 3, 2, false));
+}
+
+TEST(FrequencyCount, InvalidParameters) {
+  std::vector<uint8_t> seq = PRandBytes(8);
+  EXPECT_TRUE(FrequencyCount(seq.data(), seq.size(), 64, 0, true).empty());
+  EXPECT_TRUE(FrequencyCount(seq.data(), seq.size(), 64, 25, true).empty());
+  EXPECT_TRUE(FrequencyCount(seq.data(), seq.size(), 3, 4, true).empty());
+  EXPECT_TRUE(FrequencyCount(seq.data(), seq.size(), 65, 4, true).empty());
+}
+
+TEST(BitCountBlocks, CompareWithReference) {
+  std::vector<uint8_t> seq = PRandBytes(80);
+  for (int m : {1, 3, 8, 20, 64, 100, 640}) {
+    for (int n : {0, 17, 171, 640}) {
+      std::vector<int64_t> expected;
+      for (int i = 0; i + m <= n; i += m) {
+        int64_t count = 0;
+        for (int t = 0; t < m; t++) count += BitAt(seq, i + t);
+        expected.push_back(count);
+      }
+      EXPECT_EQ(expected, BitCountBlocks(seq.data(), seq.size(), n, m))
+          << m << " " << n;
+    }
+  }
+}
+
+TEST(BitCountBlocks, InvalidParameters) {
+  std::vector<uint8_t> seq = PRandBytes(8);
+  EXPECT_TRUE(BitCountBlocks(seq.data(), seq.size(), 64, 0).empty());
+  EXPECT_TRUE(BitCountBlocks(seq.data(), seq.size(), 65, 8).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,89 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+
+#include <mutex>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// The registry of this shared object. Registration happens only during the
+// construction of function local statics, so the mutex is essentially
+// uncontended; the hot path (Record) never takes it.
+std::mutex& RegistryMutex() {
+  static std::mutex* mutex = new std::mutex;
+  return *mutex;
+}
+
+std::vector<KernelStats*>& Registry() {
+  static std::vector<KernelStats*>* registry = new std::vector<KernelStats*>;
+  return *registry;
+}
+
+}  // namespace
+
+KernelStats::KernelStats(const char* name)
+    : name_(name), variant_(nullptr), calls_(0), nanos_(0), bytes_(0) {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  Registry().push_back(this);
+}
+
+void KernelStats::Record(int64_t nanos, int64_t bytes) {
+  calls_.fetch_add(1, std::memory_order_relaxed);
+  nanos_.fetch_add(nanos, std::memory_order_relaxed);
+  bytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void KernelStats::SetVariant(const char* variant) {
+  variant_.store(variant, std::memory_order_relaxed);
+}
+
+KernelStatsSnapshot KernelStats::Snapshot() const {
+  KernelStatsSnapshot snapshot;
+  snapshot.name = name_;
+  const char* variant = variant_.load(std::memory_order_relaxed);
+  snapshot.variant = variant == nullptr ? "" : variant;
+  snapshot.calls = calls_.load(std::memory_order_relaxed);
+  snapshot.nanos = nanos_.load(std::memory_order_relaxed);
+  snapshot.bytes = bytes_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+void KernelStats::Reset() {
+  calls_.store(0, std::memory_order_relaxed);
+  nanos_.store(0, std::memory_order_relaxed);
+  bytes_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<KernelStatsSnapshot> AllKernelStats() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  std::vector<KernelStatsSnapshot> snapshots;
+  snapshots.reserve(Registry().size());
+  for (const KernelStats* stats : Registry()) {
+    snapshots.push_back(stats->Snapshot());
+  }
+  return snapshots;
+}
+
+void ResetAllKernelStats() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  for (KernelStats* stats : Registry()) {
+    stats->Reset();
+  }
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,124 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_KERNEL_STATS_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_KERNEL_STATS_H_
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Cumulative instrumentation counters for the native kernels in this
+// directory. Each kernel owns one KernelStats instance and records, per
+// call of its public entry point, the wall time and the number of input
+// bytes it processed. The counters are plain relaxed atomics and a kernel
+// records once per language transition rather than once per block, so the
+// overhead is a clock read and a few atomic additions per call; the
+// instrumentation stays enabled in production builds.
+//
+// Each pybind extension is a separate shared object with its own copies of
+// these counters, so an extension only sees the kernels compiled into it.
+// The bindings expose the per-extension view (see pybind/kernel_stats.h)
+// and randomness_tests/kernel_stats.py aggregates the views of all kernel
+// modules into one report.
+
+// A consistent-enough copy of the counters of one kernel. The fields are
+// read individually from the atomics, so a snapshot taken while other
+// threads record may be off by the calls in flight; for throughput
+// reporting this is irrelevant.
+struct KernelStatsSnapshot {
+  // The kernel name, e.g. "LfsrLength".
+  std::string name;
+  // The dispatch variant the kernel resolved to, e.g. "clmul". Empty for
+  // kernels with a single implementation or before the first call resolves
+  // the dispatch.
+  std::string variant;
+  // The number of recorded calls.
+  int64_t calls;
+  // The cumulative wall time of the recorded calls in nanoseconds.
+  int64_t nanos;
+  // The cumulative number of input bytes processed.
+  int64_t bytes;
+};
+
+// The counters of one kernel. Instances register themselves in a process
+// wide (per shared object) registry on construction and must never be
+// destroyed; the kernels keep them as function local statics with leaked
+// storage.
+class KernelStats {
+ public:
+  // name must point to a string with static storage duration.
+  explicit KernelStats(const char* name);
+  KernelStats(const KernelStats&) = delete;
+  KernelStats& operator=(const KernelStats&) = delete;
+
+  // Adds one call of nanos wall nanoseconds over bytes input bytes.
+  void Record(int64_t nanos, int64_t bytes);
+
+  // Names the dispatch variant the kernel selected, e.g. "clmul". variant
+  // must point to a string with static storage duration. Called by the
+  // dispatch code when it resolves, typically once at the first call.
+  void SetVariant(const char* variant);
+
+  KernelStatsSnapshot Snapshot() const;
+
+  // Resets the counters to zero. The variant is kept, since the dispatch
+  // does not resolve again.
+  void Reset();
+
+ private:
+  const char* const name_;
+  std::atomic<const char*> variant_;
+  std::atomic<int64_t> calls_;
+  std::atomic<int64_t> nanos_;
+  std::atomic<int64_t> bytes_;
+};
+
+// Records one call on a KernelStats with the wall time of its own scope.
+// Usage, at the top of a kernel entry point:
+//   ScopedKernelTimer timer(&Stats(), buffer.size());
+class ScopedKernelTimer {
+ public:
+  ScopedKernelTimer(KernelStats* stats, int64_t bytes)
+      : stats_(stats), bytes_(bytes),
+        start_(std::chrono::steady_clock::now()) {}
+  ScopedKernelTimer(const ScopedKernelTimer&) = delete;
+  ScopedKernelTimer& operator=(const ScopedKernelTimer&) = delete;
+  ~ScopedKernelTimer() {
+    stats_->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start_)
+                       .count(),
+                   bytes_);
+  }
+
+ private:
+  KernelStats* const stats_;
+  const int64_t bytes_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+// Snapshots of all kernels of this shared object, in registration order.
+// A kernel registers itself at its first call, so kernels that never ran
+// may be missing from the result.
+std::vector<KernelStatsSnapshot> AllKernelStats();
+
+// Resets the counters of all kernels of this shared object.
+void ResetAllKernelStats();
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_KERNEL_STATS_H_
@@ -0,0 +1,97 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+// Instances register themselves for the lifetime of the process, so the
+// tests share a few leaked instances instead of creating new ones per run.
+KernelStats& TestStats() {
+  static KernelStats* stats = new KernelStats("KernelStatsTest");
+  return *stats;
+}
+
+KernelStatsSnapshot FindSnapshot(const std::string& name) {
+  for (const KernelStatsSnapshot& s : AllKernelStats()) {
+    if (s.name == name) {
+      return s;
+    }
+  }
+  ADD_FAILURE() << "kernel not registered: " << name;
+  return KernelStatsSnapshot();
+}
+
+TEST(KernelStatsTest, RecordAccumulates) {
+  KernelStats& stats = TestStats();
+  stats.Reset();
+  stats.Record(1000, 64);
+  stats.Record(500, 36);
+  KernelStatsSnapshot s = stats.Snapshot();
+  EXPECT_EQ(s.name, "KernelStatsTest");
+  EXPECT_EQ(s.calls, 2);
+  EXPECT_EQ(s.nanos, 1500);
+  EXPECT_EQ(s.bytes, 100);
+}
+
+TEST(KernelStatsTest, ResetKeepsVariant) {
+  KernelStats& stats = TestStats();
+  stats.Record(1000, 64);
+  stats.SetVariant("vectorized");
+  stats.Reset();
+  KernelStatsSnapshot s = stats.Snapshot();
+  EXPECT_EQ(s.calls, 0);
+  EXPECT_EQ(s.nanos, 0);
+  EXPECT_EQ(s.bytes, 0);
+  EXPECT_EQ(s.variant, "vectorized");
+}
+
+TEST(KernelStatsTest, ScopedTimerRecordsOneCall) {
+  KernelStats& stats = TestStats();
+  stats.Reset();
+  { ScopedKernelTimer timer(&stats, 1 << 20); }
+  KernelStatsSnapshot s = stats.Snapshot();
+  EXPECT_EQ(s.calls, 1);
+  EXPECT_GE(s.nanos, 0);
+  EXPECT_EQ(s.bytes, 1 << 20);
+}
+
+TEST(KernelStatsTest, RegistryListsRegisteredKernels) {
+  KernelStats& stats = TestStats();
+  stats.Reset();
+  stats.Record(2000, 128);
+  KernelStatsSnapshot s = FindSnapshot("KernelStatsTest");
+  EXPECT_EQ(s.calls, 1);
+  EXPECT_EQ(s.nanos, 2000);
+  EXPECT_EQ(s.bytes, 128);
+}
+
+TEST(KernelStatsTest, ResetAllClearsCounters) {
+  KernelStats& stats = TestStats();
+  stats.Record(2000, 128);
+  ResetAllKernelStats();
+  KernelStatsSnapshot s = FindSnapshot("KernelStatsTest");
+  EXPECT_EQ(s.calls, 0);
+  EXPECT_EQ(s.nanos, 0);
+  EXPECT_EQ(s.bytes, 0);
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
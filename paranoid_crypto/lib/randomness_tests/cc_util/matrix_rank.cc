@@ -0,0 +1,122 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/matrix_rank.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// Cumulative counters of the rank kernel; see kernel_stats.h. A batch call
+// records once for all its matrices.
+KernelStats &Stats() {
+  static KernelStats *stats = new KernelStats("BinaryMatrixRank");
+  return *stats;
+}
+
+// Computes the rank of a matrix of rows packed rows, each words_per_row
+// little endian 64-bit words wide. The matrix is destroyed. This is the
+// same elimination as util._BinaryMatrixRankSmall in the Python code: each
+// nonzero row becomes a pivot for its most significant bit, which is then
+// cleared from all later rows with word-wide xors.
+int RankPacked(std::vector<uint64_t> *m, int rows, int words_per_row) {
+  int rank = 0;
+  for (int i = 0; i < rows; i++) {
+    uint64_t *row_i = m->data() + i * words_per_row;
+    int msw = -1;
+    for (int k = words_per_row - 1; k >= 0; k--) {
+      if (row_i[k] != 0) {
+        msw = k;
+        break;
+      }
+    }
+    if (msw < 0) {
+      continue;
+    }
+    rank++;
+    int msb = 63 - __builtin_clzll(row_i[msw]);
+    for (int j = i + 1; j < rows; j++) {
+      uint64_t *row_j = m->data() + j * words_per_row;
+      if ((row_j[msw] >> msb) & 1) {
+        for (int k = 0; k <= msw; k++) {
+          row_j[k] ^= row_i[k];
+        }
+      }
+    }
+  }
+  return rank;
+}
+
+// Packs the rows of one matrix from the byte representation into words.
+void PackMatrix(const uint8_t *bytes, int rows, size_t bytes_per_row,
+                int words_per_row, std::vector<uint64_t> *m) {
+  m->assign(rows * words_per_row, 0);
+  for (int i = 0; i < rows; i++) {
+    uint64_t *row = m->data() + i * words_per_row;
+    const uint8_t *src = bytes + i * bytes_per_row;
+    for (size_t j = 0; j < bytes_per_row; j++) {
+      row[j / 8] ^= static_cast<uint64_t>(src[j]) << (8 * (j & 7));
+    }
+  }
+}
+
+}  // namespace
+
+int BinaryMatrixRank(const std::string &buffer, int rows, int cols) {
+  if (rows < 0 || cols <= 0) {
+    return -1;
+  }
+  size_t bytes_per_row = (cols + 7) / 8;
+  if (buffer.size() < bytes_per_row * rows) {
+    return -1;
+  }
+  ScopedKernelTimer timer(&Stats(), bytes_per_row * rows);
+  int words_per_row = (cols + 63) / 64;
+  std::vector<uint64_t> m;
+  PackMatrix(reinterpret_cast<const uint8_t *>(buffer.data()), rows,
+             bytes_per_row, words_per_row, &m);
+  return RankPacked(&m, rows, words_per_row);
+}
+
+std::vector<int> BinaryMatrixRankBatch(const std::string &buffer, int rows,
+                                       int cols, int num_matrices) {
+  if (rows < 0 || cols <= 0 || num_matrices < 0) {
+    return {};
+  }
+  size_t bytes_per_row = (cols + 7) / 8;
+  size_t bytes_per_matrix = bytes_per_row * rows;
+  if (buffer.size() < bytes_per_matrix * num_matrices) {
+    return {};
+  }
+  ScopedKernelTimer timer(&Stats(), bytes_per_matrix * num_matrices);
+  int words_per_row = (cols + 63) / 64;
+  std::vector<int> ranks(num_matrices);
+  // The packed matrix is allocated once and reused for all matrices.
+  std::vector<uint64_t> m;
+  for (int i = 0; i < num_matrices; i++) {
+    PackMatrix(reinterpret_cast<const uint8_t *>(buffer.data()) +
+                   i * bytes_per_matrix,
+               rows, bytes_per_row, words_per_row, &m);
+    ranks[i] = RankPacked(&m, rows, words_per_row);
+  }
+  return ranks;
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,43 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_MATRIX_RANK_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_MATRIX_RANK_H_
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Computes the rank of a binary matrix over GF(2). The rows are stored back
+// to back in buffer, each row starting at a byte boundary and occupying
+// (cols + 7) / 8 bytes. Within a row the bits are represented using little
+// endian byte ordering, hence bit j of a row is (row[j / 8] >> (j % 8)) & 1.
+// The rows are packed into 64-bit words, so the Gaussian elimination works
+// on whole words instead of single bits.
+// Returns the rank or -1 if the parameters are inconsistent (e.g. buffer is
+// too small).
+int BinaryMatrixRank(const std::string& buffer, int rows, int cols);
+
+// Computes the ranks of num_matrices equally sized binary matrices stored
+// back to back in buffer, each represented as in BinaryMatrixRank. A single
+// call amortizes the cost of the language transition over all matrices;
+// the NIST BinaryMatrixRank test generates hundreds of 32x32 matrices per
+// run. Returns one rank per matrix, or an empty vector if the parameters
+// are inconsistent.
+std::vector<int> BinaryMatrixRankBatch(const std::string& buffer, int rows,
+                                       int cols, int num_matrices);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_MATRIX_RANK_H_
@@ -0,0 +1,111 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/matrix_rank.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+// Bit-by-bit reference elimination over one row per entry, cols <= 64.
+int RankRef(std::vector<uint64_t> m) {
+  int rank = 0;
+  for (size_t i = 0; i < m.size(); i++) {
+    if (m[i] == 0) continue;
+    rank++;
+    uint64_t msb = m[i];
+    while (msb & (msb - 1)) msb &= msb - 1;
+    for (size_t j = i + 1; j < m.size(); j++) {
+      if (m[j] & msb) m[j] ^= m[i];
+    }
+  }
+  return rank;
+}
+
+std::string PackRows(const std::vector<uint64_t>& rows, int cols) {
+  int bytes_per_row = (cols + 7) / 8;
+  std::string buffer;
+  for (uint64_t row : rows) {
+    for (int j = 0; j < bytes_per_row; j++) {
+      buffer.push_back(static_cast<char>((row >> (8 * j)) & 255));
+    }
+  }
+  return buffer;
+}
+
+TEST(MatrixRank, Tv) {
+  EXPECT_EQ(0, BinaryMatrixRank(PackRows({0, 0, 0, 0}, 4), 4, 4));
+  EXPECT_EQ(1, BinaryMatrixRank(PackRows({0, 0b1101, 0, 0b1101}, 4), 4, 4));
+  EXPECT_EQ(3, BinaryMatrixRank(PackRows({0b011, 0b101, 0b111}, 3), 3, 3));
+  std::vector<uint64_t> counting(16);
+  for (int i = 0; i < 16; i++) counting[i] = i;
+  EXPECT_EQ(4, BinaryMatrixRank(PackRows(counting, 4), 16, 4));
+}
+
+TEST(MatrixRank, Compare) {
+  // Compares the word-packed elimination against a bit reference for
+  // column counts on both sides of the word boundary.
+  for (int cols : {1, 7, 31, 32, 63, 64}) {
+    for (int rows : {1, 5, 32, 70}) {
+      std::vector<uint64_t> m(rows);
+      for (int i = 0; i < rows; i++) {
+        uint64_t row = 0;
+        for (int j = 0; j < 8; j++) {
+          row ^= static_cast<uint64_t>(((i * 8 + j + cols) * 57641) % 67723)
+                 << (8 * j);
+        }
+        if (cols < 64) row &= (1ull << cols) - 1;
+        m[i] = row;
+      }
+      EXPECT_EQ(RankRef(m), BinaryMatrixRank(PackRows(m, cols), rows, cols))
+          << rows << " " << cols;
+    }
+  }
+}
+
+TEST(MatrixRank, WideMatrix) {
+  // A matrix wider than one word: 128 columns, identity in the high word.
+  int cols = 128;
+  std::string buffer;
+  for (int i = 0; i < 32; i++) {
+    std::string row(16, 0);
+    row[8 + i / 8] = static_cast<char>(1 << (i % 8));
+    buffer += row;
+  }
+  EXPECT_EQ(32, BinaryMatrixRank(buffer, 32, cols));
+  // Duplicated rows do not increase the rank.
+  EXPECT_EQ(32, BinaryMatrixRank(buffer + buffer, 64, cols));
+}
+
+TEST(MatrixRank, Batch) {
+  std::vector<uint64_t> m1 = {0b011, 0b101, 0b111};
+  std::vector<uint64_t> m2 = {0b001, 0b001, 0b000};
+  std::string buffer = PackRows(m1, 3) + PackRows(m2, 3);
+  std::vector<int> ranks = BinaryMatrixRankBatch(buffer, 3, 3, 2);
+  EXPECT_EQ(std::vector<int>({3, 1}), ranks);
+}
+
+TEST(MatrixRank, InvalidParameters) {
+  EXPECT_EQ(-1, BinaryMatrixRank(std::string(3, 'a'), 4, 8));
+  EXPECT_EQ(-1, BinaryMatrixRank(std::string(3, 'a'), 3, 0));
+  EXPECT_EQ(-1, BinaryMatrixRank(std::string(3, 'a'), -1, 8));
+  EXPECT_TRUE(BinaryMatrixRankBatch(std::string(8, 'a'), 4, 8, 3).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
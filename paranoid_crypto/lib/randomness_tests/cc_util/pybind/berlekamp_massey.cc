@@ -14,10 +14,57 @@
 
 #include "paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey.h"
 
+#include "paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h"
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
 namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
 
-PYBIND11_MODULE(berlekamp_massey, m) { m.def("LfsrLength", LfsrLengthStr); }
+namespace py = pybind11;
+
+// Reads the sequence through the buffer protocol, so that bytes, bytearray,
+// memoryview and numpy arrays are accepted without copying their contents.
+// The buffer must be one-dimensional and contiguous; it is interpreted as
+// raw little endian bytes regardless of the element type.
+int LfsrLengthBuffer(const py::buffer& seq, int n) {
+  py::buffer_info info = seq.request();
+  if (info.ndim != 1 ||
+      (!info.strides.empty() && info.strides[0] != info.itemsize)) {
+    throw py::type_error("expected a contiguous one-dimensional buffer");
+  }
+  // The buffer must be requested and released while holding the GIL, but
+  // the computation itself is pure C++ and can run without it.
+  py::gil_scoped_release release;
+  return LfsrLengthRaw(static_cast<const uint8_t*>(info.ptr),
+                       info.size * info.itemsize, n);
+}
+
+// Variant of LfsrLengthBuffer that reuses the buffers owned by scratch.
+int LfsrLengthWithScratch(LfsrScratch& scratch, const py::buffer& seq, int n) {
+  py::buffer_info info = seq.request();
+  if (info.ndim != 1 ||
+      (!info.strides.empty() && info.strides[0] != info.itemsize)) {
+    throw py::type_error("expected a contiguous one-dimensional buffer");
+  }
+  py::gil_scoped_release release;
+  return LfsrLengthRaw(static_cast<const uint8_t*>(info.ptr),
+                       info.size * info.itemsize, n, &scratch);
+}
+
+PYBIND11_MODULE(berlekamp_massey, m) {
+  py::class_<LfsrScratch>(m, "LfsrScratch")
+      .def(py::init<>())
+      .def("LfsrLength", LfsrLengthWithScratch);
+  m.def("LfsrLength", LfsrLengthBuffer);
+  m.def("LfsrLength", LfsrLengthStr,
+        py::call_guard<py::gil_scoped_release>());
+  m.def("LfsrProfile", LfsrProfileStr,
+        py::call_guard<py::gil_scoped_release>());
+  m.def("LfsrLengthBatch", LfsrLengthBatch,
+        py::call_guard<py::gil_scoped_release>());
+  m.def("LfsrLengthBatchParallel", LfsrLengthBatchParallel,
+        py::call_guard<py::gil_scoped_release>());
+  AddKernelStatsBindings(m);
+}
 
 }  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
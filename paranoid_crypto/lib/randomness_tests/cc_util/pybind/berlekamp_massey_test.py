@@ -53,6 +53,72 @@ class BerlekampMasseyTest(absltest.TestCase):
     with self.assertRaises(TypeError):
       berlekamp_massey.LfsrLength(bytes(8), 2**32 + 8)
 
+  def testBufferTypes(self):
+    """The binding accepts any contiguous buffer, not just bytes."""
+    for seq, n, lfsr_len in self.KTV:
+      byte_size = (n + 7) // 8
+      ba = seq.to_bytes(byte_size, "little")
+      self.assertEqual(lfsr_len, berlekamp_massey.LfsrLength(bytearray(ba), n))
+      self.assertEqual(lfsr_len,
+                       berlekamp_massey.LfsrLength(memoryview(ba), n))
+
+  def testBufferAligned(self):
+    """Word sized inputs take the zero-copy path."""
+    seq = 12345
+    ba = seq.to_bytes(16, "little")
+    self.assertEqual(7, berlekamp_massey.LfsrLength(ba, 14))
+    self.assertEqual(7, berlekamp_massey.LfsrLength(bytearray(ba), 14))
+
+  def testScratch(self):
+    """A scratch handle returns the same results as the stateless calls."""
+    scratch = berlekamp_massey.LfsrScratch()
+    for seq, n, lfsr_len in self.KTV:
+      byte_size = (n + 7) // 8
+      ba = seq.to_bytes(byte_size, "little")
+      self.assertEqual(lfsr_len, scratch.LfsrLength(ba, n))
+    self.assertEqual(-1, scratch.LfsrLength(bytes(8), 65))
+
+  def testProfile(self):
+    for seq, n, lfsr_len in self.KTV:
+      byte_size = (n + 7) // 8
+      ba = seq.to_bytes(byte_size, "little")
+      profile = berlekamp_massey.LfsrProfile(ba, n, 1)
+      self.assertLen(profile, n)
+      self.assertEqual(lfsr_len, profile[-1])
+      for k in range(n):
+        self.assertEqual(
+            berlekamp_massey.LfsrLength(ba, k + 1), profile[k])
+
+  def testProfileWrongSize(self):
+    self.assertEqual([], berlekamp_massey.LfsrProfile(bytes(8), 65, 1))
+    self.assertEqual([], berlekamp_massey.LfsrProfile(bytes(8), 64, 0))
+
+  def testBatch(self):
+    for n in (3, 5, 6, 9, 14):
+      cases = [(seq, lfsr_len) for seq, m, lfsr_len in self.KTV if m == n]
+      if not cases:
+        continue
+      byte_size = (n + 7) // 8
+      buffer = b"".join(seq.to_bytes(byte_size, "little") for seq, _ in cases)
+      lengths = berlekamp_massey.LfsrLengthBatch(buffer, n, len(cases))
+      self.assertEqual([lfsr_len for _, lfsr_len in cases], lengths)
+
+  def testBatchParallel(self):
+    n = 512
+    blocks = [(i * 2**384 + i**5 + 1) % 2**n for i in range(64)]
+    buffer = b"".join(b.to_bytes(n // 8, "little") for b in blocks)
+    expected = berlekamp_massey.LfsrLengthBatch(buffer, n, len(blocks))
+    for num_threads in (0, 1, 2, 7):
+      self.assertEqual(
+          expected,
+          berlekamp_massey.LfsrLengthBatchParallel(buffer, n, len(blocks),
+                                                   num_threads))
+
+  def testBatchWrongSize(self):
+    self.assertEqual([], berlekamp_massey.LfsrLengthBatch(bytes(8), 0, 1))
+    self.assertEqual([], berlekamp_massey.LfsrLengthBatch(bytes(8), 64, 2))
+    self.assertEqual([], berlekamp_massey.LfsrLengthBatch(bytes(8), 65, 1))
+
   def testWrongType(self):
     with self.assertRaises(TypeError):
       berlekamp_massey.LfsrLength(12345, 22)
@@ -0,0 +1,57 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/bias.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h"
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// The binding releases the GIL for the computation and builds the result
+// as a list of bytes explicitly, since letting pybind convert std::string
+// would produce str objects. Integers are unsigned little endian byte
+// strings as produced by int.to_bytes; see bias.h.
+py::list BiasSumsBinding(
+    const std::vector<std::string>& sample, const std::string& n,
+    const std::vector<std::pair<std::string, std::string>>& transforms) {
+  std::vector<std::string> res;
+  {
+    py::gil_scoped_release release;
+    res = BiasSums(sample, n, transforms);
+  }
+  py::list result;
+  for (const std::string& value : res) {
+    result.append(py::bytes(value));
+  }
+  return result;
+}
+
+}  // namespace
+
+PYBIND11_MODULE(bias, m) {
+  m.def("BiasSums", BiasSumsBinding);
+  AddKernelStatsBindings(m);
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
@@ -0,0 +1,62 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests the pybind bindings of the bias statistic kernel."""
+
+import random
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import bias
+
+
+def RefBiasSums(sample: list[int], n: int,
+                transforms: list[tuple[int, int]]) -> list[int]:
+  """The statistic of lattice_suite.Bias, per transform."""
+  sums = []
+  for a, b in transforms:
+    t = 0
+    for s in sample:
+      v = (a * s + b) % n
+      t += min(v, n - v)
+    sums.append(t)
+  return sums
+
+
+class BiasTest(absltest.TestCase):
+
+  def testKnownAnswer(self):
+    sums = bias.BiasSums([bytes([1]), bytes([7]), bytes([9])], bytes([10]),
+                         [(bytes([3]), bytes([2])), (bytes([1]), bytes([0]))])
+    self.assertEqual([9, 5], [int.from_bytes(t, "little") for t in sums])
+
+  def testCompareWithReference(self):
+    rand = random.Random(987654321)
+    n = 2**256
+    size = (n.bit_length() + 7) // 8
+    sample = [rand.randrange(n) for _ in range(100)]
+    transforms = [(rand.randrange(n), rand.randrange(n)) for _ in range(10)]
+    sums = bias.BiasSums(
+        [s.to_bytes(size, "little") for s in sample],
+        n.to_bytes(size, "little"),
+        [(a.to_bytes(size, "little"), b.to_bytes(size, "little"))
+         for a, b in transforms])
+    self.assertEqual(
+        RefBiasSums(sample, n, transforms),
+        [int.from_bytes(t, "little") for t in sums])
+
+  def testZeroModulus(self):
+    self.assertEmpty(
+        bias.BiasSums([bytes([1])], bytes([0]), [(bytes([1]), bytes([0]))]))
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -0,0 +1,97 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/bit_util.h"
+
+#include "pybind11/pybind11.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// Reads the sequence through the buffer protocol, as in the
+// berlekamp_massey binding: bytes, bytearray, memoryview and numpy arrays
+// are accepted without copying their contents.
+const uint8_t* BufferData(const py::buffer_info& info) {
+  if (info.ndim != 1 ||
+      (!info.strides.empty() && info.strides[0] != info.itemsize)) {
+    throw py::type_error("expected a contiguous one-dimensional buffer");
+  }
+  return static_cast<const uint8_t*>(info.ptr);
+}
+
+py::bytes SplitBlocksBinding(const py::buffer& seq, int n, int m) {
+  py::buffer_info info = seq.request();
+  const uint8_t* data = BufferData(info);
+  size_t size = info.size * info.itemsize;
+  std::string out;
+  {
+    py::gil_scoped_release release;
+    out = SplitBlocks(data, size, n, m);
+  }
+  return py::bytes(out);
+}
+
+py::list ScatterBitsBinding(const py::buffer& seq, int n, int m) {
+  py::buffer_info info = seq.request();
+  const uint8_t* data = BufferData(info);
+  size_t size = info.size * info.itemsize;
+  std::vector<std::string> out;
+  {
+    py::gil_scoped_release release;
+    out = ScatterBits(data, size, n, m);
+  }
+  py::list result;
+  for (const std::string& stream : out) {
+    result.append(py::bytes(stream));
+  }
+  return result;
+}
+
+py::bytes ReverseBitsBinding(const py::buffer& seq, int n) {
+  py::buffer_info info = seq.request();
+  const uint8_t* data = BufferData(info);
+  size_t size = info.size * info.itemsize;
+  std::string out;
+  {
+    py::gil_scoped_release release;
+    out = ReverseBits(data, size, n);
+  }
+  return py::bytes(out);
+}
+
+py::bytes BitsToSignsBinding(const py::buffer& seq, int n) {
+  py::buffer_info info = seq.request();
+  const uint8_t* data = BufferData(info);
+  size_t size = info.size * info.itemsize;
+  std::string out;
+  {
+    py::gil_scoped_release release;
+    out = BitsToSigns(data, size, n);
+  }
+  return py::bytes(out);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(bit_util, m) {
+  m.def("SplitBlocks", SplitBlocksBinding);
+  m.def("ScatterBits", ScatterBitsBinding);
+  m.def("ReverseBits", ReverseBitsBinding);
+  m.def("BitsToSigns", BitsToSignsBinding);
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
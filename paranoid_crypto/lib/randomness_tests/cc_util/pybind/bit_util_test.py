@@ -0,0 +1,67 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import bit_util
+
+
+class BitUtilTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/randomness_tests/cc_util/bit_util_test.cc
+  The tests comparing the C++ version with the native python code are in
+    paranoid_crypto/lib/randomness_tests/util_test.py
+  """
+
+  def testSplitBlocks(self):
+    seq = 0b10011100101
+    ba = seq.to_bytes(2, "little")
+    blocks = bit_util.SplitBlocks(ba, 11, 3)
+    self.assertEqual(bytes([0b101, 0b100, 0b011]), blocks)
+
+  def testScatterBits(self):
+    seq = 0b110110110
+    ba = seq.to_bytes(2, "little")
+    streams = bit_util.ScatterBits(ba, 9, 3)
+    self.assertEqual([bytes([0]), bytes([0b111]), bytes([0b111])], streams)
+
+  def testReverseBits(self):
+    seq = 0b1101
+    ba = seq.to_bytes(1, "little")
+    self.assertEqual(bytes([0b1011]), bit_util.ReverseBits(ba, 4))
+
+  def testBitsToSigns(self):
+    seq = 0b101
+    ba = seq.to_bytes(1, "little")
+    self.assertEqual(b"\x01\xff\x01", bit_util.BitsToSigns(ba, 3))
+
+  def testBufferTypes(self):
+    ba = (0b1101).to_bytes(1, "little")
+    self.assertEqual(
+        bit_util.ReverseBits(ba, 4),
+        bit_util.ReverseBits(bytearray(ba), 4))
+    self.assertEqual(
+        bit_util.ReverseBits(ba, 4),
+        bit_util.ReverseBits(memoryview(ba), 4))
+
+  def testWrongSize(self):
+    self.assertEqual(b"", bit_util.SplitBlocks(bytes(2), 17, 3))
+    self.assertEqual([], bit_util.ScatterBits(bytes(2), 17, 3))
+    self.assertEqual(b"", bit_util.ReverseBits(bytes(2), 17))
+    self.assertEqual(b"", bit_util.BitsToSigns(bytes(2), 17))
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -0,0 +1,64 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/frequency_count.h"
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h"
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// Reads the sequence through the buffer protocol, as in the bit_util
+// binding: bytes, bytearray, memoryview and numpy arrays are accepted
+// without copying their contents.
+const uint8_t* BufferData(const py::buffer_info& info) {
+  if (info.ndim != 1 ||
+      (!info.strides.empty() && info.strides[0] != info.itemsize)) {
+    throw py::type_error("expected a contiguous one-dimensional buffer");
+  }
+  return static_cast<const uint8_t*>(info.ptr);
+}
+
+std::vector<int64_t> FrequencyCountBinding(const py::buffer& seq, int n,
+                                           int m, bool wrap) {
+  py::buffer_info info = seq.request();
+  const uint8_t* data = BufferData(info);
+  size_t size = info.size * info.itemsize;
+  py::gil_scoped_release release;
+  return FrequencyCount(data, size, n, m, wrap);
+}
+
+std::vector<int64_t> BitCountBlocksBinding(const py::buffer& seq, int n,
+                                           int m) {
+  py::buffer_info info = seq.request();
+  const uint8_t* data = BufferData(info);
+  size_t size = info.size * info.itemsize;
+  py::gil_scoped_release release;
+  return BitCountBlocks(data, size, n, m);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(frequency_count, m) {
+  m.def("FrequencyCount", FrequencyCountBinding);
+  m.def("BitCountBlocks", BitCountBlocksBinding);
+  AddKernelStatsBindings(m);
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
@@ -0,0 +1,47 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import frequency_count
+
+
+class FrequencyCountTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/randomness_tests/cc_util/frequency_count_test.cc
+  The tests comparing the C++ version with the native python code are in
+    paranoid_crypto/lib/randomness_tests/util_test.py
+  """
+
+  def testFrequencyCount(self):
+    seq = 0b011
+    ba = seq.to_bytes(1, "little")
+    self.assertEqual([0, 1, 1, 1],
+                     frequency_count.FrequencyCount(ba, 3, 2, True))
+    self.assertEqual([0, 1, 0, 1],
+                     frequency_count.FrequencyCount(ba, 3, 2, False))
+
+  def testBitCountBlocks(self):
+    seq = 0b10011100101
+    ba = seq.to_bytes(2, "little")
+    self.assertEqual([2, 1, 2], frequency_count.BitCountBlocks(ba, 11, 3))
+
+  def testWrongSize(self):
+    self.assertEqual([], frequency_count.FrequencyCount(bytes(2), 17, 3, True))
+    self.assertEqual([], frequency_count.BitCountBlocks(bytes(2), 17, 3))
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -0,0 +1,45 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h"
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+#include "pybind11/pybind11.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// Returns one (name, variant, calls, nanos, bytes) tuple per kernel of
+// this extension. Plain tuples instead of a bound class, so that the
+// results of different extensions can be mixed freely on the Python side.
+py::list KernelStatsBinding() {
+  py::list result;
+  for (const KernelStatsSnapshot& s : AllKernelStats()) {
+    result.append(
+        py::make_tuple(s.name, s.variant, s.calls, s.nanos, s.bytes));
+  }
+  return result;
+}
+
+}  // namespace
+
+void AddKernelStatsBindings(pybind11::module_& m) {
+  m.def("KernelStats", KernelStatsBinding);
+  m.def("ResetKernelStats", ResetAllKernelStats);
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
@@ -0,0 +1,31 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_PYBIND_KERNEL_STATS_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_PYBIND_KERNEL_STATS_H_
+
+#include "pybind11/pybind11.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+// Adds the instrumentation accessors KernelStats() and ResetKernelStats()
+// to a kernel module. Each extension is a separate shared object and only
+// sees the counters of the kernels compiled into it; the Python module
+// randomness_tests.kernel_stats aggregates the views of all kernel
+// modules.
+void AddKernelStatsBindings(pybind11::module_& m);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_PYBIND_KERNEL_STATS_H_
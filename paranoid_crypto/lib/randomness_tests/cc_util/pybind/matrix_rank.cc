@@ -0,0 +1,33 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/matrix_rank.h"
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h"
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(matrix_rank, m) {
+  m.def("BinaryMatrixRank", BinaryMatrixRank,
+        py::call_guard<py::gil_scoped_release>());
+  m.def("BinaryMatrixRankBatch", BinaryMatrixRankBatch,
+        py::call_guard<py::gil_scoped_release>());
+  AddKernelStatsBindings(m);
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
@@ -0,0 +1,56 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import matrix_rank
+
+
+def _PackRows(rows: list[int], cols: int) -> bytes:
+  bytes_per_row = (cols + 7) // 8
+  return b"".join(r.to_bytes(bytes_per_row, "little") for r in rows)
+
+
+class MatrixRankTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/randomness_tests/cc_util/matrix_rank_test.cc
+  The tests comparing the C++ version with the native python version are in
+    paranoid_crypto/lib/randomness_tests/util_test.py
+  """
+
+  def testKtv(self):
+    self.assertEqual(
+        1, matrix_rank.BinaryMatrixRank(_PackRows([0, 0b1101, 0, 0b1101], 4),
+                                        4, 4))
+    self.assertEqual(
+        3, matrix_rank.BinaryMatrixRank(_PackRows([0b011, 0b101, 0b111], 3),
+                                        3, 3))
+    self.assertEqual(
+        4, matrix_rank.BinaryMatrixRank(_PackRows(list(range(16)), 4), 16, 4))
+
+  def testBatch(self):
+    buffer = _PackRows([0b011, 0b101, 0b111], 3) + _PackRows([1, 1, 0], 3)
+    self.assertEqual([3, 1],
+                     matrix_rank.BinaryMatrixRankBatch(buffer, 3, 3, 2))
+
+  def testWrongSize(self):
+    self.assertEqual(-1, matrix_rank.BinaryMatrixRank(bytes(3), 4, 8))
+    self.assertEqual(-1, matrix_rank.BinaryMatrixRank(bytes(3), 3, 0))
+    self.assertEqual([],
+                     matrix_rank.BinaryMatrixRankBatch(bytes(8), 4, 8, 3))
+
+
+if __name__ == "__main__":
+  absltest.main()
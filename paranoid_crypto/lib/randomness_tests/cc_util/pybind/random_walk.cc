@@ -0,0 +1,51 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/random_walk.h"
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h"
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// Reads the sequence through the buffer protocol, as in the bit_util
+// binding: bytes, bytearray, memoryview and numpy arrays are accepted
+// without copying their contents.
+std::vector<int64_t> WalkStatsBinding(const py::buffer& seq, int n,
+                                      int max_state, int max_cnt,
+                                      int max_state_variant) {
+  py::buffer_info info = seq.request();
+  if (info.ndim != 1 ||
+      (!info.strides.empty() && info.strides[0] != info.itemsize)) {
+    throw py::type_error("expected a contiguous one-dimensional buffer");
+  }
+  const uint8_t* data = static_cast<const uint8_t*>(info.ptr);
+  size_t size = info.size * info.itemsize;
+  py::gil_scoped_release release;
+  return WalkStats(data, size, n, max_state, max_cnt, max_state_variant);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(random_walk, m) {
+  m.def("WalkStats", WalkStatsBinding);
+  AddKernelStatsBindings(m);
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
@@ -0,0 +1,39 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import random_walk
+
+
+class RandomWalkTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/randomness_tests/cc_util/random_walk_test.cc
+  The p-values computed with this kernel are checked in
+    paranoid_crypto/lib/randomness_tests/nist_suite_test.py
+  """
+
+  def testWalkStats(self):
+    # The walk of the bits 1, 1, 0, 1 is 1, 2, 1, 2.
+    ba = (0b1011).to_bytes(1, "little")
+    stats = random_walk.WalkStats(ba, 4, 1, 2, 1)
+    self.assertEqual([2, 1, 2, 1, 0, 2, 1, 0, 0, 0, 0, 1], stats)
+
+  def testWrongSize(self):
+    self.assertEqual([], random_walk.WalkStats(bytes(2), 17, 4, 5, 9))
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -0,0 +1,73 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/rng.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/sequence.h"
+#include "pybind11/pybind11.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// Returns the next size bytes of generator output. The bytes object is
+// created explicitly, since letting pybind convert std::string would
+// produce a str object.
+py::bytes FillBinding(RngEngine& engine, size_t size) {
+  std::string out(size, '\0');
+  {
+    py::gil_scoped_release release;
+    engine.Fill(reinterpret_cast<uint8_t*>(&out[0]), size);
+  }
+  return py::bytes(out);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(rng, m) {
+  // The Sequence parameter of AppendToSequence is the class registered by
+  // the sequence module of this directory, so that module must be imported
+  // first.
+  py::class_<RngEngine>(m, "RngEngine")
+      .def("Fill", FillBinding)
+      .def("AppendToSequence", &RngEngine::AppendToSequence,
+           py::call_guard<py::gil_scoped_release>());
+  m.def("TruncLcg", [](const py::bytes& a, int output_size,
+                       const py::bytes& seed) {
+    return NewTruncLcg(std::string(a), output_size, std::string(seed));
+  });
+  m.def("XorShift128plus", NewXorShift128plus);
+  m.def("XorShiftStar", NewXorShiftStar);
+  m.def("Xorwow", [](const py::bytes& state, uint32_t ctr) {
+    return NewXorwow(std::string(state), ctr);
+  });
+  m.def("JavaRandom", NewJavaRandom);
+  m.def("LcgNist", NewLcgNist);
+  m.def("Mwc", [](const py::bytes& a, int output_bits, const py::bytes& seed) {
+    return NewMwc(std::string(a), output_bits, std::string(seed));
+  });
+  m.def("Lehmer", [](const py::bytes& a, const py::bytes& mod, int bits,
+                     const py::bytes& seed) {
+    return NewLehmer(std::string(a), std::string(mod), bits,
+                     std::string(seed));
+  });
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
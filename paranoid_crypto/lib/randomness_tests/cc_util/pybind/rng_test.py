@@ -0,0 +1,52 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import rng
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import sequence
+
+
+class RngTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ engines are in
+    paranoid_crypto/lib/randomness_tests/cc_util/rng_test.cc
+  The generators themselves are pinned by the regression tests in
+    paranoid_crypto/lib/randomness_tests/rng_test.py
+  """
+
+  def testFill(self):
+    engine = rng.XorShiftStar(0x012345678ABCDEF)
+    self.assertEqual(
+        bytes.fromhex("a0bb04b3e2d986e7ad8dd243c38e3495"), engine.Fill(16)
+    )
+
+  def testFillContinuesStream(self):
+    expected = rng.XorShiftStar(42).Fill(64)
+    engine = rng.XorShiftStar(42)
+    self.assertEqual(expected, b"".join(engine.Fill(size) for size in
+                                        [1, 2, 7, 11, 16, 27]))
+
+  def testAppendToSequence(self):
+    expected = rng.JavaRandom(12345).Fill(100)
+    engine = rng.JavaRandom(12345)
+    seq = sequence.Sequence()
+    engine.AppendToSequence(seq, 60)
+    engine.AppendToSequence(seq, 40)
+    self.assertEqual(100, seq.NumBytes())
+    self.assertEqual(expected, bytes(memoryview(seq)))
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -0,0 +1,63 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/sequence.h"
+
+#include "pybind11/pybind11.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind {
+
+namespace py = pybind11;
+
+namespace {
+
+// Ingests a chunk through the buffer protocol, so that bytes, bytearray,
+// memoryview and numpy arrays are accepted. This is the only point where
+// the chunk is copied; the kernels later read the assembled sequence in
+// place.
+void AppendBytesBinding(Sequence& sequence, const py::buffer& chunk) {
+  py::buffer_info info = chunk.request();
+  if (info.ndim != 1 ||
+      (!info.strides.empty() && info.strides[0] != info.itemsize)) {
+    throw py::type_error("expected a contiguous one-dimensional buffer");
+  }
+  const uint8_t* data = static_cast<const uint8_t*>(info.ptr);
+  size_t size = info.size * info.itemsize;
+  py::gil_scoped_release release;
+  sequence.AppendBytes(data, size);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(sequence, m) {
+  // The buffer protocol exposes the assembled sequence, so the kernel
+  // bindings in this directory (which all accept buffers) and
+  // int.from_bytes read it without copying.
+  py::class_<Sequence>(m, "Sequence", py::buffer_protocol())
+      .def(py::init<>())
+      .def("AppendBytes", AppendBytesBinding)
+      .def("AppendFile", &Sequence::AppendFile,
+           py::call_guard<py::gil_scoped_release>())
+      .def("Clear", &Sequence::Clear)
+      .def("NumBytes", &Sequence::num_bytes)
+      .def_buffer([](Sequence& sequence) -> py::buffer_info {
+        return py::buffer_info(
+            const_cast<uint8_t*>(sequence.data()), sizeof(uint8_t),
+            py::format_descriptor<uint8_t>::format(), 1,
+            {static_cast<py::ssize_t>(sequence.num_bytes())},
+            {static_cast<py::ssize_t>(1)}, /*readonly=*/true);
+      });
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util::pybind
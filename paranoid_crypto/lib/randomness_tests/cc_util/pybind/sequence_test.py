@@ -0,0 +1,68 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import berlekamp_massey
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import sequence
+
+
+class SequenceTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/randomness_tests/cc_util/sequence_test.cc
+  """
+
+  def testAppendBytes(self):
+    seq = sequence.Sequence()
+    seq.AppendBytes(b"\x05")
+    seq.AppendBytes(b"\x12\x34")
+    self.assertEqual(3, seq.NumBytes())
+    self.assertEqual(b"\x05\x12\x34", bytes(memoryview(seq)))
+
+  def testAppendFile(self):
+    capture = bytes(range(256)) * 100
+    path = self.create_tempfile(content=capture).full_path
+    seq = sequence.Sequence()
+    self.assertTrue(seq.AppendFile(path))
+    self.assertEqual(len(capture), seq.NumBytes())
+    self.assertEqual(capture, bytes(memoryview(seq)))
+
+  def testAppendFileMissing(self):
+    seq = sequence.Sequence()
+    self.assertFalse(seq.AppendFile("/nonexistent/sequence_test_capture"))
+    self.assertEqual(0, seq.NumBytes())
+
+  def testClear(self):
+    seq = sequence.Sequence()
+    seq.AppendBytes(b"\x05")
+    seq.Clear()
+    self.assertEqual(0, seq.NumBytes())
+    self.assertEqual(b"", bytes(memoryview(seq)))
+
+  def testToInt(self):
+    seq = sequence.Sequence()
+    seq.AppendBytes((0b1011).to_bytes(1, "little"))
+    self.assertEqual(0b1011, int.from_bytes(memoryview(seq), "little"))
+
+  def testFeedsKernels(self):
+    # The kernels of this directory read the sequence through the buffer
+    # protocol without a copy.
+    seq = sequence.Sequence()
+    seq.AppendBytes((12345).to_bytes(2, "little"))
+    self.assertEqual(7, berlekamp_massey.LfsrLength(memoryview(seq), 14))
+
+
+if __name__ == "__main__":
+  absltest.main()
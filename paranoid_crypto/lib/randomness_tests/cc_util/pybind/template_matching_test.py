@@ -0,0 +1,66 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import template_matching
+
+
+class TemplateMatchingTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/randomness_tests/cc_util/template_matching_test.cc
+  The tests comparing the C++ version with the native python code are in
+    paranoid_crypto/lib/randomness_tests/util_test.py
+  """
+
+  def testTemplateCounts(self):
+    seq = 0b10011100101
+    ba = seq.to_bytes(2, "little")
+    counts = template_matching.TemplateCounts(ba, 11, 3)
+    self.assertEqual([0, 2, 1, 1, 2, 1, 1, 1], counts)
+
+  def testTemplateCountsBatch(self):
+    seq = 0b10011100101
+    ba = seq.to_bytes(2, "little")
+    counts = template_matching.TemplateCountsBatch(2 * ba, 11, 2, 3)
+    self.assertEqual([0, 2, 1, 1, 2, 1, 1, 1] * 2, counts)
+
+  def testOverlappingRunsOfOnes(self):
+    seq = 0b1011011101111011111
+    ba = seq.to_bytes(3, "little")
+    expected = [15, 10, 6, 3, 1, 0]
+    for m in range(1, 7):
+      self.assertEqual(
+          expected[m - 1],
+          template_matching.OverlappingRunsOfOnes(ba, 19, m))
+
+  def testOverlappingRunsOfOnesBatch(self):
+    seq = 0b1011011101111011111
+    ba = seq.to_bytes(3, "little")
+    self.assertEqual(
+        [6, 6], template_matching.OverlappingRunsOfOnesBatch(2 * ba, 19, 2, 3))
+
+  def testWrongSize(self):
+    self.assertEqual([], template_matching.TemplateCounts(bytes(2), 17, 3))
+    self.assertEqual(
+        [], template_matching.TemplateCountsBatch(bytes(2), 17, 1, 3))
+    self.assertEqual(
+        -1, template_matching.OverlappingRunsOfOnes(bytes(2), 17, 3))
+    self.assertEqual(
+        [], template_matching.OverlappingRunsOfOnesBatch(bytes(2), 17, 1, 3))
+
+
+if __name__ == "__main__":
+  absltest.main()
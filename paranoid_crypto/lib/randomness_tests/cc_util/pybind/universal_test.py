@@ -0,0 +1,46 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import universal
+
+
+class UniversalTest(absltest.TestCase):
+  """Tests the pybind binding.
+
+  The tests for the C++ implementation are in
+    paranoid_crypto/lib/randomness_tests/cc_util/universal_test.cc
+  The p-values computed with this kernel are checked in
+    paranoid_crypto/lib/randomness_tests/nist_suite_test.py
+  """
+
+  def testUniversalSum(self):
+    # With q = 4 the initialization leaves tab[0b10] = 1 and tab[0b01] = 3.
+    # The remaining blocks give the distances 3, 6 (first occurrence of
+    # 0b11, hence distance j + 1), 2, 1, 1 and 4.
+    blocks = [0b10, 0b10, 0b01, 0b01, 0b10, 0b11, 0b10, 0b10, 0b10, 0b11]
+    seq = 0
+    for i, b in enumerate(blocks):
+      seq |= b << (2 * i)
+    ba = seq.to_bytes(3, "little")
+    sumb = universal.UniversalSum(ba, 20, 2, 4)
+    self.assertAlmostEqual(4.0 + 2 * math.log2(3), sumb)
+
+  def testWrongSize(self):
+    self.assertEqual(-1.0, universal.UniversalSum(bytes(2), 17, 2, 1))
+
+
+if __name__ == "__main__":
+  absltest.main()
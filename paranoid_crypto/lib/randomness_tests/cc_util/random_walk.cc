@@ -0,0 +1,153 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/random_walk.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// Cumulative counters of the walk kernel; see kernel_stats.h.
+KernelStats& Stats() {
+  static KernelStats* stats = new KernelStats("WalkStats");
+  return *stats;
+}
+
+// Upper bound for max_state and max_state_variant, so that the count
+// arrays stay small. NIST uses the states -9 .. 9.
+constexpr int kMaxState = 1 << 20;
+
+// Loads 8 consecutive bytes starting at byte_offset as a little endian
+// 64-bit integer. Bytes past the end of the buffer are zero.
+uint64_t LoadWord(const uint8_t* seq, size_t size, size_t byte_offset) {
+  uint64_t word = 0;
+  size_t count = std::min<size_t>(8, size - std::min(size, byte_offset));
+  for (size_t i = 0; i < count; i++) {
+    word |= static_cast<uint64_t>(seq[byte_offset + i]) << (8 * i);
+  }
+  return word;
+}
+
+}  // namespace
+
+std::vector<int64_t> WalkStats(const uint8_t* seq, size_t size, int n,
+                               int max_state, int max_cnt,
+                               int max_state_variant) {
+  if (n < 1 || static_cast<size_t>(n) > 8 * size || max_state < 1 ||
+      max_state > kMaxState || max_cnt < 1 || max_state_variant < 1 ||
+      max_state_variant > kMaxState) {
+    return std::vector<int64_t>();
+  }
+  ScopedKernelTimer timer(&Stats(), (n + 7) / 8);
+  const int max_state2 = std::max(max_state, max_state_variant);
+  // Total visits of the states -max_state_variant .. max_state_variant and
+  // visits of -max_state .. max_state within the current cycle. Both
+  // arrays have an unused entry for the state 0 to keep the indexing
+  // simple.
+  std::vector<int64_t> totals(2 * max_state_variant + 1);
+  std::vector<int64_t> cycle_visits(2 * max_state + 1);
+  // cycle_counts[(x + max_state) * (max_cnt + 1) + c] is the number of
+  // cycles that visit the state x exactly c times, c capped at max_cnt.
+  std::vector<int64_t> cycle_counts((2 * max_state + 1) * (max_cnt + 1));
+  int64_t s = 0;
+  int64_t maxs = -n - 1;
+  int64_t mins = n + 1;
+  int64_t cycles = 0;
+  auto flush_cycle = [&]() {
+    cycles++;
+    for (int x = -max_state; x <= max_state; x++) {
+      if (x == 0) continue;
+      int64_t& visits = cycle_visits[x + max_state];
+      cycle_counts[(x + max_state) * (max_cnt + 1) +
+                   std::min<int64_t>(visits, max_cnt)]++;
+      visits = 0;
+    }
+  };
+  int j = 0;
+  while (j < n) {
+    if (j % 64 == 0 && j + 64 <= n) {
+      uint64_t word = LoadWord(seq, size, j / 8);
+      // If the walk is too far from the origin to reach the counted states
+      // or a new extreme value within the next 64 steps, then only the
+      // partial sum at the end of the word is needed. For strongly biased
+      // sequences this skips almost all single steps.
+      if ((s - 64 > max_state2 && s + 64 <= maxs) ||
+          (s + 64 < -max_state2 && s - 64 >= mins)) {
+        s += 2 * __builtin_popcountll(word) - 64;
+        j += 64;
+        continue;
+      }
+      // Otherwise the 64 steps are walked individually from the word.
+      for (int t = 0; t < 64; t++, j++) {
+        s += (word >> t) & 1 ? 1 : -1;
+        if (s == 0) {
+          flush_cycle();
+          continue;
+        }
+        if (s > maxs) maxs = s;
+        if (s < mins) mins = s;
+        if (s >= -max_state_variant && s <= max_state_variant) {
+          totals[s + max_state_variant]++;
+        }
+        if (s >= -max_state && s <= max_state) {
+          cycle_visits[s + max_state]++;
+        }
+      }
+      continue;
+    }
+    s += (seq[j >> 3] >> (j & 7)) & 1 ? 1 : -1;
+    if (s == 0) {
+      flush_cycle();
+    } else {
+      if (s > maxs) maxs = s;
+      if (s < mins) mins = s;
+      if (s >= -max_state_variant && s <= max_state_variant) {
+        totals[s + max_state_variant]++;
+      }
+      if (s >= -max_state && s <= max_state) {
+        cycle_visits[s + max_state]++;
+      }
+    }
+    j++;
+  }
+  // The last cycle is included even if the walk does not return to the
+  // origin.
+  flush_cycle();
+
+  std::vector<int64_t> result;
+  result.reserve(4 + 2 * max_state_variant +
+                 2 * max_state * (max_cnt + 1));
+  result.push_back(maxs);
+  result.push_back(mins);
+  result.push_back(s);
+  result.push_back(cycles);
+  for (int x = -max_state_variant; x <= max_state_variant; x++) {
+    if (x != 0) result.push_back(totals[x + max_state_variant]);
+  }
+  for (int x = -max_state; x <= max_state; x++) {
+    if (x == 0) continue;
+    for (int c = 0; c <= max_cnt; c++) {
+      result.push_back(cycle_counts[(x + max_state) * (max_cnt + 1) + c]);
+    }
+  }
+  return result;
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
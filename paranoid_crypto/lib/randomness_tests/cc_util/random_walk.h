@@ -0,0 +1,55 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_RANDOM_WALK_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_RANDOM_WALK_H_
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Kernel for the random walk tests of NIST SP 800-22: cumulative sums
+// (Section 2.13), random excursions (2.14) and random excursions variant
+// (2.15). The sequence uses the little endian bit representation of this
+// directory: bit j is (seq[j / 8] >> (j % 8)) & 1.
+//
+// The walk interprets the first n bits as steps +1 (for a 1) and -1 (for
+// a 0) and computes all the statistics that nist_suite.RandomWalk derives
+// from the partial sums in a single pass, without materializing the walk.
+// The walk is divided into cycles at every return to the origin; the last,
+// possibly incomplete, cycle is included.
+//
+// The result is a flat vector with the layout
+//   [0]  the largest state != 0 that the walk visits
+//   [1]  the smallest state != 0 that the walk visits
+//   [2]  the final partial sum
+//   [3]  the number of cycles
+//   [4 .. 4 + 2 * max_state_variant)
+//        the number of visits of the states -max_state_variant .. -1,
+//        1 .. max_state_variant, in increasing order of the state
+//   followed by max_cnt + 1 entries for each of the states
+//   -max_state .. -1, 1 .. max_state, in increasing order: entry c is the
+//   number of cycles that visit the state exactly c times, with c capped
+//   at max_cnt.
+// Returns an empty vector if the parameters are inconsistent (n < 1,
+// n > 8 * size, or one of max_state, max_cnt, max_state_variant is not
+// positive).
+std::vector<int64_t> WalkStats(const uint8_t* seq, size_t size, int n,
+                               int max_state, int max_cnt,
+                               int max_state_variant);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_RANDOM_WALK_H_
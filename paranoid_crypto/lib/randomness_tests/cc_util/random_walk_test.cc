@@ -0,0 +1,122 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/random_walk.h"
+
+#include <map>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+int BitAt(const std::vector<uint8_t>& seq, int j) {
+  return (seq[j / 8] >> (j % 8)) & 1;
+}
+
+std::vector<uint8_t> PRandBytes(int size) {
+  std::vector<uint8_t> seq(size);
+  for (int j = 0; j < size; j++) {
+    seq[j] = ((j * j * 51869) % 65213) & 255;
+  }
+  return seq;
+}
+
+// Computes the statistics by materializing the walk, like the former
+// Python implementation in nist_suite.RandomWalk.
+std::vector<int64_t> RefStats(const std::vector<uint8_t>& seq, int n, int ms,
+                              int mc, int msv) {
+  std::vector<std::map<int, int64_t>> cycles(1);
+  int64_t s = 0;
+  int64_t maxs = -n - 1, mins = n + 1;
+  for (int j = 0; j < n; j++) {
+    s += BitAt(seq, j) ? 1 : -1;
+    if (s == 0) {
+      cycles.emplace_back();
+      continue;
+    }
+    if (s > maxs) maxs = s;
+    if (s < mins) mins = s;
+    cycles.back()[s]++;
+  }
+  std::vector<int64_t> result = {maxs, mins, s,
+                                 static_cast<int64_t>(cycles.size())};
+  for (int x = -msv; x <= msv; x++) {
+    if (x == 0) continue;
+    int64_t total = 0;
+    for (auto& cycle : cycles) total += cycle[x];
+    result.push_back(total);
+  }
+  for (int x = -ms; x <= ms; x++) {
+    if (x == 0) continue;
+    std::vector<int64_t> v(mc + 1);
+    for (auto& cycle : cycles) v[std::min<int64_t>(cycle[x], mc)]++;
+    result.insert(result.end(), v.begin(), v.end());
+  }
+  return result;
+}
+
+TEST(RandomWalk, CompareWithReference) {
+  std::vector<uint8_t> seq = PRandBytes(500);
+  for (int n : {1, 3, 64, 128, 1000, 4000}) {
+    for (int ms : {1, 4}) {
+      for (int msv : {2, 9}) {
+        EXPECT_EQ(RefStats(seq, n, ms, 5, msv),
+                  WalkStats(seq.data(), seq.size(), n, ms, 5, msv))
+            << n << " " << ms << " " << msv;
+      }
+    }
+  }
+}
+
+TEST(RandomWalk, BiasedSequences) {
+  // Strongly biased walks exercise the popcount fast path for words far
+  // away from the origin.
+  std::vector<uint8_t> all_ones(200, 0xff);
+  EXPECT_EQ(RefStats(all_ones, 1600, 4, 5, 9),
+            WalkStats(all_ones.data(), all_ones.size(), 1600, 4, 5, 9));
+  std::vector<uint8_t> mostly_zeros(200, 0);
+  mostly_zeros[150] = 0xff;
+  EXPECT_EQ(RefStats(mostly_zeros, 1600, 4, 5, 9),
+            WalkStats(mostly_zeros.data(), mostly_zeros.size(), 1600, 4, 5,
+                      9));
+}
+
+TEST(RandomWalk, Tv) {
+  // The walk of 1101 is 1, 2, 1, 2; the walk of 0110 is -1, 0, 1, 0.
+  std::vector<uint8_t> seq = {0b1011};
+  std::vector<int64_t> stats = WalkStats(seq.data(), seq.size(), 4, 1, 2, 1);
+  // maxs, mins, s, cycles, totals for -1 and 1, cycle counts for -1 and 1.
+  std::vector<int64_t> expected = {2, 1, 2, 1, 0, 2, 1, 0, 0, 0, 0, 1};
+  EXPECT_EQ(expected, stats);
+  std::vector<uint8_t> seq2 = {0b0110};
+  std::vector<int64_t> stats2 = WalkStats(seq2.data(), seq2.size(), 4, 1, 2,
+                                          1);
+  // Both -1 and 1 are visited in one of the three cycles.
+  std::vector<int64_t> expected2 = {1, -1, 0, 3, 1, 1, 2, 1, 0, 2, 1, 0};
+  EXPECT_EQ(expected2, stats2);
+}
+
+TEST(RandomWalk, InvalidParameters) {
+  std::vector<uint8_t> seq = PRandBytes(8);
+  EXPECT_TRUE(WalkStats(seq.data(), seq.size(), 0, 4, 5, 9).empty());
+  EXPECT_TRUE(WalkStats(seq.data(), seq.size(), 65, 4, 5, 9).empty());
+  EXPECT_TRUE(WalkStats(seq.data(), seq.size(), 64, 0, 5, 9).empty());
+  EXPECT_TRUE(WalkStats(seq.data(), seq.size(), 64, 4, 0, 9).empty());
+  EXPECT_TRUE(WalkStats(seq.data(), seq.size(), 64, 4, 5, 0).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,352 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/rng.h"
+
+#include <gmpxx.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/sequence.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// The chunk size for streaming output into a sequence, matching the chunk
+// size that sequence.cc uses for ingesting files.
+constexpr size_t kStreamChunkSize = 1 << 20;
+
+// Converts an unsigned little endian byte string (the format produced by
+// int.to_bytes) to an integer.
+mpz_class FromBytes(const std::string& bytes) {
+  mpz_class value;
+  mpz_import(value.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+  return value;
+}
+
+// Writes value as size little endian bytes, zero padded at the top.
+// value must be smaller than 256**size.
+void ExportBytes(const mpz_class& value, uint8_t* out, size_t size) {
+  std::memset(out, 0, size);
+  mpz_export(out, nullptr, -1, 1, 0, 0, value.get_mpz_t());
+}
+
+// Writes the lowest size bytes of value in little endian order.
+void ExportWord(uint64_t value, uint8_t* out, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+// A truncated LCG whose state fits a single word. Covers the instances
+// trunclcg16 to trunclcg32 of rng.py, which have states of at most 64
+// bits, without any bignum arithmetic in the inner loop.
+class TruncLcg64 : public RngEngine {
+ public:
+  TruncLcg64(uint64_t a, int output_size, uint64_t seed)
+      : RngEngine((output_size + 7) / 8),
+        a_(a),
+        output_size_(output_size),
+        mask_(2 * output_size == 64
+                  ? ~uint64_t{0}
+                  : (uint64_t{1} << (2 * output_size)) - 1),
+        state_(seed & mask_) {}
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    state_ = (state_ * a_ + 1) & mask_;
+    ExportWord(state_ >> output_size_, out, (output_size_ + 7) / 8);
+  }
+
+ private:
+  const uint64_t a_;
+  const int output_size_;
+  const uint64_t mask_;
+  uint64_t state_;
+};
+
+// A truncated LCG with a state larger than 64 bits. The modulus is a
+// power of two, so the reduction is a truncation.
+class TruncLcgMpz : public RngEngine {
+ public:
+  TruncLcgMpz(const mpz_class& a, int output_size, const mpz_class& seed)
+      : RngEngine((output_size + 7) / 8),
+        a_(a),
+        output_size_(output_size),
+        state_(seed) {
+    mpz_tdiv_r_2exp(state_.get_mpz_t(), state_.get_mpz_t(), 2 * output_size);
+  }
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    state_ = state_ * a_ + 1;
+    mpz_tdiv_r_2exp(state_.get_mpz_t(), state_.get_mpz_t(), 2 * output_size_);
+    mpz_tdiv_q_2exp(output_.get_mpz_t(), state_.get_mpz_t(), output_size_);
+    ExportBytes(output_, out, (output_size_ + 7) / 8);
+  }
+
+ private:
+  const mpz_class a_;
+  const int output_size_;
+  mpz_class state_;
+  mpz_class output_;
+};
+
+class XorShift128plus : public RngEngine {
+ public:
+  XorShift128plus(uint64_t x, uint64_t y) : RngEngine(8), x_(x), y_(y) {}
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    x_ ^= x_ << 23;
+    x_ ^= x_ >> 17;
+    x_ ^= y_ ^ (y_ >> 26);
+    ExportWord(x_ + y_, out, 8);
+  }
+
+ private:
+  uint64_t x_;
+  const uint64_t y_;
+};
+
+class XorShiftStar : public RngEngine {
+ public:
+  explicit XorShiftStar(uint64_t x) : RngEngine(8), x_(x) {}
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    x_ ^= x_ >> 12;
+    x_ ^= x_ << 25;
+    x_ ^= x_ >> 27;
+    ExportWord(x_ * 0x2545f4914f6cdd1d, out, 8);
+  }
+
+ private:
+  uint64_t x_;
+};
+
+// rng.Xorwow keeps the state as one big integer of five 32 bit words plus
+// the word shifted out by the previous step. Written with 32 bit words
+// the recurrence is a shift register: the feedback word is computed from
+// the oldest and the newest word and shifted in at the front.
+class Xorwow : public RngEngine {
+ public:
+  Xorwow(const std::string& state, uint32_t ctr) : RngEngine(4), ctr_(ctr) {
+    for (int i = 0; i < 5; ++i) {
+      uint32_t word = 0;
+      for (int j = 0; j < 4; ++j) {
+        size_t pos = 4 * i + j;
+        if (pos < state.size()) {
+          word |= static_cast<uint32_t>(static_cast<uint8_t>(state[pos]))
+                  << (8 * j);
+        }
+      }
+      w_[i] = word;
+    }
+    w_[5] = 0;
+  }
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    uint32_t t = w_[5];
+    uint32_t s = w_[0];
+    t ^= t >> 2;
+    t ^= t << 1;
+    t ^= s ^ (s << 4);
+    for (int i = 5; i > 0; --i) {
+      w_[i] = w_[i - 1];
+    }
+    w_[0] = t;
+    ExportWord(t + ctr_, out, 4);
+    ctr_ += 362437;
+  }
+
+ private:
+  uint32_t w_[6];
+  uint32_t ctr_;
+};
+
+class JavaRandom : public RngEngine {
+ public:
+  explicit JavaRandom(uint64_t state)
+      : RngEngine(4), state_(state & kMask) {}
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    state_ = (state_ * 0x5deece66d + 0xb) & kMask;
+    ExportWord(state_ >> 16, out, 4);
+  }
+
+ private:
+  static constexpr uint64_t kMask = 0xffffffffffff;
+  uint64_t state_;
+};
+
+class LcgNist : public RngEngine {
+ public:
+  LcgNist(uint32_t a, uint32_t seed) : RngEngine(1), a_(a), state_(seed) {}
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    uint8_t b = 0;
+    for (int j = 0; j < 8; ++j) {
+      state_ = a_ * state_ % ((uint64_t{1} << 31) - 1);
+      b ^= static_cast<uint8_t>(state_ >> 30) << j;
+    }
+    *out = b;
+  }
+
+ private:
+  const uint64_t a_;
+  uint64_t state_;
+};
+
+// Multiply-with-carry through the equivalent Lehmer generator, as in
+// rng.Mwc. b = 2**output_bits is a power of 256, so the output is the
+// lowest output_bits bits of the state.
+class Mwc : public RngEngine {
+ public:
+  Mwc(const mpz_class& a, int output_bits, const mpz_class& seed)
+      : RngEngine(output_bits / 8),
+        a_(a),
+        output_bits_(output_bits),
+        ab1_((a << output_bits) - 1),
+        state_(seed % ab1_) {}
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    state_ = state_ * a_ % ab1_;
+    mpz_tdiv_r_2exp(output_.get_mpz_t(), state_.get_mpz_t(), output_bits_);
+    ExportBytes(output_, out, output_bits_ / 8);
+  }
+
+ private:
+  const mpz_class a_;
+  const int output_bits_;
+  const mpz_class ab1_;
+  mpz_class state_;
+  mpz_class output_;
+};
+
+class Lehmer : public RngEngine {
+ public:
+  Lehmer(const mpz_class& a, const mpz_class& mod, int bits,
+         const mpz_class& seed)
+      : RngEngine(bits / 8),
+        a_(a),
+        mod_(mod),
+        bits_(bits),
+        state_(seed % mod) {}
+
+ protected:
+  void NextBlock(uint8_t* out) override {
+    state_ = state_ * a_ % mod_;
+    mpz_mul_2exp(output_.get_mpz_t(), state_.get_mpz_t(), bits_);
+    mpz_tdiv_q(output_.get_mpz_t(), output_.get_mpz_t(), mod_.get_mpz_t());
+    ExportBytes(output_, out, bits_ / 8);
+  }
+
+ private:
+  const mpz_class a_;
+  const mpz_class mod_;
+  const int bits_;
+  mpz_class state_;
+  mpz_class output_;
+};
+
+}  // namespace
+
+RngEngine::RngEngine(size_t block_bytes) : block_bytes_(block_bytes) {}
+
+void RngEngine::Fill(uint8_t* out, size_t size) {
+  size_t pos = 0;
+  while (pos < size && pending_pos_ < pending_.size()) {
+    out[pos++] = static_cast<uint8_t>(pending_[pending_pos_++]);
+  }
+  while (size - pos >= block_bytes_) {
+    NextBlock(out + pos);
+    pos += block_bytes_;
+  }
+  if (pos < size) {
+    pending_.resize(block_bytes_);
+    NextBlock(reinterpret_cast<uint8_t*>(&pending_[0]));
+    pending_pos_ = 0;
+    while (pos < size) {
+      out[pos++] = static_cast<uint8_t>(pending_[pending_pos_++]);
+    }
+  }
+}
+
+void RngEngine::AppendToSequence(Sequence* sequence, size_t size) {
+  std::vector<uint8_t> chunk(std::min(size, kStreamChunkSize));
+  while (size > 0) {
+    size_t chunk_size = std::min(size, kStreamChunkSize);
+    Fill(chunk.data(), chunk_size);
+    sequence->AppendBytes(chunk.data(), chunk_size);
+    size -= chunk_size;
+  }
+}
+
+std::unique_ptr<RngEngine> NewTruncLcg(const std::string& a, int output_size,
+                                       const std::string& seed) {
+  mpz_class a_val = FromBytes(a);
+  mpz_class seed_val = FromBytes(seed);
+  if (2 * output_size <= 64) {
+    return std::make_unique<TruncLcg64>(mpz_get_ui(a_val.get_mpz_t()),
+                                        output_size,
+                                        mpz_get_ui(seed_val.get_mpz_t()));
+  }
+  return std::make_unique<TruncLcgMpz>(a_val, output_size, seed_val);
+}
+
+std::unique_ptr<RngEngine> NewXorShift128plus(uint64_t x, uint64_t y) {
+  return std::make_unique<XorShift128plus>(x, y);
+}
+
+std::unique_ptr<RngEngine> NewXorShiftStar(uint64_t x) {
+  return std::make_unique<XorShiftStar>(x);
+}
+
+std::unique_ptr<RngEngine> NewXorwow(const std::string& state, uint32_t ctr) {
+  return std::make_unique<Xorwow>(state, ctr);
+}
+
+std::unique_ptr<RngEngine> NewJavaRandom(uint64_t state) {
+  return std::make_unique<JavaRandom>(state);
+}
+
+std::unique_ptr<RngEngine> NewLcgNist(uint32_t a, uint32_t seed) {
+  return std::make_unique<LcgNist>(a, seed);
+}
+
+std::unique_ptr<RngEngine> NewMwc(const std::string& a, int output_bits,
+                                  const std::string& seed) {
+  return std::make_unique<Mwc>(FromBytes(a), output_bits, FromBytes(seed));
+}
+
+std::unique_ptr<RngEngine> NewLehmer(const std::string& a,
+                                     const std::string& mod, int bits,
+                                     const std::string& seed) {
+  return std::make_unique<Lehmer>(FromBytes(a), FromBytes(mod), bits,
+                                  FromBytes(seed));
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
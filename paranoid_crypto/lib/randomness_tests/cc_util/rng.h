@@ -0,0 +1,115 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_RNG_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_RNG_H_
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/sequence.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Native engines for the pseudorandom number generators in
+// randomness_tests/rng.py. The Python classes generate the test samples
+// for random_test_suite one output at a time, which for samples of 2**26
+// bits and more takes longer than some of the tests. The engines here run
+// the same recurrences natively and fill caller-provided buffers in bulk;
+// the byte stream is identical bit for bit to the bytearray the Python
+// loops assemble, so the regression tests in rng_test.py pin both
+// implementations. Seeding stays in Python: a constructor takes the fully
+// initialized state (os.urandom fallbacks and seed scrambling included),
+// encoded as unsigned little endian byte strings as produced by
+// int.to_bytes where the state does not fit a native word.
+//
+// An engine is stateful: consecutive Fill calls continue the output
+// stream, so a large sample can be generated in chunks. AppendToSequence
+// streams the output into a Sequence handle this way, so a sample can be
+// generated and then tested without ever being materialized as a Python
+// object.
+class RngEngine {
+ public:
+  virtual ~RngEngine() = default;
+
+  // Fills out[0 .. size) with the next size bytes of generator output.
+  // The output of a generator is a stream of fixed size blocks; a block
+  // that a call consumes only partially is continued by the next call.
+  void Fill(uint8_t* out, size_t size);
+
+  // Appends size bytes of generator output to *sequence. The output is
+  // generated in fixed size chunks, so the peak memory usage is the size
+  // of the sequence plus one chunk.
+  void AppendToSequence(Sequence* sequence, size_t size);
+
+ protected:
+  explicit RngEngine(size_t block_bytes);
+
+  // Writes the next block of block_bytes output bytes to out.
+  virtual void NextBlock(uint8_t* out) = 0;
+
+ private:
+  const size_t block_bytes_;
+  // A partially consumed block; the bytes pending_[pending_pos_ ..] are
+  // emitted before the recurrence is stepped again.
+  std::string pending_;
+  size_t pending_pos_ = 0;
+};
+
+// A truncated LCG with state size 2 * output_size bits, multiplier a and
+// increment 1, outputting the upper half of the state as blocks of
+// (output_size + 7) / 8 bytes. Matches rng.TruncLcgRand. States of up to
+// 64 bits use a single word; larger states use GMP.
+std::unique_ptr<RngEngine> NewTruncLcg(const std::string& a, int output_size,
+                                       const std::string& seed);
+
+// XorShift128+ as implemented by rng.XorShift128plus, with blocks of 8
+// bytes. As in the Python code, y enters every output but is never
+// updated.
+std::unique_ptr<RngEngine> NewXorShift128plus(uint64_t x, uint64_t y);
+
+// XorShift* with 64 bits of state and blocks of 8 bytes. Matches
+// rng.XorShiftStar.
+std::unique_ptr<RngEngine> NewXorShiftStar(uint64_t x);
+
+// Xorwow with 160 bits of shift register state (20 bytes, little endian)
+// and a 32 bit counter, with blocks of 4 bytes. Matches rng.Xorwow.
+std::unique_ptr<RngEngine> NewXorwow(const std::string& state, uint32_t ctr);
+
+// The 48 bit LCG of java.util.Random, outputting the upper 32 bits of the
+// state as blocks of 4 bytes. The caller passes the already scrambled
+// initial state (seed ^ 0x5deece66d as in rng.JavaRandom).
+std::unique_ptr<RngEngine> NewJavaRandom(uint64_t state);
+
+// The single bit per step LCG modulo 2**31 - 1 from SP 800-22, packing 8
+// steps into each output byte. Matches rng.LcgNist.
+std::unique_ptr<RngEngine> NewLcgNist(uint32_t a, uint32_t seed);
+
+// Multiply-with-carry, implemented through the equivalent Lehmer generator
+// with modulus a * 2**output_bits - 1 as in rng.Mwc, outputting the lowest
+// output_bits bits of the state as blocks of output_bits / 8 bytes.
+std::unique_ptr<RngEngine> NewMwc(const std::string& a, int output_bits,
+                                  const std::string& seed);
+
+// A Lehmer generator with multiplier a and modulus mod, outputting the
+// top bits of the state as floor(state * 2**bits / mod) in blocks of
+// bits / 8 bytes. Matches rng.Lehmer.
+std::unique_ptr<RngEngine> NewLehmer(const std::string& a,
+                                     const std::string& mod, int bits,
+                                     const std::string& seed);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_RNG_H_
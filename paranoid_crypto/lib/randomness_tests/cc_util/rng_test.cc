@@ -0,0 +1,151 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/rng.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/sequence.h"
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+// The expected byte streams below were computed with the python
+// recurrences in randomness_tests/rng.py, which in turn are pinned by the
+// regression tests in randomness_tests/rng_test.py.
+
+std::string FromHex(const std::string& hex) {
+  std::string bytes(hex.size() / 2, '\0');
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<char>(
+        std::stoi(hex.substr(2 * i, 2), nullptr, 16));
+  }
+  return bytes;
+}
+
+std::string Fill(RngEngine* engine, size_t size) {
+  std::string out(size, '\0');
+  engine->Fill(reinterpret_cast<uint8_t*>(&out[0]), size);
+  return out;
+}
+
+// Converts an unsigned little endian integer to a byte string, like
+// int.to_bytes in the python wrappers.
+std::string ToBytes(uint64_t value, size_t size) {
+  std::string bytes(size, '\0');
+  for (size_t i = 0; i < size && i < 8; ++i) {
+    bytes[i] = static_cast<char>(value >> (8 * i));
+  }
+  return bytes;
+}
+
+TEST(RngTest, TruncLcgKnownAnswer) {
+  // trunclcg16 (32 bit state, single word path), seed 123456.
+  std::unique_ptr<RngEngine> engine =
+      NewTruncLcg(ToBytes(2891336453, 4), 16, ToBytes(123456, 4));
+  EXPECT_EQ(FromHex("d28e9c90292bbd61"), Fill(engine.get(), 8));
+  // trunclcg20 has blocks of 3 bytes with only 20 significant bits.
+  engine = NewTruncLcg(ToBytes(330169576829, 5), 20, ToBytes(123456, 5));
+  EXPECT_EQ(FromHex("e2a8044dd407a6a30f"), Fill(engine.get(), 9));
+}
+
+TEST(RngTest, TruncLcgWideKnownAnswer) {
+  // trunclcg128 (256 bit state), exercising the bignum path.
+  const std::string a = FromHex(
+      "5564a622b78bbabfd653f17fe8b496279c0c742a5433be826fbb4a62166895cc");
+  std::unique_ptr<RngEngine> engine = NewTruncLcg(a, 128, ToBytes(123456, 8));
+  EXPECT_EQ(
+      FromHex("9329c11cf94c31cc0ad09647a92a5473"
+              "7cab80768ffd5b721427352fa8a6e47c"),
+      Fill(engine.get(), 32));
+}
+
+TEST(RngTest, XorShift128plusKnownAnswer) {
+  std::unique_ptr<RngEngine> engine =
+      NewXorShift128plus(0, 0x012345678abcdef);
+  EXPECT_EQ(FromHex("60a6d2f4ac68240042f0c8a3503b502b"), Fill(engine.get(), 16));
+}
+
+TEST(RngTest, XorShiftStarKnownAnswer) {
+  std::unique_ptr<RngEngine> engine = NewXorShiftStar(0x012345678abcdef);
+  EXPECT_EQ(FromHex("a0bb04b3e2d986e7ad8dd243c38e3495"), Fill(engine.get(), 16));
+}
+
+TEST(RngTest, XorwowKnownAnswer) {
+  std::unique_ptr<RngEngine> engine =
+      NewXorwow(ToBytes(0x012345678abcdef, 20), 0);
+  EXPECT_EQ(FromHex("1f1317f2b4aa6bd3a91b0fe5"), Fill(engine.get(), 12));
+}
+
+TEST(RngTest, JavaRandomKnownAnswer) {
+  std::unique_ptr<RngEngine> engine =
+      NewJavaRandom((0x123456789abd ^ 0x5deece66d) & 0xffffffffffff);
+  EXPECT_EQ(FromHex("1cfffb5cf573588f"), Fill(engine.get(), 8));
+}
+
+TEST(RngTest, LcgNistKnownAnswer) {
+  std::unique_ptr<RngEngine> engine = NewLcgNist(950706376, 0x123456);
+  EXPECT_EQ(FromHex("2214af1ffe"), Fill(engine.get(), 5));
+}
+
+TEST(RngTest, MwcKnownAnswer) {
+  // mwc64, i.e. a = 2**64 - 742.
+  std::unique_ptr<RngEngine> engine =
+      NewMwc(ToBytes(0xfffffffffffffd1a, 8), 64, ToBytes(0x012345678abcdef, 8));
+  EXPECT_EQ(FromHex("461d093e5e4d3ccb0af540aa2ef549ef"), Fill(engine.get(), 16));
+}
+
+TEST(RngTest, LehmerKnownAnswer) {
+  // The 128 bit instance proposed by L'Ecuyer with 64 bits of output,
+  // i.e. the default parameters of rng.Lehmer.
+  const std::string a = FromHex("a51679b3b24e712e6ef100b5355ee112");
+  std::string mod(17, '\0');
+  mod[16] = '\x01';
+  std::unique_ptr<RngEngine> engine =
+      NewLehmer(a, mod, 64, ToBytes(0x0123456789, 8));
+  EXPECT_EQ(FromHex("a5d9219042e2bc38f505bad00e65b8e6"), Fill(engine.get(), 16));
+}
+
+TEST(RngTest, StreamingContinuesBlocks) {
+  // Filling in chunks whose sizes are no multiple of the block size gives
+  // the same stream as filling in one call.
+  std::unique_ptr<RngEngine> engine =
+      NewTruncLcg(ToBytes(330169576829, 5), 20, ToBytes(98765, 5));
+  std::string expected = Fill(engine.get(), 60);
+  engine = NewTruncLcg(ToBytes(330169576829, 5), 20, ToBytes(98765, 5));
+  std::string streamed;
+  for (size_t chunk : {1, 2, 7, 11, 16, 23}) {
+    streamed += Fill(engine.get(), chunk);
+  }
+  EXPECT_EQ(expected, streamed);
+}
+
+TEST(RngTest, AppendToSequenceMatchesFill) {
+  std::unique_ptr<RngEngine> engine = NewXorShiftStar(42);
+  std::string expected = Fill(engine.get(), 100);
+  engine = NewXorShiftStar(42);
+  Sequence sequence;
+  engine->AppendToSequence(&sequence, 60);
+  engine->AppendToSequence(&sequence, 40);
+  ASSERT_EQ(100, sequence.num_bytes());
+  EXPECT_EQ(expected,
+            std::string(reinterpret_cast<const char*>(sequence.data()), 100));
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
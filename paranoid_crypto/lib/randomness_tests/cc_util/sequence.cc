@@ -0,0 +1,52 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/sequence.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// The chunk size for reading capture files. The value is a compromise: large
+// enough that the read overhead is negligible, small enough that the memory
+// overhead over the sequence itself does not matter.
+constexpr size_t kFileChunkSize = 1 << 20;
+
+}  // namespace
+
+void Sequence::AppendBytes(const uint8_t* data, size_t size) {
+  buffer_.append(reinterpret_cast<const char*>(data), size);
+}
+
+bool Sequence::AppendFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::vector<char> chunk(kFileChunkSize);
+  while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+    buffer_.append(chunk.data(), file.gcount());
+  }
+  return file.eof();
+}
+
+void Sequence::Clear() { buffer_.clear(); }
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
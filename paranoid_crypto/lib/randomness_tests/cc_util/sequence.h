@@ -0,0 +1,61 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_SEQUENCE_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_SEQUENCE_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// A handle for ingesting a bit sequence in chunks. The chunks are stored
+// back to back as one packed buffer in the little endian bit order of this
+// directory: bit j of the sequence is (data()[j / 8] >> (j % 8)) & 1. The
+// pybind binding exposes the buffer through the buffer protocol, so the
+// kernels of this directory can read a sequence that was collected chunk by
+// chunk (e.g. from a hardware RNG capture file) without copying it and
+// without converting it into a Python integer first. Appending may move the
+// buffer, so views obtained from the buffer protocol are only valid until
+// the next AppendBytes, AppendFile or Clear.
+class Sequence {
+ public:
+  Sequence() = default;
+
+  // Appends size bytes (i.e. 8 * size bits) to the sequence.
+  void AppendBytes(const uint8_t* data, size_t size);
+
+  // Appends the contents of the file at path to the sequence. The file is
+  // read in fixed size chunks, so the peak memory usage of the ingestion is
+  // the size of the sequence plus one chunk. Returns false if the file
+  // cannot be opened or a read fails; the bytes read before a failure are
+  // kept.
+  bool AppendFile(const std::string& path);
+
+  // Removes all bytes from the sequence. The buffer capacity is kept, so a
+  // handle can be reused for several samples without reallocating.
+  void Clear();
+
+  const uint8_t* data() const {
+    return reinterpret_cast<const uint8_t*>(buffer_.data());
+  }
+  size_t num_bytes() const { return buffer_.size(); }
+
+ private:
+  std::string buffer_;
+};
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_SEQUENCE_H_
@@ -0,0 +1,89 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/sequence.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+std::vector<uint8_t> PRandBytes(int size) {
+  std::vector<uint8_t> seq(size);
+  for (int j = 0; j < size; j++) {
+    seq[j] = ((j * j * 56843) % 65167) & 255;
+  }
+  return seq;
+}
+
+TEST(SequenceTest, AppendBytesConcatenates) {
+  std::vector<uint8_t> bytes = PRandBytes(1000);
+  Sequence seq;
+  EXPECT_EQ(seq.num_bytes(), 0);
+  // Ingests the bytes in chunks of varying size.
+  size_t pos = 0;
+  for (size_t chunk = 1; pos < bytes.size(); chunk++) {
+    size_t take = std::min(chunk, bytes.size() - pos);
+    seq.AppendBytes(bytes.data() + pos, take);
+    pos += take;
+  }
+  ASSERT_EQ(seq.num_bytes(), bytes.size());
+  for (size_t j = 0; j < bytes.size(); j++) {
+    EXPECT_EQ(seq.data()[j], bytes[j]);
+  }
+}
+
+TEST(SequenceTest, AppendFileReadsCapture) {
+  std::vector<uint8_t> bytes = PRandBytes(100000);
+  std::string path = testing::TempDir() + "/sequence_test_capture";
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  file.close();
+
+  Sequence seq;
+  ASSERT_TRUE(seq.AppendFile(path));
+  ASSERT_EQ(seq.num_bytes(), bytes.size());
+  for (size_t j = 0; j < bytes.size(); j++) {
+    EXPECT_EQ(seq.data()[j], bytes[j]);
+  }
+  // A second AppendFile appends rather than replaces.
+  ASSERT_TRUE(seq.AppendFile(path));
+  EXPECT_EQ(seq.num_bytes(), 2 * bytes.size());
+}
+
+TEST(SequenceTest, AppendFileMissingFile) {
+  Sequence seq;
+  EXPECT_FALSE(seq.AppendFile("/nonexistent/sequence_test_capture"));
+  EXPECT_EQ(seq.num_bytes(), 0);
+}
+
+TEST(SequenceTest, ClearKeepsHandleUsable) {
+  std::vector<uint8_t> bytes = PRandBytes(100);
+  Sequence seq;
+  seq.AppendBytes(bytes.data(), bytes.size());
+  seq.Clear();
+  EXPECT_EQ(seq.num_bytes(), 0);
+  seq.AppendBytes(bytes.data(), 10);
+  EXPECT_EQ(seq.num_bytes(), 10);
+  EXPECT_EQ(seq.data()[0], bytes[0]);
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,189 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/template_matching.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// Cumulative counters of the two kernels of this file; see kernel_stats.h.
+// The batch entry points record once for all their blocks.
+KernelStats& TemplateStats() {
+  static KernelStats* stats = new KernelStats("TemplateCounts");
+  return *stats;
+}
+
+KernelStats& RunsStats() {
+  static KernelStats* stats = new KernelStats("OverlappingRunsOfOnes");
+  return *stats;
+}
+
+// The count tables have 2^m entries, hence large values of m exhaust
+// memory long before the kernels become slow. The NIST test suite uses
+// templates of at most 10 bits.
+constexpr int kMaxTemplateBits = 24;
+
+int BitAt(const uint8_t* seq, int j) { return (seq[j >> 3] >> (j & 7)) & 1; }
+
+// Loads 8 consecutive bytes starting at byte_offset as a little endian
+// 64-bit integer. Bytes past the end of the buffer are zero.
+uint64_t LoadWord(const uint8_t* seq, size_t size, size_t byte_offset) {
+  uint64_t word = 0;
+  size_t count = std::min<size_t>(8, size - std::min(size, byte_offset));
+  for (size_t i = 0; i < count; i++) {
+    word |= static_cast<uint64_t>(seq[byte_offset + i]) << (8 * i);
+  }
+  return word;
+}
+
+// Tallies the m-bit windows of the first n bits into counts, which must
+// point to 2^m entries. The main loop loads one word per byte boundary and
+// extracts the 8 windows starting in that byte, so the sequence is read
+// once regardless of m.
+void CountTemplates(const uint8_t* seq, size_t size, int n, int m,
+                    int64_t* counts) {
+  const uint64_t mask = (uint64_t{1} << m) - 1;
+  int num_windows = n - m + 1;
+  int j = 0;
+  for (; j + 8 <= num_windows; j += 8) {
+    // Bits j .. j + 63 of the sequence; the windows starting at
+    // j .. j + 7 use at most the lowest 8 + m - 1 < 32 of them.
+    uint64_t s = LoadWord(seq, size, j >> 3);
+    counts[s & mask]++;
+    counts[(s >> 1) & mask]++;
+    counts[(s >> 2) & mask]++;
+    counts[(s >> 3) & mask]++;
+    counts[(s >> 4) & mask]++;
+    counts[(s >> 5) & mask]++;
+    counts[(s >> 6) & mask]++;
+    counts[(s >> 7) & mask]++;
+  }
+  for (; j < num_windows; j++) {
+    uint64_t w = 0;
+    for (int t = 0; t < m; t++) {
+      w |= static_cast<uint64_t>(BitAt(seq, j + t)) << t;
+    }
+    counts[w]++;
+  }
+}
+
+// Counts the runs of 1s of length m among the first n bits. Uses the
+// shift-and recurrence seq &= seq >> t with doubling step sizes, as in
+// util.OverlappingRunsOfOnes, on one 64-bit word at a time. The second
+// word supplies the up to m - 1 bits that the shifts pull in across the
+// word boundary; the bits it loses at its own top end stay above the low
+// word for m <= 64 and therefore never reach the result.
+int64_t CountRunsOfOnes(const uint8_t* seq, size_t size, int n, int m) {
+  int num_windows = n - m + 1;
+  int64_t count = 0;
+  int num_words = (num_windows + 63) / 64;
+  for (int i = 0; i < num_words; i++) {
+    uint64_t r = LoadWord(seq, size, 8 * static_cast<size_t>(i));
+    uint64_t hi = LoadWord(seq, size, 8 * static_cast<size_t>(i) + 8);
+    int rem = m - 1;
+    int k = 1;
+    while (rem) {
+      int t = std::min(k, rem);
+      r &= (r >> t) | (hi << (64 - t));
+      hi &= hi >> t;
+      rem -= t;
+      k *= 2;
+    }
+    if (i == num_words - 1 && num_windows % 64 != 0) {
+      // Windows starting past n - m must not be counted.
+      r &= (uint64_t{1} << (num_windows % 64)) - 1;
+    }
+    count += __builtin_popcountll(r);
+  }
+  return count;
+}
+
+}  // namespace
+
+std::vector<int64_t> TemplateCounts(const uint8_t* seq, size_t size, int n,
+                                    int m) {
+  if (m < 1 || m > kMaxTemplateBits || m > n ||
+      static_cast<size_t>(n) > 8 * size) {
+    return std::vector<int64_t>();
+  }
+  ScopedKernelTimer timer(&TemplateStats(), (n + 7) / 8);
+  std::vector<int64_t> counts(size_t{1} << m);
+  CountTemplates(seq, size, n, m, counts.data());
+  return counts;
+}
+
+std::vector<int64_t> TemplateCountsBatch(const std::string& buffer,
+                                         int block_bits, int num_blocks,
+                                         int m) {
+  if (m < 1 || m > kMaxTemplateBits || m > block_bits || num_blocks < 0) {
+    return std::vector<int64_t>();
+  }
+  size_t bytes_per_block = (block_bits + 7) / 8;
+  if (buffer.size() < bytes_per_block * num_blocks) {
+    return std::vector<int64_t>();
+  }
+  ScopedKernelTimer timer(&TemplateStats(), bytes_per_block * num_blocks);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.data());
+  size_t table_size = size_t{1} << m;
+  std::vector<int64_t> counts(table_size * num_blocks);
+  for (int i = 0; i < num_blocks; i++) {
+    CountTemplates(data + i * bytes_per_block, bytes_per_block, block_bits, m,
+                   counts.data() + i * table_size);
+  }
+  return counts;
+}
+
+int64_t OverlappingRunsOfOnes(const uint8_t* seq, size_t size, int n, int m) {
+  if (m < 1 || m > 64 || n < 0 || static_cast<size_t>(n) > 8 * size) {
+    return -1;
+  }
+  if (m > n) {
+    return 0;
+  }
+  ScopedKernelTimer timer(&RunsStats(), (n + 7) / 8);
+  return CountRunsOfOnes(seq, size, n, m);
+}
+
+std::vector<int64_t> OverlappingRunsOfOnesBatch(const std::string& buffer,
+                                                int block_bits, int num_blocks,
+                                                int m) {
+  if (m < 1 || m > 64 || block_bits < 0 || num_blocks < 0) {
+    return std::vector<int64_t>();
+  }
+  size_t bytes_per_block = (block_bits + 7) / 8;
+  if (buffer.size() < bytes_per_block * num_blocks) {
+    return std::vector<int64_t>();
+  }
+  ScopedKernelTimer timer(&RunsStats(), bytes_per_block * num_blocks);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.data());
+  std::vector<int64_t> counts(num_blocks);
+  for (int i = 0; i < num_blocks; i++) {
+    if (m > block_bits) {
+      counts[i] = 0;
+    } else {
+      counts[i] = CountRunsOfOnes(data + i * bytes_per_block, bytes_per_block,
+                                  block_bits, m);
+    }
+  }
+  return counts;
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,66 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_TEMPLATE_MATCHING_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_TEMPLATE_MATCHING_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Kernels for the NIST template matching tests. The bit sequences use the
+// little endian byte representation of this directory: bit j of a sequence
+// is (seq[j / 8] >> (j % 8)) & 1.
+
+// Counts the occurrences of every m-bit template in the first n bits of the
+// sequence. Element i of the result is the number of positions j <= n - m
+// where bits j .. j + m - 1 equal template i, with bit j matching the least
+// significant bit of i. This is the convention of util.FrequencyCount with
+// wrap=False, so that all templates are tallied in one pass over the
+// sequence and the cost is independent of the number of templates that are
+// evaluated afterwards. Returns an empty vector if the parameters are
+// inconsistent (m < 1, m > n, m > 24 or n > 8 * size).
+std::vector<int64_t> TemplateCounts(const uint8_t* seq, size_t size, int n,
+                                    int m);
+
+// Counts the templates of num_blocks equally sized blocks stored back to
+// back in buffer. Every block holds block_bits bits, starts at a byte
+// boundary and occupies (block_bits + 7) / 8 bytes, which is the layout
+// produced by bit_util.SplitBlocks. The result concatenates one table of
+// 2^m counts per block. Returns an empty vector if the parameters are
+// inconsistent.
+std::vector<int64_t> TemplateCountsBatch(const std::string& buffer,
+                                         int block_bits, int num_blocks,
+                                         int m);
+
+// Returns the number of possibly overlapping runs of 1s of length m in the
+// first n bits of the sequence, as defined by util.OverlappingRunsOfOnes.
+// The runs are found with the same shift-and recurrence as the native code,
+// but applied to 64-bit words, so 64 window positions are examined per
+// step. Returns 0 if m > n and -1 if the parameters are inconsistent
+// (m < 1, m > 64 or n > 8 * size).
+int64_t OverlappingRunsOfOnes(const uint8_t* seq, size_t size, int n, int m);
+
+// Counts the runs of 1s of length m for num_blocks blocks stored back to
+// back in buffer, in the block layout of TemplateCountsBatch. Returns one
+// count per block, or an empty vector if the parameters are inconsistent.
+std::vector<int64_t> OverlappingRunsOfOnesBatch(const std::string& buffer,
+                                                int block_bits, int num_blocks,
+                                                int m);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_TEMPLATE_MATCHING_H_
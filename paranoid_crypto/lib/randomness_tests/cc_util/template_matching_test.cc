@@ -0,0 +1,155 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/template_matching.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+int BitAt(const std::vector<uint8_t>& seq, int j) {
+  return (seq[j / 8] >> (j % 8)) & 1;
+}
+
+std::vector<uint8_t> PRandBytes(int size) {
+  std::vector<uint8_t> seq(size);
+  for (int j = 0; j < size; j++) {
+    seq[j] = ((j * j * 58901) % 64613) & 255;
+  }
+  return seq;
+}
+
+// Counts the m-bit windows one bit at a time.
+std::vector<int64_t> RefCounts(const std::vector<uint8_t>& seq, int n, int m) {
+  std::vector<int64_t> counts(1 << m);
+  for (int j = 0; j + m <= n; j++) {
+    int w = 0;
+    for (int t = 0; t < m; t++) {
+      w |= BitAt(seq, j + t) << t;
+    }
+    counts[w]++;
+  }
+  return counts;
+}
+
+TEST(TemplateMatching, TemplateCounts) {
+  std::vector<uint8_t> seq = PRandBytes(80);
+  for (int m : {1, 2, 3, 8, 9, 13}) {
+    for (int n : {m, 17, 171, 640}) {
+      EXPECT_EQ(RefCounts(seq, n, m), TemplateCounts(seq.data(), seq.size(),
+                                                     n, m))
+          << m << " " << n;
+    }
+  }
+}
+
+TEST(TemplateMatching, TemplateCountsTv) {
+  // The bit string 10011100101 read from the least significant bit.
+  std::vector<uint8_t> seq = {0b11100101, 0b100};
+  std::vector<int64_t> counts = TemplateCounts(seq.data(), seq.size(), 11, 3);
+  // Windows: 101, 010, 001, 100, 110, 111, 011, 001, 100.
+  std::vector<int64_t> expected = {0, 2, 1, 1, 2, 1, 1, 1};
+  EXPECT_EQ(expected, counts);
+}
+
+TEST(TemplateMatching, TemplateCountsBatch) {
+  std::vector<uint8_t> seq = PRandBytes(60);
+  int m = 4;
+  int block_bits = 37;
+  int num_blocks = 12;
+  size_t bytes_per_block = (block_bits + 7) / 8;
+  std::string buffer(reinterpret_cast<const char*>(seq.data()),
+                     bytes_per_block * num_blocks);
+  std::vector<int64_t> counts =
+      TemplateCountsBatch(buffer, block_bits, num_blocks, m);
+  ASSERT_EQ((size_t{1} << m) * num_blocks, counts.size());
+  for (int i = 0; i < num_blocks; i++) {
+    std::vector<uint8_t> block(seq.begin() + i * bytes_per_block,
+                               seq.begin() + (i + 1) * bytes_per_block);
+    std::vector<int64_t> expected = RefCounts(block, block_bits, m);
+    for (size_t b = 0; b < expected.size(); b++) {
+      EXPECT_EQ(expected[b], counts[i * expected.size() + b]) << i << " " << b;
+    }
+  }
+}
+
+TEST(TemplateMatching, TemplateCountsInvalidParameters) {
+  std::vector<uint8_t> seq = PRandBytes(8);
+  EXPECT_TRUE(TemplateCounts(seq.data(), seq.size(), 64, 0).empty());
+  EXPECT_TRUE(TemplateCounts(seq.data(), seq.size(), 64, 25).empty());
+  EXPECT_TRUE(TemplateCounts(seq.data(), seq.size(), 3, 4).empty());
+  EXPECT_TRUE(TemplateCounts(seq.data(), seq.size(), 65, 4).empty());
+  EXPECT_TRUE(TemplateCountsBatch("\0", 9, 1, 4).empty());
+}
+
+TEST(TemplateMatching, OverlappingRunsOfOnes) {
+  // The test vectors of util_test.testOverlappingRunsOfOnes: the little
+  // endian byte representation of 0b1011011101111011111.
+  std::vector<uint8_t> seq = {0b11011111, 0b10111011, 0b101};
+  int n = 19;
+  int64_t expected[] = {15, 10, 6, 3, 1, 0};
+  for (int m = 1; m <= 6; m++) {
+    EXPECT_EQ(expected[m - 1], OverlappingRunsOfOnes(seq.data(), seq.size(),
+                                                     n, m))
+        << m;
+  }
+}
+
+TEST(TemplateMatching, OverlappingRunsOfOnesCompare) {
+  std::vector<uint8_t> seq = PRandBytes(80);
+  // Insert some long runs of 1s.
+  for (int j = 20; j < 30; j++) seq[j] = 0xff;
+  for (int m : {1, 2, 9, 17, 63, 64}) {
+    for (int n : {m, 171, 640}) {
+      int64_t expected = 0;
+      int run = 0;
+      for (int j = 0; j < n; j++) {
+        run = BitAt(seq, j) ? run + 1 : 0;
+        if (run >= m) expected++;
+      }
+      EXPECT_EQ(expected, OverlappingRunsOfOnes(seq.data(), seq.size(), n, m))
+          << m << " " << n;
+    }
+  }
+  EXPECT_EQ(0, OverlappingRunsOfOnes(seq.data(), seq.size(), 10, 11));
+  EXPECT_EQ(-1, OverlappingRunsOfOnes(seq.data(), seq.size(), 10, 0));
+  EXPECT_EQ(-1, OverlappingRunsOfOnes(seq.data(), seq.size(), 641, 3));
+}
+
+TEST(TemplateMatching, OverlappingRunsOfOnesBatch) {
+  std::vector<uint8_t> seq = PRandBytes(60);
+  int block_bits = 41;
+  int num_blocks = 10;
+  int m = 2;
+  size_t bytes_per_block = (block_bits + 7) / 8;
+  std::string buffer(reinterpret_cast<const char*>(seq.data()),
+                     bytes_per_block * num_blocks);
+  std::vector<int64_t> counts =
+      OverlappingRunsOfOnesBatch(buffer, block_bits, num_blocks, m);
+  ASSERT_EQ(num_blocks, counts.size());
+  for (int i = 0; i < num_blocks; i++) {
+    EXPECT_EQ(OverlappingRunsOfOnes(seq.data() + i * bytes_per_block,
+                                    bytes_per_block, block_bits, m),
+              counts[i])
+        << i;
+  }
+  EXPECT_TRUE(OverlappingRunsOfOnesBatch("\0", 9, 1, 2).empty());
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,109 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/universal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+namespace {
+
+// Cumulative counters of the universal test kernel; see kernel_stats.h.
+KernelStats& Stats() {
+  static KernelStats* stats = new KernelStats("UniversalSum");
+  return *stats;
+}
+
+// The flat last-occurrence table has 2^block_size entries. NIST SP 800-22
+// recommends block sizes of at most 16.
+constexpr int kMaxBlockSize = 24;
+
+// Size of the table with precomputed logarithms. For random data the
+// distance between two occurrences of a symbol follows a geometric
+// distribution with mean 2^block_size, hence almost all distances are
+// covered by the table and the std::log2 fallback is rare.
+constexpr int kLogTableSize = 1 << 17;
+
+// Returns bits bit_offset .. bit_offset + block_size - 1 of seq as an
+// integer, with the earliest bit in the least significant position. The
+// caller guarantees that the bits are within the buffer.
+uint32_t Symbol(const uint8_t* seq, int bit_offset, uint32_t mask) {
+  uint64_t word = 0;
+  // Loads the up to four bytes that contain the symbol.
+  for (int i = 0; i < 4; i++) {
+    word |= static_cast<uint64_t>(seq[(bit_offset >> 3) + i]) << (8 * i);
+  }
+  return (word >> (bit_offset & 7)) & mask;
+}
+
+// Returns the precomputed logarithms, built on the first call.
+const double* Log2Table() {
+  static const std::vector<double>* table = [] {
+    auto* t = new std::vector<double>(kLogTableSize);
+    for (int i = 1; i < kLogTableSize; i++) {
+      (*t)[i] = std::log2(static_cast<double>(i));
+    }
+    return t;
+  }();
+  return table->data();
+}
+
+}  // namespace
+
+double UniversalSum(const uint8_t* seq, size_t size, int n, int block_size,
+                    int q) {
+  if (block_size < 1 || block_size > kMaxBlockSize || q < 0 || n < 0 ||
+      static_cast<size_t>(n) > 8 * size) {
+    return -1.0;
+  }
+  int num_blocks = n / block_size;
+  if (num_blocks < q + 1) {
+    return -1.0;
+  }
+  ScopedKernelTimer timer(&Stats(), (n + 7) / 8);
+  // Symbol reads 4 bytes starting at the symbol's first byte. The check
+  // above only guarantees that the bytes holding the n bits exist, so the
+  // last symbols may have to be extracted from a padded copy.
+  std::vector<uint8_t> padded;
+  const uint8_t* data = seq;
+  size_t needed = (static_cast<size_t>(num_blocks) * block_size + 7) / 8 + 3;
+  if (size < needed) {
+    padded.assign(seq, seq + size);
+    padded.resize(needed);
+    data = padded.data();
+  }
+  const double* log2_table = Log2Table();
+  const uint32_t mask = (uint32_t{1} << block_size) - 1;
+  std::vector<int32_t> tab(size_t{1} << block_size, -1);
+  for (int j = 0; j < q; j++) {
+    tab[Symbol(data, j * block_size, mask)] = j;
+  }
+  double sum = 0.0;
+  for (int j = q; j < num_blocks; j++) {
+    uint32_t b = Symbol(data, j * block_size, mask);
+    int32_t dist = j - tab[b];
+    sum += dist < kLogTableSize ? log2_table[dist]
+                                : std::log2(static_cast<double>(dist));
+    tab[b] = j;
+  }
+  return sum;
+}
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,42 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_UNIVERSAL_H_
+#define PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_UNIVERSAL_H_
+#include <cstddef>
+#include <cstdint>
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+
+// Kernel for Maurer's universal statistical test, described in Section 2.9
+// of NIST SP 800-22. The sequence uses the little endian bit representation
+// of this directory: bit j is (seq[j / 8] >> (j % 8)) & 1.
+//
+// The first n bits are divided into n / block_size symbols of block_size
+// bits each. The first q symbols initialize a table with the last
+// occurrence of each symbol value. For each of the remaining symbols the
+// function accumulates the base 2 logarithm of the distance to the previous
+// occurrence of the same value. Returns this sum; dividing it by the number
+// of accumulated symbols gives the statistic f of nist_suite.UniversalImpl.
+// The last occurrences are kept in a flat table indexed by symbol value and
+// the logarithms of small distances come from a precomputed table, so the
+// cost per symbol is a few table lookups. Returns -1.0 if the parameters
+// are inconsistent (block_size outside 1 .. 24, q < 0, fewer than q + 1
+// symbols or n > 8 * size).
+double UniversalSum(const uint8_t* seq, size_t size, int n, int block_size,
+                    int q);
+
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
+
+#endif  // PARANOID_CRYPTO_LIB_RANDOMNESS_TESTS_CC_UTIL_UNIVERSAL_H_
@@ -0,0 +1,106 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paranoid_crypto/lib/randomness_tests/cc_util/universal.h"
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "testing/base/public/gunit.h"
+
+namespace paranoid_crypto::lib::randomness_tests::cc_util {
+namespace {
+
+int BitAt(const std::vector<uint8_t>& seq, int j) {
+  return (seq[j / 8] >> (j % 8)) & 1;
+}
+
+std::vector<uint8_t> PRandBytes(int size) {
+  std::vector<uint8_t> seq(size);
+  for (int j = 0; j < size; j++) {
+    seq[j] = ((j * j * 56843) % 65167) & 255;
+  }
+  return seq;
+}
+
+// Computes the sum of the log2 distances one bit at a time, with the last
+// occurrences in a map, as in nist_suite.UniversalImpl.
+double RefSum(const std::vector<uint8_t>& seq, int n, int block_size, int q) {
+  int num_blocks = n / block_size;
+  std::map<uint32_t, int> tab;
+  std::vector<uint32_t> symbols(num_blocks);
+  for (int j = 0; j < num_blocks; j++) {
+    for (int t = 0; t < block_size; t++) {
+      symbols[j] |= static_cast<uint32_t>(BitAt(seq, j * block_size + t))
+                    << t;
+    }
+  }
+  for (int j = 0; j < q; j++) {
+    tab[symbols[j]] = j;
+  }
+  double sum = 0.0;
+  for (int j = q; j < num_blocks; j++) {
+    auto it = tab.find(symbols[j]);
+    int last = it == tab.end() ? -1 : it->second;
+    sum += std::log2(static_cast<double>(j - last));
+    tab[symbols[j]] = j;
+  }
+  return sum;
+}
+
+TEST(Universal, CompareWithReference) {
+  std::vector<uint8_t> seq = PRandBytes(2000);
+  for (int block_size : {1, 2, 6, 7, 16}) {
+    for (int q : {0, 10, 10 << block_size}) {
+      int n = 8 * seq.size();
+      if (n / block_size < q + 1) continue;
+      double expected = RefSum(seq, n, block_size, q);
+      double sum = UniversalSum(seq.data(), seq.size(), n, block_size, q);
+      EXPECT_NEAR(expected, sum, 1e-9 * (1 + std::abs(expected)))
+          << block_size << " " << q;
+    }
+  }
+}
+
+TEST(Universal, PartialLastByte) {
+  std::vector<uint8_t> seq = PRandBytes(100);
+  int n = 795;
+  EXPECT_NEAR(RefSum(seq, n, 6, 20),
+              UniversalSum(seq.data(), seq.size(), n, 6, 20), 1e-9);
+}
+
+TEST(Universal, LargeDistances) {
+  // A constant sequence with a single differing symbol produces distances
+  // beyond the precomputed logarithm table.
+  std::vector<uint8_t> seq(200000, 0);
+  seq[0] = 1;
+  int n = 8 * seq.size();
+  EXPECT_NEAR(RefSum(seq, n, 8, 2),
+              UniversalSum(seq.data(), seq.size(), n, 8, 2), 1e-6);
+}
+
+TEST(Universal, InvalidParameters) {
+  std::vector<uint8_t> seq = PRandBytes(100);
+  int n = 8 * seq.size();
+  EXPECT_EQ(-1.0, UniversalSum(seq.data(), seq.size(), n, 0, 10));
+  EXPECT_EQ(-1.0, UniversalSum(seq.data(), seq.size(), n, 25, 10));
+  EXPECT_EQ(-1.0, UniversalSum(seq.data(), seq.size(), n, 6, -1));
+  EXPECT_EQ(-1.0, UniversalSum(seq.data(), seq.size(), n + 1, 6, 10));
+  // Fewer than q + 1 symbols.
+  EXPECT_EQ(-1.0, UniversalSum(seq.data(), seq.size(), 60, 6, 10));
+}
+
+}  // namespace
+}  // namespace paranoid_crypto::lib::randomness_tests::cc_util
@@ -0,0 +1,113 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Accessors for the instrumentation counters of the native kernels.
+
+Each native kernel in cc_util keeps plain atomic counters: the number of
+calls, the cumulative wall time in nanoseconds, the number of input bytes
+processed and the dispatch variant the kernel resolved to (e.g. "clmul"
+for the Berlekamp-Massey kernels). The counters are cheap enough to stay
+enabled in production. Every pybind extension is a separate shared object
+and only exposes the counters of the kernels compiled into it; this module
+merges the per-extension views into one report, so that callers such as
+random_test_suite can log the native kernel throughput of a run.
+"""
+
+from typing import NamedTuple
+from absl import logging
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import berlekamp_massey
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import bias
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import frequency_count
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import matrix_rank
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import random_walk
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import template_matching
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import universal
+
+# The extensions with instrumented kernels.
+_KERNEL_MODULES = [
+    berlekamp_massey,
+    bias,
+    frequency_count,
+    matrix_rank,
+    random_walk,
+    template_matching,
+    universal,
+]
+
+
+class KernelStats(NamedTuple):
+  """The cumulative counters of one native kernel."""
+  # The kernel name, e.g. "LfsrLength".
+  name: str
+  # The dispatch variant the kernel resolved to, e.g. "clmul". Empty for
+  # kernels with a single implementation or kernels that never ran.
+  variant: str
+  # The number of calls.
+  calls: int
+  # The cumulative wall time of the calls in nanoseconds.
+  nanos: int
+  # The cumulative number of input bytes processed.
+  num_bytes: int
+
+
+def GetKernelStats() -> list[KernelStats]:
+  """Returns the counters of all native kernels.
+
+  A kernel registers its counters at its first call, so kernels that never
+  ran may be missing from the result.
+
+  Returns:
+    one KernelStats per kernel.
+  """
+  merged = {}
+  for module in _KERNEL_MODULES:
+    for name, variant, calls, nanos, num_bytes in module.KernelStats():
+      prev = merged.get(name)
+      if prev is None:
+        merged[name] = KernelStats(name, variant, calls, nanos, num_bytes)
+      else:
+        # A kernel compiled into several extensions (e.g. TemplateCounts,
+        # which the frequency_count extension links as well) has one set of
+        # counters per extension. They count distinct calls and are added.
+        merged[name] = KernelStats(name, prev.variant or variant,
+                                   prev.calls + calls, prev.nanos + nanos,
+                                   prev.num_bytes + num_bytes)
+  return list(merged.values())
+
+
+def ResetKernelStats() -> None:
+  """Resets the counters of all native kernels to zero."""
+  for module in _KERNEL_MODULES:
+    module.ResetKernelStats()
+
+
+def LogKernelStats() -> None:
+  """Logs one line per native kernel that ran since the last reset.
+
+  Each line contains the call count, the cumulative wall time and the
+  throughput of the kernel. With concurrent tests the wall times of the
+  kernels overlap, so their sum can exceed the total time of a run.
+  """
+  for stats in GetKernelStats():
+    if not stats.calls:
+      continue
+    name = stats.name
+    if stats.variant:
+      name += f" [{stats.variant}]"
+    seconds = stats.nanos / 1e9
+    if seconds > 0:
+      rate = f"{stats.num_bytes / 1e6 / seconds:8.1f} MB/s"
+    else:
+      rate = " " * 13
+    logging.info("%-30s calls: %-8d time: %6.2fs %s", name, stats.calls,
+                 seconds, rate)
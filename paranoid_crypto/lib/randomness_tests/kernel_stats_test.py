@@ -0,0 +1,62 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests the aggregation of the native kernel instrumentation counters."""
+
+from absl.testing import absltest
+from paranoid_crypto.lib.randomness_tests import kernel_stats
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import berlekamp_massey
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import matrix_rank
+
+
+def GetStats(name: str) -> kernel_stats.KernelStats:
+  for stats in kernel_stats.GetKernelStats():
+    if stats.name == name:
+      return stats
+  raise AssertionError(f"kernel not registered: {name}")
+
+
+class KernelStatsTest(absltest.TestCase):
+
+  def testCountersRecordCalls(self):
+    kernel_stats.ResetKernelStats()
+    buffer = bytes(range(128))
+    matrix_rank.BinaryMatrixRank(buffer, 32, 32)
+    stats = GetStats("BinaryMatrixRank")
+    self.assertEqual(1, stats.calls)
+    self.assertEqual(128, stats.num_bytes)
+    self.assertGreaterEqual(stats.nanos, 0)
+
+  def testVariantResolved(self):
+    berlekamp_massey.LfsrLength(bytes(range(64)), 512)
+    stats = GetStats("LfsrLength")
+    # The dispatch resolves at the first call; which kernel it selects
+    # depends on the build and the CPU running the test.
+    self.assertIn(stats.variant, ["generic", "clmul", "vpclmul"])
+
+  def testResetClearsCounters(self):
+    matrix_rank.BinaryMatrixRank(bytes(range(128)), 32, 32)
+    kernel_stats.ResetKernelStats()
+    stats = GetStats("BinaryMatrixRank")
+    self.assertEqual(0, stats.calls)
+    self.assertEqual(0, stats.nanos)
+    self.assertEqual(0, stats.num_bytes)
+
+  def testLogKernelStats(self):
+    # Smoke test only; the output goes to the log.
+    matrix_rank.BinaryMatrixRank(bytes(range(128)), 32, 32)
+    kernel_stats.LogKernelStats()
+
+
+if __name__ == "__main__":
+  absltest.main()
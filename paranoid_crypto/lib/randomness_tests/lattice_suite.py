@@ -16,6 +16,7 @@
 import math
 from typing import Optional
 from paranoid_crypto.lib import lll
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import bias as cc_bias
 from paranoid_crypto.lib.randomness_tests import util
 
 
@@ -26,6 +27,9 @@ def Bias(sample: list[int], n: int, transforms: list[tuple[int, int]]) -> float:
   distance of s * a + b to the closest multiple of n. For random samples the
   result s expected to be almost uniformly distributed in the range 0 .. n/2.
 
+  The modular arithmetic runs in cc_util.bias, which evaluates all
+  transforms over the whole sample in a single call.
+
   Args:
     sample: a list of values to check
     n: a modulus
@@ -34,12 +38,13 @@ def Bias(sample: list[int], n: int, transforms: list[tuple[int, int]]) -> float:
   Returns:
     a p-value
   """
-  t = 0
-  for s in sample:
-    for a, b in transforms:
-      v = (a * s + b) % n
-      v = min(v, n - v)
-      t += v
+  size = (n.bit_length() + 7) // 8
+  sums = cc_bias.BiasSums(
+      [(s % n).to_bytes(size, "little") for s in sample],
+      n.to_bytes(size, "little"),
+      [((a % n).to_bytes(size, "little"), (b % n).to_bytes(size, "little"))
+       for a, b in transforms])
+  t = sum(int.from_bytes(v, "little") for v in sums)
   normalized = 2 * t / n
   p_value = util.UniformSumCdf(len(sample) * len(transforms), normalized)
   return p_value
@@ -66,12 +66,17 @@ is as follows:
     computed, because of a lack of cycles.
 """
 
-import collections
+import functools
 import math
 from typing import Optional
 import numpy
 from paranoid_crypto.lib.randomness_tests import berlekamp_massey
 from paranoid_crypto.lib.randomness_tests import util
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import frequency_count
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import matrix_rank
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import random_walk
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import template_matching
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import universal
 
 # Type hints:
 NamedPValues = list[tuple[str, float]]
@@ -195,8 +200,15 @@ def BlockFrequency(bits: int, n: int) -> float:
   while n // m >= 100:
     m *= 2
   m = max(20, m)
-  blocks = util.SplitSequence(bits, n, m)
-  return BlockFrequencyImpl(blocks, m)
+  # The 1 bits of each block are counted with word popcounts in C++, so
+  # the sample does not have to be split into Python integers.
+  ba = bits.to_bytes((n + 7) // 8, "little")
+  counts = frequency_count.BitCountBlocks(ba, n, m)
+  if len(counts) != n // m:
+    raise ValueError("Inconsistent parameters")
+  chi_obs = 4 / m * sum((c - m / 2)**2 for c in counts)
+  p_value = util.Igamc(len(counts) / 2, chi_obs / 2)
+  return p_value
 
 
 def Runs(bits: int, n: int) -> float:
@@ -269,6 +281,24 @@ def LongestRuns(bits: int, n: int) -> float:
   return p_value
 
 
+@functools.cache
+def _RankProbabilities(r: int, c: int) -> tuple[float, ...]:
+  """Returns the probabilities that a random binary r*c matrix has rank 0..r.
+
+  The result is cached: the rank tests use the same fixed matrix sizes for
+  every sample, so the quadratic recursion below runs only once per
+  parameter set and process.
+  """
+  res = [0] * (r + 1)
+  res[0] = 1.0
+  for _ in range(c):
+    for j in range(r - 1, -1, -1):
+      prob_dependent = 2**(j - r)
+      res[j + 1] += res[j] * (1 - prob_dependent)
+      res[j] *= prob_dependent
+  return tuple(res)
+
+
 def RankDistribution(r: int,
                      c: int,
                      k: int,
@@ -297,14 +327,8 @@ def RankDistribution(r: int,
           0.28878809, 0.57757619, 0.12835026, 0.00523879, 0.00004657, 0.00000010
       ]
       return precomputed[:k] + [sum(precomputed[k:])]
-  res = [0] * (r + 1)
-  res[0] = 1.0
-  for _ in range(c):
-    for j in range(r - 1, -1, -1):
-      prob_dependent = 2**(j - r)
-      res[j + 1] += res[j] * (1 - prob_dependent)
-      res[j] *= prob_dependent
-  return res[-k:][::-1] + [sum(res[:-k])]
+  res = _RankProbabilities(r, c)
+  return list(res[-k:][::-1]) + [sum(res[:-k])]
 
 
 def BinaryMatrixRankImpl(rows: list[int], r: int, c: int, k: int) -> float:
@@ -329,9 +353,15 @@ def BinaryMatrixRankImpl(rows: list[int], r: int, c: int, k: int) -> float:
   if num_matrices < 1:
     raise InsufficientDataError("Can't create a matrix")
   v = [0] * (k + 1)
-  for i in range(num_matrices):
-    mat = rows[i * r:(i + 1) * r]
-    rank = util.BinaryMatrixRank(mat)
+  # All matrices are passed to the C++ kernel in a single call.
+  bytes_per_row = (c + 7) // 8
+  buffer = b"".join(
+      row.to_bytes(bytes_per_row, "little")
+      for row in rows[:num_matrices * r])
+  ranks = matrix_rank.BinaryMatrixRankBatch(buffer, r, c, num_matrices)
+  if len(ranks) != num_matrices:
+    raise ValueError("Inconsistent parameters")
+  for rank in ranks:
     v[min(k, r - rank)] += 1
   pi = RankDistribution(r, c, k)
   p_value = ChiSquare(v, pi, k)
@@ -393,13 +423,10 @@ def Spectral(bits: int, n: int) -> float:
   #   be to split the input into integers of size 32, 64 etc. instead of
   #   single bits.
   # NOTE(bleichen): The spectral test is currently the slowest test
-  #   in the test suite. Some speedups may be possible: using rfft
-  #   instead of fft. Single precision floating point could be
-  #   sufficient. Truncating bits to a multiple of a power of two
-  #   might allow a faster FFT.
-  bits = list(util.Bits(bits, n))
-  m = util.Dft(bits)
-  m = m[:n // 2]
+  #   in the test suite. Some further speedups may be possible: single
+  #   precision floating point could be sufficient. Truncating bits to a
+  #   multiple of a power of two might allow a faster FFT.
+  m = util.SpectralDft(bits, n)
   # The bound t was proposed in Section 3 of the paper
   # https://eprint.iacr.org/2004/018.pdf.
   t = math.sqrt(math.log(1 / 0.05) * n)
@@ -459,7 +486,14 @@ def NonOverlappingTemplateMatchingImpl(blocks: list[int], n: int, m: int,
 
   # Since the templates are non-overlapping it is possible to count all the
   # subsequences of size m, once and use the result for all the templates.
-  cnts = [util.FrequencyCount(block, n, m, False) for block in blocks]
+  # The C++ kernel counts all the blocks in a single pass.
+  bytes_per_block = (n + 7) // 8
+  buffer = b"".join(block.to_bytes(bytes_per_block, "little")
+                    for block in blocks)
+  counts = template_matching.TemplateCountsBatch(buffer, n, len(blocks), m)
+  if len(counts) != len(blocks) << m:
+    raise ValueError("Inconsistent parameters")
+  cnts = [counts[i << m:(i + 1) << m] for i in range(len(blocks))]
   n0 = n - m + 1
   mean = n0 / 2**m
   variance = n * (1 / 2**m - (2 * m - 1) / 2**(2 * m))
@@ -577,6 +611,21 @@ def OverlappingTemplateMatchingMatrix(m: int, k: int) -> list[list[float]]:
   return mat
 
 
+@functools.cache
+def _OverlappingTemplateMatchingDistribution(n: int, m: int,
+                                             k: int) -> tuple[float, ...]:
+  """Cached implementation of OverlappingTemplateMatchingDistribution.
+
+  The matrix power below is by far the most expensive part of the
+  overlapping template test for short sequences, while the parameters are
+  the same for every sample tested in a process.
+  """
+  mat = OverlappingTemplateMatchingMatrix(m, k)
+  matn = numpy.linalg.matrix_power(mat, n)
+  row_0 = matn[0]
+  return tuple(sum(row_0[i * m:(i + 1) * m]) for i in range(k + 1))
+
+
 def OverlappingTemplateMatchingDistribution(n: int, m: int,
                                             k: int) -> list[float]:
   """The expected probability distribution of an overlapping matching test.
@@ -592,11 +641,7 @@ def OverlappingTemplateMatchingDistribution(n: int, m: int,
     may overlap. The k-th element is the probability that a random bit string
     of size n has k or more runs of 1s of size m.
   """
-  mat = OverlappingTemplateMatchingMatrix(m, k)
-  matn = numpy.linalg.matrix_power(mat, n)
-  row_0 = matn[0]
-  pi = [sum(row_0[i * m:(i + 1) * m]) for i in range(k + 1)]
-  return pi
+  return list(_OverlappingTemplateMatchingDistribution(n, m, k))
 
 
 def OverlappingTemplateMatchingImpl(blocks: list[int], n: int, m: int) -> float:
@@ -618,8 +663,15 @@ def OverlappingTemplateMatchingImpl(blocks: list[int], n: int, m: int) -> float:
 
   k = 5
   v = [0] * (k + 1)
-  for block in blocks:
-    cnt = util.OverlappingRunsOfOnes(block, m)
+  # The runs of all the blocks are counted with a single call into C++.
+  bytes_per_block = (n + 7) // 8
+  buffer = b"".join(block.to_bytes(bytes_per_block, "little")
+                    for block in blocks)
+  counts = template_matching.OverlappingRunsOfOnesBatch(
+      buffer, n, len(blocks), m)
+  if len(counts) != len(blocks):
+    raise ValueError("Inconsistent parameters")
+  for cnt in counts:
     v[min(k, cnt)] += 1
   pi = OverlappingTemplateMatchingDistribution(n, m, k)
   return ChiSquare(v, pi, k)
@@ -654,9 +706,13 @@ def OverlappingTemplateMatching(bits: int,
   return OverlappingTemplateMatchingImpl(blocks, block_size, m)
 
 
+@functools.cache
 def UniversalDistribution(block_size: int, k: int) -> tuple[float, float]:
   """Returns expected value and standard deviation of a universal test.
 
+  The result is cached, since the test parameters are fixed per suite and
+  thus repeat for every sample tested in a process.
+
   Args:
     block_size: the size of the blocks in bits
     k: the number of blocks used in the test
@@ -716,21 +772,15 @@ def UniversalImpl(bits: int, n: int, block_size: int, q: int) -> float:
   Returns:
     a p-value
   """
-  blocks = util.SplitSequence(bits, n, block_size)
-  k = len(blocks) - q
+  k = n // block_size - q
   mean, std = UniversalDistribution(block_size, k)
 
-  # Initialization: after this step tab[b] contains the position
-  # of the last occurrence of b or -1 if b did not occur.
-  tab = [-1] * 2**block_size
-  for i in range(q):
-    tab[blocks[i]] = i
-
-  sumb = 0.0
-  for j in range(q, q + k):
-    b = blocks[j]
-    sumb += math.log(j - tab[b], 2)
-    tab[b] = j
+  # The log2 distances between the occurrences of each symbol are summed up
+  # by the C++ kernel, which keeps the last occurrences in a flat table.
+  ba = bits.to_bytes((n + 7) // 8, "little")
+  sumb = universal.UniversalSum(ba, n, block_size, q)
+  if sumb < 0:
+    raise ValueError("Inconsistent parameters")
   f = sumb / k
   p_value = math.erfc(abs(f - mean) / std / math.sqrt(2))
   return p_value
@@ -839,7 +889,7 @@ def LinearComplexityImpl(blocks: list[int], m: int) -> NamedPValues:
     a list of tuples (description, p-value).
   """
   # pyformat: enable
-  lfsr_length = [berlekamp_massey.LinearComplexity(b, m) for b in blocks]
+  lfsr_length = berlekamp_massey.LinearComplexityBatch(blocks, m)
   median = (m + 1) // 2
   # A random sequence has linear complexity equal to median with probability
   # 1/2. pi contains the following probabilities for the linear complexity of
@@ -1120,38 +1170,25 @@ def RandomWalk(bits: int,
     The random excursions variant test from Section 2.15 results in an other
     2 * max_state_variant values if there are enough cycles for evaluation.
   """
-  s = 0
-  cnts = []
-  cnt = collections.defaultdict(int)
-  max_state2 = max(max_state, max_state_variant)
-  maxs = 0
-  mins = 0
-  for b in util.Bits(bits, n):
-    s += b
-    if s > max_state2:
-      if s > maxs:
-        maxs = s
-    elif s < -max_state2:
-      if s < mins:
-        mins = s
-    elif s != 0:
-      cnt[s] += 1
-    else:
-      cnts.append(cnt)
-      cnt = collections.defaultdict(int)
-  cnts.append(cnt)
-  total_cnt = collections.defaultdict(int)
-  for cnt in cnts:
-    for x, c in cnt.items():
-      total_cnt[x] += c
-  # mins and maxs are only computed over the states outside the range
-  # -max_state2 .. max_state2. In the case that s never reaches these bounds
-  # it is possible to determine these values from total_cnt
-  if maxs == 0:
-    maxs = max(total_cnt)
-  if mins == 0:
-    mins = min(total_cnt)
-  excursions = len(cnts)
+  # The C++ kernel walks the sequence in a single pass and returns the
+  # extreme states, the final sum, the number of cycles, the total visits
+  # of the states -max_state_variant .. max_state_variant and per state a
+  # histogram of the visits per cycle. See cc_util/random_walk.h for the
+  # layout.
+  ba = bits.to_bytes((n + 7) // 8, "little")
+  stats = random_walk.WalkStats(ba, n, max_state, max_cnt, max_state_variant)
+  if len(stats) != 4 + 2 * max_state_variant + 2 * max_state * (max_cnt + 1):
+    raise ValueError("Inconsistent parameters")
+  maxs, mins, s, excursions = stats[:4]
+
+  def total_cnt(x: int) -> int:
+    return stats[4 + (x + max_state_variant if x < 0 else
+                      x + max_state_variant - 1)]
+
+  def cycle_counts(x: int) -> list[int]:
+    i = x + max_state if x < 0 else x + max_state - 1
+    start = 4 + 2 * max_state_variant + i * (max_cnt + 1)
+    return stats[start:start + max_cnt + 1]
 
   p_values = []
   # Cumulative sums test from Section 3.13
@@ -1184,10 +1221,7 @@ def RandomWalk(bits: int,
   if excursions >= 500:
     for x in range(-max_state, max_state + 1):
       if x != 0:
-        v = [0] * (max_cnt + 1)
-        for cnt in cnts:
-          c = min(max_cnt, cnt[x])
-          v[c] += 1
+        v = cycle_counts(x)
         pi = RandomExcursionsDistribution(x, max_cnt)
         obs = sum((v[k] - excursions * pi[k])**2 / (excursions * pi[k])
                   for k in range(max_cnt + 1))
@@ -1198,7 +1232,7 @@ def RandomWalk(bits: int,
   if excursions >= 500:
     for x in range(-max_state_variant, max_state_variant + 1):
       if x != 0:
-        obs = abs(excursions - total_cnt[x]) / math.sqrt(2 * excursions *
+        obs = abs(excursions - total_cnt(x)) / math.sqrt(2 * excursions *
                                                          (4 * abs(x) - 2))
         p_values.append((f"random excursions variant {x}", math.erfc(obs)))
 
@@ -21,11 +21,14 @@ are available for testing.
 
 import collections
 from collections.abc import Callable
+import concurrent.futures
 import enum
 import time
 from typing import Optional, Any, Union
 from absl import logging
 from paranoid_crypto.lib.randomness_tests import extended_nist_suite
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import sequence
+from paranoid_crypto.lib.randomness_tests import kernel_stats
 from paranoid_crypto.lib.randomness_tests import lattice_suite
 from paranoid_crypto.lib.randomness_tests import nist_suite
 from paranoid_crypto.lib.randomness_tests import util
@@ -264,6 +267,33 @@ def LogTotal(tests: list[TestStructure]) -> None:
                    num_total_tests)
 
 
+def _RunRound(tests: list[TestStructure], bits: int, n: int,
+              num_threads: int) -> None:
+  """Runs every test in tests once on the same bit string.
+
+  The native kernels behind the tests release the GIL while they run, so
+  with num_threads > 1 the tests execute concurrently on a thread pool and
+  a round takes roughly the wall-clock time of its slowest test. The test
+  structures only update their own state, hence running them concurrently
+  on shared input is safe.
+
+  Args:
+    tests: the test structures to run.
+    bits: the bit string to test.
+    n: the length of the bit string.
+    num_threads: the number of tests run concurrently. Values <= 1 run the
+      tests sequentially on the calling thread.
+  """
+  if num_threads > 1 and len(tests) > 1:
+    workers = min(num_threads, len(tests))
+    with concurrent.futures.ThreadPoolExecutor(max_workers=workers) as pool:
+      # list() forces the lazy map, so exceptions from the tests propagate.
+      list(pool.map(lambda test_struct: test_struct.Run(bits, n), tests))
+  else:
+    for test_struct in tests:
+      test_struct.Run(bits, n)
+
+
 def TestSource(source: Source,
                n: int,
                significance_level_repeat: float = 0.01,
@@ -271,7 +301,8 @@ def TestSource(source: Source,
                source_name: Optional[str] = None,
                test_prefix: Optional[str] = None,
                log_level: int = 1,
-               min_repetitions: int = 1) -> bool:
+               min_repetitions: int = 1,
+               num_threads: int = 1) -> bool:
   """Tests random bit generator.
 
   Args:
@@ -284,8 +315,11 @@ def TestSource(source: Source,
       None then all suitable tests are run.
     log_level: 0: only prints failing values of tests with multiple p-values
                1: prints a summary for each test
-               2: prints all p-values
+               2: prints all p-values and the native kernel usage
     min_repetitions: minimal number of repetitions
+    num_threads: the number of tests run concurrently. The native kernels
+      release the GIL, so values > 1 use multiple cores. Values <= 1 run
+      the tests sequentially.
 
   Returns:
     True, if any of the tests fail.
@@ -295,6 +329,10 @@ def TestSource(source: Source,
     logging.info("-------- Testing: %s --------", source_name)
   if log_level >= 1:
     logging.info("number of bits: %d", n)
+  if log_level >= 2:
+    # The counters are process wide; resetting them here attributes the
+    # native kernel usage logged below to this run alone.
+    kernel_stats.ResetKernelStats()
   start_total = time.time()
 
   tests = []
@@ -315,17 +353,19 @@ def TestSource(source: Source,
   undecided = len(tests)
   while undecided:
     bits = source(n)
+    pending = [test_struct for test_struct in tests if not test_struct.finished]
+    _RunRound(pending, bits, n, num_threads)
     undecided = 0
-    for test_struct in tests:
+    for test_struct in pending:
       if test_struct.finished:
-        continue
-      if test_struct.Run(bits, n):
         test_struct.LogState(log_level)
       else:
         undecided += 1
   LogTotal(tests)
   if log_level >= 1:
     logging.info("total time: %4.2fs", time.time() - start_total)
+  if log_level >= 2:
+    kernel_stats.LogKernelStats()
   return any(test.Failed() for test in tests)
 
 
@@ -334,7 +374,8 @@ def TestBitString(bits: int,
                   significance_level: float = 1e-9,
                   source_name: Optional[str] = None,
                   test_prefix: Optional[str] = None,
-                  log_level: int = 1) -> bool:
+                  log_level: int = 1,
+                  num_threads: int = 1) -> bool:
   """Runs all tests on a long consecutive output of a random bit generator.
 
   Args:
@@ -346,7 +387,10 @@ def TestBitString(bits: int,
       None then all suitable tests are run.
     log_level: 0: only prints failing values of tests with multiple p-values
                1: prints a summary for each test
-               2: prints all p-values
+               2: prints all p-values and the native kernel usage
+    num_threads: the number of tests run concurrently. The native kernels
+      release the GIL, so values > 1 use multiple cores. Values <= 1 run
+      the tests sequentially.
 
   Returns:
     True, if any of the tests fail.
@@ -355,6 +399,8 @@ def TestBitString(bits: int,
     logging.info("-------- Testing: %s --------", source_name)
   if log_level >= 1:
     logging.info("number of bits: %d", n)
+  if log_level >= 2:
+    kernel_stats.ResetKernelStats()
   start_total = time.time()
 
   tests = []
@@ -363,10 +409,58 @@ def TestBitString(bits: int,
       tests.append(
           TestStructure(test, params, significance_level, significance_level))
 
+  _RunRound(tests, bits, n, num_threads)
   for test_struct in tests:
-    test_struct.Run(bits, n)
     test_struct.LogState(log_level)
   LogTotal(tests)
   if log_level >= 1:
     logging.info("total time: %4.2fs", time.time() - start_total)
+  if log_level >= 2:
+    kernel_stats.LogKernelStats()
   return any(test.Failed() for test in tests)
+
+
+def TestFile(path: str,
+             significance_level: float = 1e-9,
+             test_prefix: Optional[str] = None,
+             log_level: int = 1,
+             num_threads: int = 1) -> bool:
+  """Runs all tests on a capture file of random bytes.
+
+  The file is ingested in chunks by cc_util.sequence, so the peak memory
+  usage of the ingestion is the size of the capture plus one chunk. The
+  tests themselves are statistics over the full sample and hence need the
+  whole capture in memory; it is converted into a bit string once for all
+  tests. The bits of the capture are read in the little endian order used
+  throughout this package: bit j of the sample is bit j % 8 of byte j // 8.
+
+  Args:
+    path: the name of a file containing the raw output of a random bit
+      generator.
+    significance_level: a p-value lower than this value fails the test.
+    test_prefix: only runs tests that start with test_prefix. If this value
+      is None then all suitable tests are run.
+    log_level: 0: only prints failing values of tests with multiple p-values
+               1: prints a summary for each test
+               2: prints all p-values and the native kernel usage
+    num_threads: the number of tests run concurrently.
+
+  Returns:
+    True, if any of the tests fail.
+
+  Raises:
+    IOError: if the file cannot be read.
+  """
+  seq = sequence.Sequence()
+  if not seq.AppendFile(path):
+    raise IOError(f"cannot read {path}")
+  n = 8 * seq.NumBytes()
+  bits = int.from_bytes(memoryview(seq), "little")
+  return TestBitString(
+      bits,
+      n,
+      significance_level=significance_level,
+      source_name=path,
+      test_prefix=test_prefix,
+      log_level=log_level,
+      num_threads=num_threads)
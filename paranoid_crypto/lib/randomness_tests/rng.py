@@ -16,6 +16,11 @@
 Many of the pseudorandom number generators in this module have serious
 weaknesses.
 Hence they should not be used in production.
+
+The classes here define the generators and their seeding; the recurrences
+of the generators that are not already backed by a native library run in
+cc_util.rng, so that the large samples for random_test_suite are not
+generated one output at a time in python.
 """
 
 import hashlib
@@ -25,6 +30,12 @@ import random
 from typing import Optional
 
 from numpy import random as numpy_random
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import rng as cc_rng
+
+
+def _ToBytes(value: int) -> bytes:
+  """Converts a non-negative integer to little endian bytes."""
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
 
 
 class Rng:
@@ -170,29 +181,17 @@ class TruncLcgRand(Rng):
 
   def RandomBits(self, n: int, *, seed: Optional[int] = None) -> int:
     """See base class."""
-    output_size_bits = self.output_size
-    output_size_bytes = (output_size_bits + 7) // 8
-    state_size_bits = output_size_bits * 2
+    state_size_bits = self.output_size * 2
     state_size_bytes = (state_size_bits + 7) // 8
 
-    req_size_bytes = (n + 7) // 8
-    num_outputs = (req_size_bytes + output_size_bytes - 1) // output_size_bytes
-
-    ba = bytearray(num_outputs * output_size_bytes)
-
     if seed is None:
       seed = int.from_bytes(os.urandom(state_size_bytes), "little")
 
-    state = seed
-    for j in range(num_outputs):
-      state = (state * self.a + self.c) % 2**state_size_bits
-      # Truncated LCG - output only the upper half of the state.
-      output = state >> output_size_bits
-      ba[output_size_bytes * j : output_size_bytes * (j + 1)] = output.to_bytes(
-          output_size_bytes, "little"
-      )
-    if len(ba) != req_size_bytes:
-      ba = ba[:req_size_bytes]
+    # The engine has increment 1 hard coded, i.e. self.c.
+    engine = cc_rng.TruncLcg(
+        _ToBytes(self.a), self.output_size, _ToBytes(seed % 2**state_size_bits)
+    )
+    ba = bytearray(engine.Fill((n + 7) // 8))
     if n % 8 != 0:
       ba[0] &= (1 << (n % 8)) - 1
     return int.from_bytes(ba, "little")
@@ -215,14 +214,8 @@ class XorShift128plus(Rng):
     else:
       x = int.from_bytes(os.urandom(8), "little")
       y = int.from_bytes(os.urandom(8), "little")
-    blocks = []
-    for _ in range((n + 63) // 64):
-      x = (x ^ (x << 23)) % 2**64
-      x ^= x >> 17
-      x ^= y ^ (y >> 26)
-      blocks.append((x + y) % 2**64)
-    ba = bytearray().join(z.to_bytes(8, "little") for z in blocks)
-    res = int.from_bytes(ba, "little")
+    engine = cc_rng.XorShift128plus(x % 2**64, y)
+    res = int.from_bytes(engine.Fill(8 * ((n + 63) // 64)), "little")
     if n % 64 != 0:
       res &= (1 << n) - 1
     return res
@@ -246,14 +239,8 @@ class XorShiftStar(Rng):
       x = seed % 2**64
     else:
       x = int.from_bytes(os.urandom(8), "little")
-    blocks = []
-    for _ in range((n + 63) // 64):
-      x ^= x >> 12
-      x = (x ^ (x << 25)) % 2**64
-      x ^= x >> 27
-      blocks.append(x * 0x2545F4914F6CDD1D % 2**64)
-    ba = bytearray().join(z.to_bytes(8, "little") for z in blocks)
-    res = int.from_bytes(ba, "little")
+    engine = cc_rng.XorShiftStar(x)
+    res = int.from_bytes(engine.Fill(8 * ((n + 63) // 64)), "little")
     if n % 64 != 0:
       res &= (1 << n) - 1
     return res
@@ -279,21 +266,8 @@ class Xorwow(Rng):
     else:
       state = int.from_bytes(os.urandom(20), "little")
       ctr = int.from_bytes(os.urandom(4), "little")
-    blocks: list[int] = []
-    for _ in range((n + 31) // 32):
-      s = state % 2**32
-      t, s0 = divmod(state, 2**160)
-      t ^= t >> 2
-      t ^= (t << 1) % 2**32
-      t ^= (s ^ (s << 4)) % 2**32
-      state = t + (s0 << 32)
-      # For some reason pytype thinks that (t + ctr) % 2**32) can be of type
-      # float.
-      out = int((t + ctr) % 2**32)
-      blocks.append(out)
-      ctr = (ctr + 362437) % 2**32
-    ba = bytearray().join(z.to_bytes(4, "little") for z in blocks)
-    res = int.from_bytes(ba, "little")
+    engine = cc_rng.Xorwow(state.to_bytes(20, "little"), ctr)
+    res = int.from_bytes(engine.Fill(4 * ((n + 31) // 32)), "little")
     if n % 32 != 0:
       res &= (1 << n) - 1
     return res
@@ -319,20 +293,11 @@ class JavaRandom(Rng):
   def RandomBits(self, n: int, *, seed: Optional[int] = None) -> int:
     """See base class."""
     a = 0x5DEECE66D
-    c = 0xB
     mask = 0xFFFFFFFFFFFF
     if seed is None:
       seed = int.from_bytes(os.urandom(6), "big")
-    state = (seed ^ a) & mask
-    num_bytes = (n + 7) // 8
-    values = (num_bytes + 3) // 4
-    ba = bytearray(4 * values)
-    for j in range(values):
-      state = (state * a + c) & mask
-      output = state >> 16
-      ba[4 * j : 4 * (j + 1)] = output.to_bytes(4, "little")
-    if len(ba) != num_bytes:
-      ba = ba[:num_bytes]
+    engine = cc_rng.JavaRandom((seed ^ a) & mask)
+    ba = bytearray(engine.Fill((n + 7) // 8))
     if n % 8 != 0:
       ba[0] &= (1 << (n % 8)) - 1
     return int.from_bytes(ba, "big")
@@ -364,13 +329,8 @@ class LcgNist(Rng):
         seed = int.from_bytes(os.urandom(4), "little")
         if 1 < seed < 2**31 - 1:
           break
-    res = bytearray((n + 7) // 8)
-    for i in range(len(res)):
-      b = 0
-      for j in range(8):
-        seed = self.a * seed % ((1 << 31) - 1)
-        b ^= (seed >> 30) << j
-      res[i] = b
+    engine = cc_rng.LcgNist(self.a, seed)
+    res = bytearray(engine.Fill((n + 7) // 8))
     if n % 8:
       res[-1] &= (1 << (n % 8)) - 1
     return int.from_bytes(res, "little")
@@ -403,16 +363,13 @@ class Mwc(Rng):
       )
     else:
       y = seed
-    ba = bytearray()
-    chunk_size = self.output_bits // 8
-    for _ in range((n + self.output_bits - 1) // self.output_bits):
-      # MWC is equivalent to a Lehmer generator. This equivalence is used here,
-      # since it simplifies the implementation and performance is not very
-      # important here.
-      y = self.a * y % self.ab1
-      ba += (y % self.b).to_bytes(chunk_size, "little")
-    res = int.from_bytes(ba, "little")
-    if len(ba) * 8 != n:
+    # The engine uses the equivalent Lehmer generator, like the previous
+    # python implementation of this class.
+    engine = cc_rng.Mwc(_ToBytes(self.a), self.output_bits, _ToBytes(y))
+    num_bytes = ((n + self.output_bits - 1) // self.output_bits *
+                 (self.output_bits // 8))
+    res = int.from_bytes(engine.Fill(num_bytes), "little")
+    if num_bytes * 8 != n:
       res &= (1 << n) - 1
     return res
 
@@ -477,15 +434,12 @@ class Lehmer(Rng):
         )
         if math.gcd(seed, self.mod) == 1:
           break
-    state = seed
-    ba = bytearray()
-    while 8 * len(ba) < n:
-      state = state * self.a % self.mod
-      output = (state << self.bits) // self.mod
-      output_bytes = output.to_bytes(self.bits // 8, "little")
-      ba += bytearray(output_bytes)
-    res = int.from_bytes(ba, "little")
-    if 8 * len(ba) != n:
+    engine = cc_rng.Lehmer(
+        _ToBytes(self.a), _ToBytes(self.mod), self.bits, _ToBytes(seed)
+    )
+    num_bytes = (n + self.bits - 1) // self.bits * (self.bits // 8)
+    res = int.from_bytes(engine.Fill(num_bytes), "little")
+    if 8 * num_bytes != n:
       res &= (1 << n) - 1
     return res
 
@@ -21,6 +21,9 @@ import numpy
 from scipy import fftpack as scipy_fft
 from scipy import special as scipy_special
 from scipy import stats as scipy_stats
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import bit_util
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import frequency_count
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import matrix_rank
 
 
 def BitCount(s: int) -> int:
@@ -197,13 +200,8 @@ def ReverseBits(seq: int, length: int) -> int:
   Returns:
     the integer with the bits in reverse order
   """
-  # Reverses the bits in each byte of the sequence
-  a = seq.to_bytes((length + 7) // 8, "little").translate(_REVERSE_BITS)
-  # Reverses the byte order
-  b = int.from_bytes(a, "big")
-  # Removes extra bits
-  c = b >> (-length % 8)
-  return c
+  ba = seq.to_bytes((length + 7) // 8, "little")
+  return int.from_bytes(bit_util.ReverseBits(ba, length), "little")
 
 
 def Bits(seq: int, length: int) -> array.array:
@@ -220,11 +218,9 @@ def Bits(seq: int, length: int) -> array.array:
   Returns:
     an array containing -1 and 1s.
   """
-  b = bytes(format(seq, "b"), "ascii")
-  tab = bytes.maketrans(b"01", b"\xff\x01")
-  res = array.array("b", [-1]) * (length - len(b))
-  res.frombytes(b.translate(tab))
-  res.reverse()
+  ba = seq.to_bytes((length + 7) // 8, "little")
+  res = array.array("b")
+  res.frombytes(bit_util.BitsToSigns(ba, length))
   return res
 
 
@@ -292,6 +288,18 @@ def FrequencyCount(
   """
   if m > length:
     raise ValueError("m must not be larger than length")
+  if m <= 24:
+    # The subsequences are counted with one pass of the C++ kernel. The
+    # native code below remains as a reference and covers larger m.
+    ba = seq.to_bytes((length + 7) // 8, "little")
+    return frequency_count.FrequencyCount(ba, length, m, wrap)
+  return _FrequencyCountNative(seq, length, m, wrap)
+
+
+def _FrequencyCountNative(
+    seq: int, length: int, m: int, wrap: bool = True
+) -> list[int]:
+  """Native implementation of FrequencyCount."""
   ba = seq.to_bytes((length + 7) // 8, "little")
   if 50 * 2**m < length and m < 24:
     # If 2**m is significantly smaller than length then the following speedup
@@ -371,21 +379,20 @@ def SplitSequence(seq: int, length: int, m: int) -> list[int]:
     a list of blocks
   """
   n = length // m
-  res = [0] * n
-  size = max((seq.bit_length() + 7) // 8, m * n // 8)
+  size = max((seq.bit_length() + 7) // 8, (length + 7) // 8)
   ba = seq.to_bytes(size, "little")
   if m % 8 == 0:
-    # If m is divisible by 8 then it is possible to use byte arrays to speed
-    # up the splitting. Using structs for m=8, 16, 32 or 64 is even faster.
-    for i in range(n):
-      res[i] = int.from_bytes(ba[i * m // 8 : (i + 1) * m // 8], "little")
+    # If m is divisible by 8 then the blocks are byte aligned and can be
+    # sliced out directly.
+    blocks = ba
   else:
-    mask = (1 << m) - 1
-    for i in range(n):
-      val = int.from_bytes(ba[i * m // 8 : (i + 1) * m // 8 + 1], "little")
-      val >>= (i * m) & 7
-      res[i] = val & mask
-  return res
+    # Otherwise the C++ kernel shifts each block onto a byte boundary.
+    blocks = bit_util.SplitBlocks(ba, length, m)
+  bytes_per_block = (m + 7) // 8
+  return [
+      int.from_bytes(blocks[i * bytes_per_block:(i + 1) * bytes_per_block],
+                     "little") for i in range(n)
+  ]
 
 
 def Scatter(seq: int, m: int) -> list[int]:
@@ -399,16 +406,10 @@ def Scatter(seq: int, m: int) -> list[int]:
     a list of bit strings, where the i-th value of the result contains the bits
     i, i+m, i+2*m, ... of the input seq.
   """
-  # Special case to avoid calling int('', 2)
-  if seq.bit_length() < m:
-    return [(seq >> i) & 1 for i in range(m)]
-  bits = format(seq, "b")
-  res = []
-  offset = (len(bits) - 1) % m
-  for i in range(m):
-    start = (offset - i) % m
-    res.append(int(bits[start::m], 2))
-  return res
+  n = seq.bit_length()
+  ba = seq.to_bytes((n + 7) // 8, "little")
+  streams = bit_util.ScatterBits(ba, n, m)
+  return [int.from_bytes(s, "little") for s in streams]
 
 
 def Runs(s: int, length: int) -> int:
@@ -508,22 +509,31 @@ def BinaryMatrixRank(matrix: list[int]) -> int:
 
   The rank of a matrix is the number of linearly independent rows.
 
+  The elimination is done by the C++ kernel in cc_util/matrix_rank.cc,
+  which packs the rows into 64-bit words. _BinaryMatrixRankSmall and
+  _BinaryMatrixRankLarge below are the native implementations that the
+  kernel is compared against in the tests.
+
   Args:
     matrix: the binary matrix represented as a list of rows.
 
   Returns:
     the rank of the matrix
   """
-  # TODO(bleichen): This function performs a Gauss elimination.
-  #   If binary matrices are useful for other purposes then this function
-  #   should be refactored, and maybe put into a class for binary matrices.
   for r in matrix:
     if r < 0:
       raise ValueError("rows cannot be negative")
-  if len(matrix) < 50:
-    return _BinaryMatrixRankSmall(matrix)
-  else:
-    return _BinaryMatrixRankLarge(matrix)
+  if not matrix:
+    return 0
+  cols = max(r.bit_length() for r in matrix)
+  if cols == 0:
+    return 0
+  bytes_per_row = (cols + 7) // 8
+  buffer = b"".join(r.to_bytes(bytes_per_row, "little") for r in matrix)
+  rank = matrix_rank.BinaryMatrixRank(buffer, len(matrix), cols)
+  if rank < 0:
+    raise ValueError("Inconsistent parameters")
+  return rank
 
 
 def _BinaryMatrixRankSmall(matrix: list[int]) -> int:
@@ -643,3 +653,26 @@ def Dft(x: list[float]) -> numpy.ndarray:
     even though the spectral test only uses the first half.
   """
   return numpy.abs(scipy_fft.fft(x))
+
+
+def SpectralDft(seq: int, length: int) -> numpy.ndarray:
+  """Returns the DFT magnitudes used by the Spectral test.
+
+  Equivalent to Dft(list(Bits(seq, length)))[:length // 2], but the
+  balanced representation is expanded by the C++ kernel BitsToSigns and
+  viewed as a numpy array without copying, so no Python object is created
+  per bit. A real-input FFT computes only the half of the spectrum that
+  the Spectral test uses.
+
+  Args:
+    seq: the bit string
+    length: the length of the bit string
+
+  Returns:
+    the magnitudes of the first length // 2 DFT coefficients.
+  """
+  ba = seq.to_bytes((length + 7) // 8, "little")
+  signs = numpy.frombuffer(bit_util.BitsToSigns(ba, length), dtype=numpy.int8)
+  if len(signs) != length:
+    raise ValueError("Inconsistent parameters")
+  return numpy.abs(numpy.fft.rfft(signs))[:length // 2]
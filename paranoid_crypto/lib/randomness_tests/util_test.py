@@ -17,6 +17,7 @@ import os
 from absl.testing import absltest
 from paranoid_crypto.lib.randomness_tests import exp1
 from paranoid_crypto.lib.randomness_tests import util
+from paranoid_crypto.lib.randomness_tests.cc_util.pybind import template_matching
 
 
 class UtilTest(absltest.TestCase):
@@ -196,6 +197,17 @@ class UtilTest(absltest.TestCase):
         count1 = util.FrequencyCount(seq, length, size, wrap=False)
         self.assertEqual(count0, count1)
 
+  def testFrequencyCountNativeCompare(self):
+    # FrequencyCount uses a C++ kernel for m <= 24. Compares it with the
+    # retained native implementation.
+    size = 2000
+    bits = exp1.bits(size)
+    for m in (1, 2, 10):
+      for wrap in (True, False):
+        self.assertEqual(
+            util._FrequencyCountNative(bits, size, m, wrap),
+            util.FrequencyCount(bits, size, m, wrap))
+
   def testFrequencyCountExp1(self):
     size = 1000000
     bits = exp1.bits(size)
@@ -240,6 +252,29 @@ class UtilTest(absltest.TestCase):
     self.assertEqual(1, util.OverlappingRunsOfOnes(0b1011011101111011111, 5))
     self.assertEqual(0, util.OverlappingRunsOfOnes(0b1011011101111011111, 6))
 
+  def testTemplateCountsCompare(self):
+    # Compares the C++ kernel used by the template matching tests with
+    # util.FrequencyCount.
+    size = 10000
+    bits = exp1.bits(size)
+    ba = bits.to_bytes((size + 7) // 8, "little")
+    for length in (size - 3, size):
+      for m in (1, 2, 3, 9, 13):
+        self.assertEqual(
+            util.FrequencyCount(bits % 2**length, length, m, False),
+            template_matching.TemplateCounts(ba, length, m))
+
+  def testOverlappingRunsOfOnesCompare(self):
+    # Compares the C++ kernel used by the template matching tests with
+    # util.OverlappingRunsOfOnes.
+    size = 10000
+    bits = exp1.bits(size)
+    ba = bits.to_bytes((size + 7) // 8, "little")
+    for m in (1, 2, 9, 17, 64):
+      self.assertEqual(
+          util.OverlappingRunsOfOnes(bits, m),
+          template_matching.OverlappingRunsOfOnes(ba, size, m))
+
   def testOverlappingRunsOfOnesExp1(self):
     size = 1000000
     bits = exp1.bits(size)
@@ -300,6 +335,8 @@ class UtilTest(absltest.TestCase):
       rank1 = util._BinaryMatrixRankSmall(m)
       rank2 = util._BinaryMatrixRankLarge(m)
       self.assertEqual(rank1, rank2)
+      # The C++ kernel used by BinaryMatrixRank must agree with both.
+      self.assertEqual(rank1, util.BinaryMatrixRank(m))
 
   def testIgamc(self):
     # Test vectors from NIST SP 800-22
@@ -364,6 +401,15 @@ class UtilTest(absltest.TestCase):
     v = util.Dft(x)
     self.assertSequenceAlmostEqual(expected, v, delta=1e-6)
 
+  def testSpectralDft(self):
+    # SpectralDft computes the same magnitudes as Dft applied to the
+    # balanced representation, restricted to the first half.
+    size = 1000
+    bits = exp1.bits(size)
+    expected = util.Dft(list(util.Bits(bits, size)))[:size // 2]
+    v = util.SpectralDft(bits, size)
+    self.assertSequenceAlmostEqual(expected, v, delta=1e-6)
+
 
 if __name__ == "__main__":
   absltest.main()
@@ -13,6 +13,14 @@
 # limitations under the License.
 """Detects ROCA weak keys (https://en.wikipedia.org/wiki/ROCA_vulnerability)."""
 
+from paranoid_crypto.lib.cc_util.pybind import roca_fingerprint
+
+
+def _ToBytes(value: int) -> bytes:
+  """Encodes a non-negative integer for cc_util.roca_fingerprint."""
+  value = int(value)
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
+
 
 class ROCAKeyDetector(object):
   """Detect weak ROCA keys."""
@@ -52,6 +60,23 @@ class ROCAKeyDetector(object):
         return False
     return True
 
+  def BatchIsWeak(self, moduli: list[int]) -> list[bool]:
+    """Checks a batch of RSA moduli for weakness against ROCA.
+
+    Same as IsWeak, but the whole batch is tested with one call of the
+    cc_util.roca_fingerprint kernel, which keeps precomputed per prime
+    tables and spreads the moduli over the available cores.
+
+    Args:
+      moduli: moduli of RSA keys with an exponent of 0x10001
+
+    Returns:
+      one bool per modulus, True if the key is (with high probability) weak.
+    """
+    masks = roca_fingerprint.RocaFingerprintBatch(
+        [_ToBytes(n) for n in moduli], 0)
+    return [bool(mask & roca_fingerprint.ROCA_FINGERPRINT) for mask in masks]
+
 
 class ROCAKeyVariantDetector(object):
   """Tries to detect keys similar to ROCA but with unknown base."""
@@ -113,3 +138,23 @@ class ROCAKeyVariantDetector(object):
     if self.roca_key_detector.IsWeak(modulus):
       return False
     return True
+
+  def BatchIsWeak(self, moduli: list[int]) -> list[bool]:
+    """Checks a batch of RSA moduli for weakness against ROCA variants.
+
+    Same as IsWeak, but the whole batch is tested with one call of the
+    cc_util.roca_fingerprint kernel. The kernel reports the residue
+    condition and the ROCA fingerprint in one mask, so the exclusion of
+    keys already detected by ROCAKeyDetector needs no second pass.
+
+    Args:
+      moduli: moduli of RSA keys
+
+    Returns:
+      one bool per modulus, True if the key is suspicious.
+    """
+    masks = roca_fingerprint.RocaFingerprintBatch(
+        [_ToBytes(n) for n in moduli], 0)
+    return [
+        mask == roca_fingerprint.ROCA_VARIANT_RESIDUES for mask in masks
+    ]
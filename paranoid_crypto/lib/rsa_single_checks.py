@@ -89,10 +89,11 @@ class CheckROCA(base_check.RSAKeyCheck):
 
   def Check(self, artifacts: list[paranoid_pb2.RSAKey]) -> bool:
     any_weak = False
-    for key in artifacts:
+    moduli = [util.Bytes2Int(key.rsa_info.n) for key in artifacts]
+    weak_keys = self._fc.BatchIsWeak(moduli)
+    for key, weak in zip(artifacts, weak_keys):
       test_result = self._CreateTestResult()
-      n = gmpy.mpz(util.Bytes2Int(key.rsa_info.n))
-      if self._fc.IsWeak(n):
+      if weak:
         logging.warning("ROCA check failed!\n%s", key.rsa_info)
         any_weak = True
         test_result.result = True
@@ -114,10 +115,11 @@ class CheckROCAVariant(base_check.RSAKeyCheck):
 
   def Check(self, artifacts: list[paranoid_pb2.RSAKey]) -> bool:
     any_weak = False
-    for key in artifacts:
+    moduli = [util.Bytes2Int(key.rsa_info.n) for key in artifacts]
+    weak_keys = self._fcv.BatchIsWeak(moduli)
+    for key, weak in zip(artifacts, weak_keys):
       test_result = self._CreateTestResult()
-      n = gmpy.mpz(util.Bytes2Int(key.rsa_info.n))
-      if self._fcv.IsWeak(n):
+      if weak:
         logging.warning("Check for ROCA variant failed!\n%s", key.rsa_info)
         any_weak = True
         test_result.result = True
@@ -434,10 +436,10 @@ class CheckPollardpm1(base_check.RSAKeyCheck):
 
   def Check(self, artifacts: list[paranoid_pb2.RSAKey]) -> bool:
     any_weak = False
-    for key in artifacts:
+    ns = [gmpy.mpz(util.Bytes2Int(key.rsa_info.n)) for key in artifacts]
+    results = rsa_util.Pollardpm1Batch(ns, self._m)
+    for key, (weak, factors) in zip(artifacts, results):
       test_result = self._CreateTestResult()
-      n = gmpy.mpz(util.Bytes2Int(key.rsa_info.n))
-      weak, factors = rsa_util.Pollardpm1(n, self._m)
       if weak:
         if factors:
           logging.warning(
@@ -462,10 +464,10 @@ class CheckLowHammingWeight(base_check.RSAKeyCheck):
 
   def Check(self, artifacts: list[paranoid_pb2.RSAKey]) -> bool:
     any_weak = False
-    for key in artifacts:
+    ns = [gmpy.mpz(util.Bytes2Int(key.rsa_info.n)) for key in artifacts]
+    results = rsa_util.CheckLowHammingWeightBatch(ns)
+    for key, (weak, factors) in zip(artifacts, results):
       test_result = self._CreateTestResult()
-      n = gmpy.mpz(util.Bytes2Int(key.rsa_info.n))
-      weak, factors = rsa_util.CheckLowHammingWeight(n)
       if weak:
         if factors:
           logging.warning(
@@ -13,52 +13,83 @@
 # limitations under the License.
 """Set of math functions that are useful when checking RSA."""
 
-import heapq
 from typing import Optional
 import gmpy2 as gmpy
 from paranoid_crypto.lib import lll
 from paranoid_crypto.lib import ntheory_util
 from paranoid_crypto.lib import special_case_factoring
+from paranoid_crypto.lib.cc_util.pybind import batch_gcd
+from paranoid_crypto.lib.cc_util.pybind import low_hamming_weight
+from paranoid_crypto.lib.cc_util.pybind import pollard_pm1
+from paranoid_crypto.lib.cc_util.pybind import sieve
+
+
+def _ToBytes(value: int) -> bytes:
+  """Encodes a non-negative integer for cc_util.batch_gcd."""
+  value = int(value)
+  return value.to_bytes(max((value.bit_length() + 7) // 8, 1), "little")
 
 
 def BatchGCD(
-    values: list[int], other_values_prod: Optional[int] = None
+    values: list[int],
+    other_values_prod: Optional[int] = None,
+    temp_dir: Optional[str] = None,
 ) -> list[int]:
   """Returns a list with the GCD for each number with all the other values.
 
+  The product and remainder trees are computed by cc_util.batch_gcd, which
+  parallelizes the tree levels over the available cores. The extended
+  product tree trick of ntheory_util.ExtendedProductTree is used there, so
+  the moduli do not have to be squared.
+
   Args:
     values: List of mpz numbers to calculate the pairwise GCDs.
     other_values_prod: Product of additional integers, used in the GCD
       computation. This can be a product of prime factors or keys that have
       already been tested.
+    temp_dir: If set, the levels of the product tree are spilled to files
+      in this directory, so that at most two tree levels are in memory at
+      once. Useful for scans where the whole tree does not fit in RAM. The
+      directory must not be shared by concurrent calls.
 
   Returns:
     a list of GCDs. The i-th element of the result is the GCD of values[i]
     with the product of all values[j] with i!=j and other_values_prod.
   """
   unique_values = list(set(values))
-  prod_tree, t = ntheory_util.ExtendedProductTree(unique_values)
-  if other_values_prod:
-    t *= other_values_prod
-
-  # For efficiency, we want to create a remainder tree to explore the property
-  # GCD(a, foo % a) = GCD(a, foo).
-  # https://proofwiki.org/wiki/GCD_from_Congruence_Modulo_m
-
-  remainders = [t]
-  while prod_tree:
-    unique_values = prod_tree.pop()
-    prev = remainders
-    remainders = [None] * len(unique_values)
-    for i in range(len(unique_values)):
-      if i + 1 == len(unique_values) and i % 2 == 0:
-        remainders[i] = prev[i // 2]
-      else:
-        remainders[i] = prev[i // 2] % unique_values[i]
-  gcds_dict = {v: gmpy.gcd(v, r) for v, r in zip(unique_values, remainders)}
+  other = _ToBytes(other_values_prod) if other_values_prod else b""
+  gcd_bytes = batch_gcd.BatchGcd([_ToBytes(v) for v in unique_values], other,
+                                 0, temp_dir or "")
+  if len(gcd_bytes) != len(unique_values):
+    raise ValueError("Inconsistent parameters")
+  gcds_dict = {
+      v: gmpy.mpz(int.from_bytes(g, "little"))
+      for v, g in zip(unique_values, gcd_bytes)
+  }
   return [gcds_dict[v] for v in values]
 
 
+def BatchTrialDivision(values: list[int], bound: int) -> list[int]:
+  """Trial division of many moduli against all primes below bound.
+
+  The values are tested against chunks of the prime table at once in
+  cc_util.sieve, instead of one Python division per value and prime.
+
+  Args:
+    values: List of mpz numbers to test for small factors.
+    bound: The exclusive upper bound for the primes.
+
+  Returns:
+    a list with the product of the distinct primes below bound dividing
+    each value, so 1 for values without a small factor.
+  """
+  factor_bytes = sieve.SmallPrimeFactorsBatch([_ToBytes(v) for v in values],
+                                              bound, 0)
+  if len(factor_bytes) != len(values):
+    raise ValueError("Inconsistent parameters")
+  return [gmpy.mpz(int.from_bytes(f, "little")) for f in factor_bytes]
+
+
 def FermatFactor(n: int, max_steps: int) -> Optional[tuple[int, int]]:
   """Returns p and q such as n = p*q.
 
@@ -463,16 +494,46 @@ def Pollardpm1(
       smooth enough, the function returns True but an empty list of factors.
       In that case, divisors of m can be tried instead.
   """
-  # Using a = 2^(n-1) instead of a = 2 extends the test to cases where
-  # p = b*m + 1 and q = c*m + 1, and where either b or c is smooth.
-  if gmpy.gcd(n - 1, m) >= gcd_bound:
-    a = pow(2, n - 1, n)
-    p = gmpy.gcd(pow(a, m, n) - 1, n)
+  return Pollardpm1Batch([n], m, gcd_bound=gcd_bound)[0]
+
+
+def Pollardpm1Batch(
+    ns: list[int],
+    m: int,
+    gcd_bound: int = 2**60,
+    num_threads: int = 0,
+) -> list[tuple[bool, list[int]]]:
+  """Runs the Pollard p-1 check on a batch of moduli.
+
+  The exponentiations are done by cc_util.pollard_pm1, which reuses the
+  precomputed exponent m for the whole batch and spreads the moduli over
+  the available cores. Using the base a = 2^(n-1) instead of a = 2 extends
+  the test to cases where p = b*m + 1 and q = c*m + 1, and where either b
+  or c is smooth.
+
+  Args:
+      ns: the RSA moduli to check.
+      m: A pre-calculated guess for K*(p-1).
+      gcd_bound: same filter as in Pollardpm1.
+      num_threads: the number of threads to use. num_threads <= 0 uses the
+        number of cores.
+
+  Returns:
+      A list with a tuple (weak, factors) per modulus, in the order of the
+      input, with the same meaning as the result of Pollardpm1.
+  """
+  gcds = pollard_pm1.Pollardpm1Batch([_ToBytes(n) for n in ns], _ToBytes(m),
+                                     _ToBytes(gcd_bound), num_threads)
+  results = []
+  for n, res in zip(ns, gcds):
+    p = int.from_bytes(res, "little")
     if 1 < p < n:
-      return True, [p, n // p]
-    if p == n:
-      return True, []
-  return False, []
+      results.append((True, [p, n // p]))
+    elif p == n:
+      results.append((True, []))
+    else:
+      results.append((False, []))
+  return results
 
 
 def CheckLowHammingWeight(
@@ -514,108 +575,41 @@ def CheckLowHammingWeight(
            of two factors of very low Hamming weight often has other partial
            factorizations with low Hamming weight.
   """
+  return CheckLowHammingWeightBatch([n], cutoff=cutoff, maxsteps=maxsteps)[0]
+
 
-  def Heuristic(hamming_weight: int, rem_size: int) -> int:
-    """The heuristic used for the search.
-
-    The heuristc (in particular the factor 5) has been determined
-    experimentally. Using a factor 5 in this heuristic allows to factor
-    some 2048 bit products where each of the 1024-bit factors has a Hamming
-    weight 96. The factor 5 has the property that the heuristic of correct
-    guesses are expected to slowly decrease with more bits of the factors
-    guessed, while the heuristic of incorrect guesses are slowly increasing.
-
-    Args:
-      hamming_weight: the Hamming weight of the partial factors p0 and q0
-      rem_size: (n - (p0 << bit) * (q0 << bit)).bit_length()
-
-    Returns:
-      the heuristic. Smaller is better.
-    """
-    return rem_size + 5 * hamming_weight
-
-  # A heap containing partial factorizations.
-  # This heap is being used by the function Push below.
-  # Elements in the heap are quintuples (v, hw, bit, p0, q0) where:
-  #   v: is the result of the function Heuristic above.
-  #   hw: is the sum of the Hamming weights of p0 and q0.
-  #   bit: is the number of missing bits in p0 and q0.
-  #   p0: a guess for the msbs of p, i.e., the value p >> bit.
-  #   q0: a guess for the msbs of q, i.e., the value q >> bit.
-  heap = []
-
-  def Push(p0: int, q0: int, hw: int, bit: int, rem_size: int):
-    """Computes the heuristic and pushes the values into the priority queue.
-
-    Args:
-      p0: a partial factor.
-      q0: a partial factor.
-      hw: the sum of the Hamming weights of p0 and q0
-      bit: the number of bits that are still to guess.
-      rem_size: (n - (p << bit) * (q << bit)).bit_length()
-    """
-    # invariants:
-    # assert (p0 << bit) * (q0 << bit) <= n < ((p0+1) << bit) * ((q0+1) << bit)
-
-    # The algorithm looks for a factorization where p <= q.
-    if p0 <= q0:
-      v = rem_size + 5 * hw
-      heapq.heappush(heap, (v, hw, bit, p0, q0))
-
-  # There are two thresholds for the heurisitic.
-  # If no value of the heuristic smaller than threshold_cutoff is found then
-  # the search is stopped after cutoff steps. This value has been selected
-  # experimentally. A collection of about 28'000 real RSA keys has no value for
-  # minv that is smaller than n.bit_length(). Hence checking a correctly
-  # generated RSA key will very likely stop after cutoff steps.
-  # If a small value or the heuristic is found then search will continue until
-  # a factorization is found or maxsteps steps were made. If at this point
-  # the minimal value for the heuristic is smaller or equal to threshold_weak
-  # (and no factorzation was found) then the RSA key is considered to be
-  # potentially weak. Such keys may need to be analyzed further.
-  threshold_cutoff = n.bit_length()
-  threshold_weak = n.bit_length() - 12
-
-  psize = (n.bit_length() + 1) // 2
-  steps = 0
-  remainder = n - (1 << (2 * (psize - 1)))
-  Push(1, 1, 2, psize - 1, remainder.bit_length())
-  # smallest value for the heuristic
-  minv = Heuristic(2, remainder.bit_length())
-  while steps < maxsteps and heap:
-    steps += 1
-    if steps == cutoff:
-      if minv >= threshold_cutoff:
-        break
-
-    v, hw, bit, p, q = heapq.heappop(heap)
-    if v < minv:
-      minv = v
-    # Doing computations on the msbs only saves 40% CPU time.
-    while bit >= 1:
-      p <<= 1
-      q <<= 1
-      bit -= 1
-      n0 = n >> (2 * bit)
-      for dp, dq in ((0, 1), (1, 0), (1, 1)):
-        # min = pq + p, pq + q, pq + p + q + 1
-        p0 = p + dp
-        q0 = q + dq
-        # The algorithm guesses at this point that the factors of n are
-        # in the range [p0 << bit, (p0 + 1) << bit]
-        # and the range [p1 << bit, (p1 + 1) << bit].
-        rem0 = n0 - p0 * q0
-        if rem0 < 0:
-          break
-        if bit:
-          if rem0 <= p0 + q0:
-            rem_size = rem0.bit_length() + 2 * bit
-            Push(p0, q0, hw + dp + dq, bit, rem_size)
-        else:
-          if rem0 == 0:
-            return True, [p0, q0]
-      else:
-        if rem0 > 0:
-          break
-  potentially_weak = minv <= threshold_weak
-  return potentially_weak, []
+def CheckLowHammingWeightBatch(
+    ns: list[int],
+    cutoff: int = 2500,
+    maxsteps: int = 10**6,
+    num_threads: int = 0,
+) -> list[tuple[bool, list[int]]]:
+  """Runs the low Hamming weight check on a batch of moduli.
+
+  The branch and bound search is done by cc_util.low_hamming_weight, which
+  keeps the heuristic, the heap order and the thresholds of the original
+  python search (including the factor 5 in the heuristic
+  rem_size + 5 * hamming_weight, which has been determined experimentally)
+  but explores the nodes natively and spreads the moduli over the
+  available cores.
+
+  Args:
+      ns: the moduli to test
+      cutoff: same meaning as in CheckLowHammingWeight, applied per
+        modulus.
+      maxsteps: same meaning as in CheckLowHammingWeight, applied per
+        modulus.
+      num_threads: the number of threads to use. num_threads <= 0 uses the
+        number of cores.
+
+  Returns:
+      A list with a tuple (weak, factors) per modulus, in the order of the
+      input, with the same meaning as the result of CheckLowHammingWeight.
+  """
+  results = low_hamming_weight.LowHammingWeightBatch(
+      [_ToBytes(n) for n in ns], cutoff, maxsteps, num_threads
+  )
+  return [
+      (weak, [int.from_bytes(f, "little") for f in factors])
+      for weak, factors in results
+  ]
@@ -100,6 +100,17 @@ class RsaUtilTest(absltest.TestCase):
     self.assertFalse(res)
     self.assertEmpty(factors)
 
+  def testPollardpm1Batch(self):
+    results = rsa_util.Pollardpm1Batch(
+        [23 * 47, 23 * 47, 23 * 47],
+        m=2 * 3 * 5 * 7 * 11,
+        gcd_bound=1,
+    )
+    self.assertLen(results, 3)
+    for res, factors in results:
+      self.assertTrue(res)
+      self.assertEqual(factors[0] * factors[1], 23 * 47)
+
 
 if __name__ == '__main__':
   absltest.main()
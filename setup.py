@@ -29,20 +29,214 @@ with open(os.path.join(_PROJECT_BASE_DIR, 'paranoid_crypto',
 
 _BM_CC_SOURCES = [
     'paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey_clmul.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey_fast.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey_vpclmul.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.cc',
     'paranoid_crypto/lib/randomness_tests/cc_util/pybind/berlekamp_massey.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.cc',
 ]
 
 _BM_CC_HEADERS = [
     'paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h',
 ]
 
+_MR_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/matrix_rank.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/matrix_rank.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.cc',
+]
+
+_MR_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/matrix_rank.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h',
+]
+
+_BU_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/bit_util.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/bit_util.cc',
+]
+
+_BU_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/bit_util.h',
+]
+
+_TM_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/template_matching.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/template_matching.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.cc',
+]
+
+_TM_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/template_matching.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h',
+]
+
+_FC_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/frequency_count.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/template_matching.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/frequency_count.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.cc',
+]
+
+_FC_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/frequency_count.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/template_matching.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h',
+]
+
+_RW_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/random_walk.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/random_walk.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.cc',
+]
+
+_RW_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/random_walk.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h',
+]
+
+_UN_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/universal.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/universal.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.cc',
+]
+
+_UN_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/universal.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h',
+]
+
+_SQ_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/sequence.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/sequence.cc',
+]
+
+_SQ_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/sequence.h',
+]
+
+_RG_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/rng.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/sequence.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/rng.cc',
+]
+
+_RG_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/rng.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/sequence.h',
+]
+
+_BS_CC_SOURCES = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/bias.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/bias.cc',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.cc',
+]
+
+_BS_CC_HEADERS = [
+    'paranoid_crypto/lib/randomness_tests/cc_util/bias.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/kernel_stats.h',
+    'paranoid_crypto/lib/randomness_tests/cc_util/pybind/kernel_stats.h',
+]
+
+_BG_CC_SOURCES = [
+    'paranoid_crypto/lib/cc_util/batch_gcd.cc',
+    'paranoid_crypto/lib/cc_util/parallel.cc',
+    'paranoid_crypto/lib/cc_util/pybind/batch_gcd.cc',
+]
+
+_BG_CC_HEADERS = [
+    'paranoid_crypto/lib/cc_util/batch_gcd.h',
+    'paranoid_crypto/lib/cc_util/parallel.h',
+]
+
+_SV_CC_SOURCES = [
+    'paranoid_crypto/lib/cc_util/sieve.cc',
+    'paranoid_crypto/lib/cc_util/pybind/sieve.cc',
+]
+
+_SV_CC_HEADERS = [
+    'paranoid_crypto/lib/cc_util/sieve.h',
+]
+
+_RF_CC_SOURCES = [
+    'paranoid_crypto/lib/cc_util/roca_fingerprint.cc',
+    'paranoid_crypto/lib/cc_util/parallel.cc',
+    'paranoid_crypto/lib/cc_util/pybind/roca_fingerprint.cc',
+]
+
+_RF_CC_HEADERS = [
+    'paranoid_crypto/lib/cc_util/roca_fingerprint.h',
+    'paranoid_crypto/lib/cc_util/parallel.h',
+]
+
+_EA_CC_SOURCES = [
+    'paranoid_crypto/lib/cc_util/ec_arith.cc',
+    'paranoid_crypto/lib/cc_util/parallel.cc',
+    'paranoid_crypto/lib/cc_util/pybind/ec_arith.cc',
+]
+
+_EA_CC_HEADERS = [
+    'paranoid_crypto/lib/cc_util/ec_arith.h',
+    'paranoid_crypto/lib/cc_util/parallel.h',
+]
+
+_LA_CC_SOURCES = [
+    'paranoid_crypto/lib/cc_util/lattice.cc',
+    'paranoid_crypto/lib/cc_util/parallel.cc',
+    'paranoid_crypto/lib/cc_util/pybind/lattice.cc',
+]
+
+_LA_CC_HEADERS = [
+    'paranoid_crypto/lib/cc_util/lattice.h',
+    'paranoid_crypto/lib/cc_util/parallel.h',
+]
+
+_PM_CC_SOURCES = [
+    'paranoid_crypto/lib/cc_util/pollard_pm1.cc',
+    'paranoid_crypto/lib/cc_util/parallel.cc',
+    'paranoid_crypto/lib/cc_util/pybind/pollard_pm1.cc',
+]
+
+_PM_CC_HEADERS = [
+    'paranoid_crypto/lib/cc_util/pollard_pm1.h',
+    'paranoid_crypto/lib/cc_util/parallel.h',
+]
+
+_HW_CC_SOURCES = [
+    'paranoid_crypto/lib/cc_util/low_hamming_weight.cc',
+    'paranoid_crypto/lib/cc_util/parallel.cc',
+    'paranoid_crypto/lib/cc_util/pybind/low_hamming_weight.cc',
+]
+
+_HW_CC_HEADERS = [
+    'paranoid_crypto/lib/cc_util/low_hamming_weight.h',
+    'paranoid_crypto/lib/cc_util/parallel.h',
+]
 
-def _get_extra_compile_args():
-  """Return extra compiler flags.
 
-  The compiler flags enable the use of CPU instructions to speed up the code.
+def _get_clmul_compile_args():
+  """Return compiler flags for the carry-less multiplication kernel.
+
+  The flags enable the use of CPU instructions to speed up the code.
   In particular, the Berlekamp-Massey algorithm can be sped up significantly
-  by using carryless multiplication.
+  by using carryless multiplication. Only the kernel translation unit is
+  compiled with these flags; the rest of the extension stays generic and
+  selects the kernel at load time, so that the same binary artifact also
+  runs on CPUs without the instructions.
 
   Returns:
     platform dependent compiler flags
@@ -58,13 +252,159 @@ def _get_extra_compile_args():
     return []
 
 
+def _get_vpclmul_compile_args():
+  """Return compiler flags for the vectorized carry-less multiplication kernel.
+
+  VPCLMULQDQ on 512-bit vectors computes four carry-less multiplications per
+  instruction. Like the scalar kernel, only its translation unit is compiled
+  with the flags and the kernel is selected after runtime CPU detection.
+
+  Returns:
+    platform dependent compiler flags
+  """
+  arch = platform.machine()
+  if arch in ('x86_64', 'AMD64'):
+    # Tries to use _mm512_clmulepi64_epi128 to speed up Berlekamp-Massey.
+    return ['-mpclmul', '-mvpclmulqdq', '-mavx512f']
+  else:
+    return []
+
+
+# Maps source files to additional compiler flags. Sources listed here contain
+# kernels that require a specific instruction set. They are guarded so that
+# they are only used after runtime CPU detection.
+_PER_SOURCE_COMPILE_ARGS = {
+    'paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey_clmul.cc':
+        _get_clmul_compile_args(),
+    'paranoid_crypto/lib/randomness_tests/cc_util/berlekamp_massey_vpclmul.cc':
+        _get_vpclmul_compile_args(),
+}
+
+
+class _BuildExt(build_ext):
+  """A build_ext that applies per-source compiler flags.
+
+  distutils only supports extra_compile_args per extension. The kernels in
+  _PER_SOURCE_COMPILE_ARGS must be compiled with their instruction set flags
+  without enabling those instructions for the whole extension.
+  """
+
+  def build_extensions(self):
+    original_compile = self.compiler._compile
+
+    def _compile(obj, src, ext, cc_args, extra_postargs, pp_opts):
+      key = os.path.relpath(src).replace(os.sep, '/')
+      extra = _PER_SOURCE_COMPILE_ARGS.get(key, [])
+      original_compile(obj, src, ext, cc_args, extra_postargs + extra, pp_opts)
+
+    self.compiler._compile = _compile
+    try:
+      super().build_extensions()
+    finally:
+      self.compiler._compile = original_compile
+
+
 _EXT_MODULES = [
     Pybind11Extension(
         'paranoid_crypto.lib.randomness_tests.cc_util.pybind.berlekamp_massey',
         sources=_BM_CC_SOURCES,
         depends=_BM_CC_HEADERS,
+        include_dirs=['./']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.matrix_rank',
+        sources=_MR_CC_SOURCES,
+        depends=_MR_CC_HEADERS,
+        include_dirs=['./']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.bit_util',
+        sources=_BU_CC_SOURCES,
+        depends=_BU_CC_HEADERS,
+        include_dirs=['./']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.template_matching',
+        sources=_TM_CC_SOURCES,
+        depends=_TM_CC_HEADERS,
+        include_dirs=['./']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.universal',
+        sources=_UN_CC_SOURCES,
+        depends=_UN_CC_HEADERS,
+        include_dirs=['./']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.random_walk',
+        sources=_RW_CC_SOURCES,
+        depends=_RW_CC_HEADERS,
+        include_dirs=['./']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.frequency_count',
+        sources=_FC_CC_SOURCES,
+        depends=_FC_CC_HEADERS,
+        include_dirs=['./']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.sequence',
+        sources=_SQ_CC_SOURCES,
+        depends=_SQ_CC_HEADERS,
+        include_dirs=['./']),
+    # The generator engines use GMP for the generators whose state does not
+    # fit a native word.
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.rng',
+        sources=_RG_CC_SOURCES,
+        depends=_RG_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    # The bias kernel works on residues of the size of the tested blocks
+    # and uses GMP.
+    Pybind11Extension(
+        'paranoid_crypto.lib.randomness_tests.cc_util.pybind.bias',
+        sources=_BS_CC_SOURCES,
+        depends=_BS_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    # The batch GCD engine works on bignums and uses GMP, the library
+    # underlying gmpy2, which is already a requirement of this package.
+    Pybind11Extension(
+        'paranoid_crypto.lib.cc_util.pybind.batch_gcd',
+        sources=_BG_CC_SOURCES,
+        depends=_BG_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.cc_util.pybind.sieve',
+        sources=_SV_CC_SOURCES,
+        depends=_SV_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.cc_util.pybind.roca_fingerprint',
+        sources=_RF_CC_SOURCES,
+        depends=_RF_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.cc_util.pybind.ec_arith',
+        sources=_EA_CC_SOURCES,
+        depends=_EA_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.cc_util.pybind.lattice',
+        sources=_LA_CC_SOURCES,
+        depends=_LA_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.cc_util.pybind.pollard_pm1',
+        sources=_PM_CC_SOURCES,
+        depends=_PM_CC_HEADERS,
+        include_dirs=['./'],
+        libraries=['gmpxx', 'gmp']),
+    Pybind11Extension(
+        'paranoid_crypto.lib.cc_util.pybind.low_hamming_weight',
+        sources=_HW_CC_SOURCES,
+        depends=_HW_CC_HEADERS,
         include_dirs=['./'],
-        extra_compile_args=_get_extra_compile_args())
+        libraries=['gmpxx', 'gmp'])
 ]
 
 # Tuple of proto message definitions to build Python bindings for. Paths must
@@ -144,7 +484,7 @@ def main():
       url='https://github.com/google/paranoid_crypto',
       install_requires=_parse_requirements('requirements.txt'),
       long_description=open('README.md').read(),
-      cmdclass={'build_ext': build_ext},
+      cmdclass={'build_ext': _BuildExt},
   )
 
 